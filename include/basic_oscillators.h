@@ -7,31 +7,44 @@
 
 namespace sfdsp
 {
+/// @brief Accuracy of the polynomial sine and cosine block kernels. Each tier is a minimax polynomial over a quarter
+/// period, evaluated `simd::kFloatWidth` samples at a time without table lookups.
+/// @ingroup Oscillators
+enum class SineAccuracy
+{
+    /// @brief Degree 5 polynomial. Error below 1.1e-4, THD+N around -82 dB.
+    Low,
+    /// @brief Degree 7 polynomial. Error below 1.1e-6, THD+N around -123 dB.
+    Medium,
+    /// @brief Degree 9 polynomial. Within 2 ULP of std::sin away from the zero crossings, THD+N below -140 dB.
+    High,
+};
+
 /// @brief Simple sine wave
-/// @param phase Phase of the sine wave
+/// @param phase Phase of the sine wave, 1 is a full period. Any value is accepted.
 /// @return The value of the sine wave at the given phase
 /// @ingroup Oscillators
 float Sine(float phase);
 
 /// @brief Compute a sine wave from a buffer of phases
-/// @param phases The buffer of phases
+/// @param phases The buffer of phases, 1 is a full period. Any value is accepted.
 /// @param out The output buffer, can be the same as `phases`
 /// @param size The size of the output buffer
-/// @return The phase of the sine wave after processing the buffer
-void Sine(const float* phases, float* out, size_t size);
+/// @param accuracy The accuracy tier of the polynomial.
+void Sine(const float* phases, float* out, size_t size, SineAccuracy accuracy = SineAccuracy::Medium);
 
 /// @brief Simple cosine wave
-/// @param phase Phase of the cosine wave
+/// @param phase Phase of the cosine wave, 1 is a full period. Any value is accepted.
 /// @return The value of the cosine wave at the given phase
 /// @ingroup Oscillators
 float Cosine(float phase);
 
 /// @brief Compute a cosine wave from a buffer of phases
-/// @param phases The buffer of phases
+/// @param phases The buffer of phases, 1 is a full period. Any value is accepted.
 /// @param out The output buffer, can be the same as `phases`
 /// @param size The size of the output buffer
-/// @return The phase of the cosine wave after processing the buffer
-void Cosine(const float* phases, float* out, size_t size);
+/// @param accuracy The accuracy tier of the polynomial.
+void Cosine(const float* phases, float* out, size_t size, SineAccuracy accuracy = SineAccuracy::Medium);
 
 /// @brief Non-bandlimited triangle wave
 /// @param phase Phase of the triangle wave
@@ -51,7 +64,31 @@ float Saw(float phase);
 /// @ingroup Oscillators
 float Square(float phase, float duty = 0.5f);
 
+/// @brief Band-limited saw wave, the naive saw with a PolyBLEP correction around the discontinuity
+/// @param phase Phase of the saw wave
+/// @param phase_increment Phase increment per sample, the width of the correction
+/// @return The value of the saw wave at the given phase
+/// @ingroup Oscillators
+float PolyBlepSaw(float phase, float phase_increment);
+
+/// @brief Band-limited square wave, the naive square with a PolyBLEP correction around both discontinuities
+/// @param phase Phase of the square wave
+/// @param phase_increment Phase increment per sample, the width of the correction
+/// @param duty Duty cycle of the square wave
+/// @return The value of the square wave at the given phase
+/// @ingroup Oscillators
+float PolyBlepSquare(float phase, float phase_increment, float duty = 0.5f);
+
+/// @brief Band-limited triangle wave, the naive triangle with a PolyBLAMP correction around both corners
+/// @param phase Phase of the triangle wave
+/// @param phase_increment Phase increment per sample, the width of the correction
+/// @return The value of the triangle wave at the given phase
+/// @ingroup Oscillators
+float PolyBlampTri(float phase, float phase_increment);
+
 /// @brief Simple noise generator
+/// @details All callers share one global state: calls from different threads race, and the sequence cannot be
+/// reseeded. Use a `NoiseGenerator` instance instead.
 /// @return A random value between -1 and 1
 /// @ingroup Oscillators
 float Noise();
@@ -63,6 +100,12 @@ enum class OscillatorType
     Tri,
     Saw,
     Square,
+    /// @brief Saw with PolyBLEP anti-aliasing
+    PolyBlepSaw,
+    /// @brief Square with PolyBLEP anti-aliasing, uses the duty cycle
+    PolyBlepSquare,
+    /// @brief Triangle with PolyBLAMP anti-aliasing
+    PolyBlampTri,
 };
 
 /// @brief Basic oscillator class
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+#include "simd.h"
+
+namespace sfdsp
+{
+/// @brief Bank of N independent biquad filters processed in parallel.
+/// @details Coefficients and states are stored in structure-of-arrays layout so that `simd::kFloatWidth` channels
+/// are filtered per instruction. Each channel implements the same difference equation as `Biquad`, using the
+/// transposed direct form II structure: y(n) = b0*x(n) + b1*x(n-1) + b2*x(n-2) - a1*y(n-1) - a2*y(n-2)
+/// @tparam N The number of channels in the bank.
+template <size_t N>
+class BiquadBank
+{
+    static_assert(N > 0, "BiquadBank needs at least one channel");
+
+  public:
+    /// @brief Number of channels in the bank.
+    static constexpr size_t kChannelCount = N;
+
+    BiquadBank() = default;
+    ~BiquadBank() = default;
+
+    /// @brief Set the coefficients of one channel.
+    /// @param channel The channel index, between 0 and N-1.
+    /// @param b0 the b[0] coefficient
+    /// @param b1 the b[1] coefficient
+    /// @param b2 the b[2] coefficient
+    /// @param a1 the a[1] coefficient
+    /// @param a2 the a[2] coefficient
+    void SetCoefficients(size_t channel, float b0, float b1, float b2, float a1, float a2);
+
+    /// @brief Clear the state of every channel.
+    void Reset();
+
+    /// @brief Filter one frame.
+    /// @param in N input samples, one per channel.
+    /// @param out N output samples, one per channel. Can be the same buffer as `in`.
+    void Tick(const float* in, float* out);
+
+    /// @brief Filter a block of interleaved frames.
+    /// @param in The input buffer, `frames * N` samples where sample `i` of channel `c` is at `in[i * N + c]`.
+    /// @param out The output buffer, same layout as `in`. Can be the same buffer as `in`.
+    /// @param frames The number of frames to process.
+    void ProcessBlock(const float* in, float* out, size_t frames);
+
+  private:
+    /// @brief Number of channels that can be processed with full vectors. The rest are processed one by one.
+    static constexpr size_t kVectorCount = N / simd::kFloatWidth * simd::kFloatWidth;
+
+    std::array<float, N> b0_ = {0.f};
+    std::array<float, N> b1_ = {0.f};
+    std::array<float, N> b2_ = {0.f};
+    std::array<float, N> a1_ = {0.f};
+    std::array<float, N> a2_ = {0.f};
+
+    std::array<float, N> z1_ = {0.f};
+    std::array<float, N> z2_ = {0.f};
+};
+
+template <size_t N>
+void BiquadBank<N>::SetCoefficients(size_t channel, float b0, float b1, float b2, float a1, float a2)
+{
+    assert(channel < N);
+    b0_[channel] = b0;
+    b1_[channel] = b1;
+    b2_[channel] = b2;
+    a1_[channel] = a1;
+    a2_[channel] = a2;
+}
+
+template <size_t N>
+void BiquadBank<N>::Reset()
+{
+    z1_.fill(0.f);
+    z2_.fill(0.f);
+}
+
+template <size_t N>
+void BiquadBank<N>::Tick(const float* in, float* out)
+{
+    ProcessBlock(in, out, 1);
+}
+
+template <size_t N>
+void BiquadBank<N>::ProcessBlock(const float* in, float* out, size_t frames)
+{
+    assert(in != nullptr);
+    assert(out != nullptr);
+
+    // Keep the coefficients and states of a group of channels in registers for the whole block.
+    for (size_t c = 0; c < kVectorCount; c += simd::kFloatWidth)
+    {
+        const simd::float_v b0 = simd::Load(&b0_[c]);
+        const simd::float_v b1 = simd::Load(&b1_[c]);
+        const simd::float_v b2 = simd::Load(&b2_[c]);
+        const simd::float_v a1 = simd::Load(&a1_[c]);
+        const simd::float_v a2 = simd::Load(&a2_[c]);
+        simd::float_v z1 = simd::Load(&z1_[c]);
+        simd::float_v z2 = simd::Load(&z2_[c]);
+
+        for (size_t i = 0; i < frames; ++i)
+        {
+            const simd::float_v x = simd::Load(in + i * N + c);
+            const simd::float_v y = simd::MulAdd(b0, x, z1);
+            z1 = simd::Sub(simd::MulAdd(b1, x, z2), simd::Mul(a1, y));
+            z2 = simd::Sub(simd::Mul(b2, x), simd::Mul(a2, y));
+            simd::Store(out + i * N + c, y);
+        }
+
+        simd::Store(&z1_[c], z1);
+        simd::Store(&z2_[c], z2);
+    }
+
+    for (size_t c = kVectorCount; c < N; ++c)
+    {
+        float z1 = z1_[c];
+        float z2 = z2_[c];
+        for (size_t i = 0; i < frames; ++i)
+        {
+            const float x = in[i * N + c];
+            const float y = b0_[c] * x + z1;
+            z1 = b1_[c] * x + z2 - a1_[c] * y;
+            z2 = b2_[c] * x - a2_[c] * y;
+            out[i * N + c] = y;
+        }
+        z1_[c] = z1;
+        z2_[c] = z2;
+    }
+}
+} // namespace sfdsp
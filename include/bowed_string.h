@@ -3,6 +3,7 @@
 #include "bow_table.h"
 #include "dsp_utils.h"
 #include "filter.h"
+#include "noise.h"
 #include "rms.h"
 #include "smooth_param.h"
 #include "termination.h"
@@ -10,6 +11,7 @@
 #include "waveguide_gate.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <optional>
 
 namespace sfdsp
@@ -28,6 +30,8 @@ struct BowedStringConfig
     float nut_gain;
     /// @brief Optional. The bridge filter. The default bridge filter will be used if not specified.
     std::optional<OnePoleFilter> bridge_filter;
+    /// @brief Seed of the noise added at the bow. Give each voice its own seed for uncorrelated noise.
+    uint32_t noise_seed = NoiseGenerator::kDefaultSeed;
 };
 
 /// @brief Default configuration for the bowed string model. Corresponds to a string tuned to 196 Hz.
@@ -37,6 +41,7 @@ static BowedStringConfig kDefaultStringConfig = {
     .open_string_tuning = 196.f,
     .nut_gain = -0.98f,
     .bridge_filter = std::nullopt,
+    .noise_seed = NoiseGenerator::kDefaultSeed,
 };
 
 /// @brief Implements a bowed string model using a waveguide composed of a right traveling wave and a left traveling
@@ -73,6 +78,17 @@ class BowedString
     /// @return The output sample at the bridge.
     float Tick(float input);
 
+    /// @brief Output level under which the string is considered silent, about -100 dBFS.
+    static constexpr float kSilenceThreshold = 1e-5f;
+
+    /// @brief Returns true if the string has rung out and `Tick()` is short-circuited.
+    /// @details The string goes silent once the bow is off the string and both the output and the input stayed below
+    /// `kSilenceThreshold` for longer than a round trip through the waveguide. The waveguide and the bridge filter
+    /// are then cleared so that no denormal is left circulating. Bowing, plucking or a non-silent input wakes the
+    /// string up.
+    /// @return True if the string is silent.
+    bool IsSilent() const;
+
     /// @brief Modifiable parameters for the bowed string model.
     enum class ParamId
     {
@@ -121,17 +137,20 @@ class BowedString
     float tuning_adjustment_ = 0.f;
     float open_string_delay_ = 0.f;
 
-    Termination nut_;
-    Termination bridge_;
+    Termination<> nut_;
+    Termination<StaticOnePoleFilter> bridge_;
     BowTable bow_table_;
     LinearInterpolation bow_interpolation_strategy_;
 
-    OnePoleFilter reflection_filter_;
+    StaticOnePoleFilter reflection_filter_;
     float samplerate_ = 0.f;
     float freq_ = 0.f;
     bool note_on_ = false;
 
-    OnePoleFilter decay_filter_;
-    OnePoleFilter noise_lp_filter_;
+    bool silent_ = true;
+    size_t quiet_samples_ = 0;
+
+    StaticOnePoleFilter decay_filter_;
+    FilteredNoise<StaticOnePoleFilter> noise_;
 };
 } // namespace sfdsp
\ No newline at end of file
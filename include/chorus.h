@@ -61,7 +61,15 @@ class Chorus
     /// @return The processed audio sample.
     float Tick(float in);
 
+    /// @brief Process a block of samples. The modulation is computed for the whole block with the vectorized sine.
+    /// @param in The input buffer.
+    /// @param out The output buffer, can be the same as `in`.
+    /// @param size The number of samples.
+    void ProcessBlock(const float* in, float* out, size_t size);
+
   private:
+    float ProcessSample(float in, float mod);
+
     uint32_t samplerate_ = 48000;
     float samples_per_ms_ = static_cast<float>(samplerate_) / 1000.f;
 
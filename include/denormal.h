@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define LIBDSP_DENORMAL_X86
+#elif defined(__aarch64__)
+#define LIBDSP_DENORMAL_AARCH64
+#elif defined(__arm__) && defined(__ARM_FP)
+#define LIBDSP_DENORMAL_ARM
+#endif
+
+namespace sfdsp
+{
+
+/// @brief Sets the floating point unit to flush denormals to zero for the lifetime of the object.
+/// @details Decaying feedback loops (one pole filters, biquads, waveguides) slowly drift into the denormal range
+/// once their input goes silent, and every operation on a denormal costs up to a hundred cycles on x86. Create one of
+/// these at the top of the audio callback so that everything processed in that scope runs with flush-to-zero and
+/// denormals-are-zero enabled. The previous state of the control register is restored on destruction. This is a
+/// no-op on platforms where the control register is not known.
+/// @code
+/// void AudioCallback(float* out, size_t size)
+/// {
+///     sfdsp::ScopedFlushDenormals flush_denormals;
+///     ensemble.ProcessBlock(out, size);
+/// }
+/// @endcode
+class ScopedFlushDenormals
+{
+  public:
+    ScopedFlushDenormals()
+    {
+#if defined(LIBDSP_DENORMAL_X86)
+        // Bit 15: flush-to-zero, bit 6: denormals-are-zero.
+        previous_ = _mm_getcsr();
+        _mm_setcsr(static_cast<unsigned int>(previous_) | 0x8040u);
+#elif defined(LIBDSP_DENORMAL_AARCH64)
+        // Bit 24 of FPCR: flush-to-zero.
+        uint64_t fpcr = 0;
+        asm volatile("mrs %0, fpcr" : "=r"(fpcr));
+        previous_ = fpcr;
+        asm volatile("msr fpcr, %0" : : "r"(fpcr | (uint64_t{1} << 24)));
+#elif defined(LIBDSP_DENORMAL_ARM)
+        // Bit 24 of FPSCR: flush-to-zero.
+        uint32_t fpscr = 0;
+        asm volatile("vmrs %0, fpscr" : "=r"(fpscr));
+        previous_ = fpscr;
+        asm volatile("vmsr fpscr, %0" : : "r"(fpscr | (uint32_t{1} << 24)));
+#endif
+    }
+
+    ~ScopedFlushDenormals()
+    {
+#if defined(LIBDSP_DENORMAL_X86)
+        _mm_setcsr(static_cast<unsigned int>(previous_));
+#elif defined(LIBDSP_DENORMAL_AARCH64)
+        asm volatile("msr fpcr, %0" : : "r"(previous_));
+#elif defined(LIBDSP_DENORMAL_ARM)
+        asm volatile("vmsr fpscr, %0" : : "r"(static_cast<uint32_t>(previous_)));
+#endif
+    }
+
+    ScopedFlushDenormals(const ScopedFlushDenormals&) = delete;
+    ScopedFlushDenormals& operator=(const ScopedFlushDenormals&) = delete;
+
+  private:
+    uint64_t previous_ = 0;
+};
+} // namespace sfdsp
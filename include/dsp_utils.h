@@ -42,6 +42,22 @@ inline float fast_mod1(float x)
     return x - std::floor(x);
 }
 
+/// @brief Same result as `fast_mod1` for a phase accumulator, without the `floor` on its dependency chain when the
+/// increment is below one cycle.
+inline float wrap_phase(float x)
+{
+    float y = x;
+    if (y >= 1.f)
+    {
+        y -= 1.f;
+    }
+    else if (y < 0.f)
+    {
+        y += 1.f;
+    }
+    return (y >= 0.f && y < 1.f) ? y : fast_mod1(x);
+}
+
 /// @brief Convert midi note to frequency.
 /// @param midi_note The midi note number. Valid range is 0 to 127.
 /// @return The frequency in Hz.
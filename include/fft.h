@@ -0,0 +1,48 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace sfdsp
+{
+
+/// @brief Real-input radix-2 FFT.
+/// @details The real transform of size N is computed with a complex FFT of size N/2 on the even/odd packed input,
+/// followed by a split step. The complex FFT works on separate real and imaginary arrays so that the butterflies of
+/// every stage wider than a vector are computed with SIMD. Twiddle factors are computed once in the constructor, so
+/// `Forward` and `Inverse` do not allocate and can be called from the audio thread.
+class FFT
+{
+  public:
+    /// @brief Create a transform of the given size.
+    /// @param size The transform size. Must be a power of two, at least 4.
+    explicit FFT(size_t size);
+    ~FFT() = default;
+
+    /// @brief Returns the transform size.
+    size_t GetSize() const;
+
+    /// @brief Forward transform.
+    /// @param in The real input buffer of `size` samples.
+    /// @param out The output spectrum of `size / 2 + 1` bins, from DC to Nyquist.
+    void Forward(const float* in, std::complex<float>* out);
+
+    /// @brief Inverse transform, including the 1/size normalization.
+    /// @param in The input spectrum of `size / 2 + 1` bins, from DC to Nyquist.
+    /// @param out The real output buffer of `size` samples.
+    void Inverse(const std::complex<float>* in, float* out);
+
+  private:
+    void Transform();
+
+    size_t size_ = 0;
+    /// @brief Twiddles of every stage, the stage with butterflies of half length h starts at index h - 1.
+    std::vector<float> twiddles_re_;
+    std::vector<float> twiddles_im_;
+    std::vector<std::complex<float>> split_twiddles_;
+    std::vector<size_t> bit_reverse_;
+    std::vector<float> work_re_;
+    std::vector<float> work_im_;
+};
+} // namespace sfdsp
@@ -4,34 +4,58 @@
 
 #include <array>
 #include <cassert>
+#include <concepts>
 #include <cstddef>
 #include <cstdint>
 
 namespace sfdsp
 {
-/// @brief Base class for filters
+/// @brief Normalized coefficients of a second order section (a0 = 1).
+struct BiquadCoefficients
+{
+    float b0 = 1.f;
+    float b1 = 0.f;
+    float b2 = 0.f;
+    float a1 = 0.f;
+    float a2 = 0.f;
+};
+
+/// @brief Filter responses available from `DesignBiquad`.
+enum class BiquadType
+{
+    Lowpass,
+    Highpass,
+    /// @brief Bandpass with a constant 0 dB peak gain.
+    Bandpass,
+    Notch,
+    Allpass,
+    Peak,
+    LowShelf,
+    HighShelf,
+};
+
+/// @brief Compute biquad coefficients using the formulas from Robert Bristow-Johnson's Audio EQ Cookbook.
+/// https://www.w3.org/TR/audio-eq-cookbook/
+/// @param type The filter response.
+/// @param cutoff The cutoff (or center) frequency, normalized between 0 and 0.5 (f / samplerate).
+/// @param q The quality factor. For the shelving filters, a Q of 1/sqrt(2) gives the steepest slope without overshoot.
+/// @param gain_db Gain in decibels. Only used by the peak and shelving filters.
+/// @return The normalized coefficients.
+BiquadCoefficients DesignBiquad(BiquadType type, float cutoff, float q, float gain_db = 0.f);
+
+/// @brief Coefficients and state of the elementary filter sections.
 /// @details Differential equations where taken from here:
 /// https://ccrma.stanford.edu/~jos/filters/Elementary_Filter_Sections.html Implementation for a lot of these functions
 /// were also taken from the STK (Synthesis ToolKit) library: https://github.com/thestk/stk
-class Filter
+///
+/// The `Static*` filters derived from this class define `Tick` in the header and are not virtual, so that they can be
+/// inlined in the caller. Each also provides its own `ProcessBlock` loop that keeps the filter state in registers for
+/// the duration of the block. Use the `Filter` classes when the filter type is only known at runtime.
+class StaticFilter
 {
     static constexpr size_t COEFFICIENT_COUNT = 3;
 
   public:
-    Filter() = default;
-    virtual ~Filter() = default;
-
-    /// @brief  Tick the filter.
-    /// @param in Input sample
-    /// @return Output sample
-    virtual float Tick(float in) = 0;
-
-    /// @brief Filter a block of samples. 'in' and 'out' can be the same buffer.
-    /// @param in The input buffer.
-    /// @param out The output buffer.
-    /// @param size The size of the buffer.
-    void ProcessBlock(float* in, float* out, size_t size);
-
     /// @brief Set the gain of the filter.
     /// @param gain
     void SetGain(float gain);
@@ -44,6 +68,9 @@ class Filter
     /// @param b Array of size COEFFICIENT_COUNT containing the 'b' coefficients.
     void SetB(const float (&b)[COEFFICIENT_COUNT]);
 
+    /// @brief Clear the filter state.
+    void Reset();
+
   protected:
     /// @brief The gain applied to the input of the filter.
     float gain_ = 1.f;
@@ -61,12 +88,9 @@ class Filter
 };
 
 /// @brief Implements a simple one pole filter with differential equation y(n) = b0*x(n) - a1*y(n-1)
-class OnePoleFilter : public Filter
+class StaticOnePoleFilter : public StaticFilter
 {
   public:
-    OnePoleFilter() = default;
-    ~OnePoleFilter() override = default;
-
     /// @brief Set the pole of the filter.
     /// @param pole The pole of the filter.
     void SetPole(float pole);
@@ -84,56 +108,56 @@ class OnePoleFilter : public Filter
     /// @brief Input a sample in the filter and return the next output
     /// @param in The input sample
     /// @return The next output sample
-    float Tick(float in) override;
+    float Tick(float in);
+
+    /// @brief Filter a block of samples. 'in' and 'out' can be the same buffer.
+    void ProcessBlock(const float* in, float* out, size_t size);
 };
 
 /// @brief Implements a simple one zero filter with differential equation y(n) = b0*x(n) + b1*x(n-1)
-class OneZeroFilter : public Filter
+class StaticOneZeroFilter : public StaticFilter
 {
   public:
-    OneZeroFilter() = default;
-    ~OneZeroFilter() override = default;
-
     /// @brief Input a sample in the filter and return the next output
     /// @param in The input sample
     /// @return The next output sample
-    float Tick(float in) override;
+    float Tick(float in);
+
+    /// @brief Filter a block of samples. 'in' and 'out' can be the same buffer.
+    void ProcessBlock(const float* in, float* out, size_t size);
 };
 
 /// @brief Implements a simple two pole filter with differential equation y(n) = b0*x(n) - a1*y(n-1) - a2*y(n-2)
-class TwoPoleFilter : public Filter
+class StaticTwoPoleFilter : public StaticFilter
 {
   public:
-    TwoPoleFilter() = default;
-    ~TwoPoleFilter() override = default;
-
     /// @brief Input a sample in the filter and return the next output
     /// @param in The input sample
     /// @return The next output sample
-    float Tick(float in) override;
+    float Tick(float in);
+
+    /// @brief Filter a block of samples. 'in' and 'out' can be the same buffer.
+    void ProcessBlock(const float* in, float* out, size_t size);
 };
 
 /// @brief Implements a simple two zero filter with differential equation \f$ y(n) = b0*x(n) + b1*x(n-1) + b2*x(n-2) \f$
-class TwoZeroFilter : public Filter
+class StaticTwoZeroFilter : public StaticFilter
 {
   public:
-    TwoZeroFilter() = default;
-    ~TwoZeroFilter() override = default;
-
     /// @brief Input a sample in the filter and return the next output
     /// @param in The input sample
     /// @return The next output sample
-    float Tick(float in) override;
+    float Tick(float in);
+
+    /// @brief Filter a block of samples. 'in' and 'out' can be the same buffer.
+    void ProcessBlock(const float* in, float* out, size_t size);
 };
 
 /// @brief Implements a simple biquad filter with differential equation
 /// y(n) = b0*x(n) + b1*x(n-1) + b2*x(n-2) - a1*y(n-1) - a2*y(n-2)
-class Biquad : public Filter
+class StaticBiquad : public StaticFilter
 {
   public:
-    Biquad() = default;
-    ~Biquad() override = default;
-
     /// @brief Set the biquad coefficients.
     /// @param b0 the b[0] coefficient
     /// @param b1 the b[1] coefficient
@@ -142,9 +166,337 @@ class Biquad : public Filter
     /// @param a2 the a[2] coefficient
     void SetCoefficients(float b0, float b1, float b2, float a1, float a2);
 
+    /// @brief Set the biquad coefficients.
+    /// @param coeffs The coefficients, typically obtained from `DesignBiquad`.
+    void SetCoefficients(const BiquadCoefficients& coeffs);
+
     /// @brief Input a sample in the filter and return the next output
     /// @param in The input sample
     /// @return The next output sample
-    float Tick(float in) override;
+    float Tick(float in);
+
+    /// @brief Filter a block of samples. 'in' and 'out' can be the same buffer.
+    void ProcessBlock(const float* in, float* out, size_t size);
+};
+
+/// @brief Base class for filters
+/// @details Interface to the elementary filter sections when the filter type is chosen at runtime, for example in
+/// `Termination<>`. The concrete classes run the difference equations of their `Static*` counterpart.
+class Filter
+{
+    static constexpr size_t COEFFICIENT_COUNT = 3;
+
+  public:
+    Filter() = default;
+    virtual ~Filter() = default;
+
+    /// @brief  Tick the filter.
+    /// @param in Input sample
+    /// @return Output sample
+    virtual float Tick(float in) = 0;
+
+    /// @brief Filter a block of samples. 'in' and 'out' can be the same buffer.
+    /// @param in The input buffer.
+    /// @param out The output buffer.
+    /// @param size The size of the buffer.
+    virtual void ProcessBlock(const float* in, float* out, size_t size) = 0;
+
+    /// @brief Set the gain of the filter.
+    /// @param gain
+    virtual void SetGain(float gain) = 0;
+
+    /// @brief Set the 'a' coefficients of the filter.
+    /// @param a Array of size COEFFICIENT_COUNT containing the 'a' coefficients.
+    virtual void SetA(const float (&a)[COEFFICIENT_COUNT]) = 0;
+
+    /// @brief Set the 'b' coefficients of the filter.
+    /// @param b Array of size COEFFICIENT_COUNT containing the 'b' coefficients.
+    virtual void SetB(const float (&b)[COEFFICIENT_COUNT]) = 0;
+
+    /// @brief Clear the filter state.
+    virtual void Reset() = 0;
 };
+
+/// @brief Implements the `Filter` interface with one of the `Static*` filters.
+/// @details The static filter is a public base, so its own setters such as `SetPole` are available and a virtual
+/// filter can be assigned to a variable of the static type.
+/// @tparam StaticFilterT The static filter.
+template <class StaticFilterT>
+class VirtualFilter : public Filter, public StaticFilterT
+{
+  public:
+    VirtualFilter() = default;
+    ~VirtualFilter() override = default;
+
+    float Tick(float in) override
+    {
+        return StaticFilterT::Tick(in);
+    }
+
+    void ProcessBlock(const float* in, float* out, size_t size) override
+    {
+        StaticFilterT::ProcessBlock(in, out, size);
+    }
+
+    void SetGain(float gain) override
+    {
+        StaticFilterT::SetGain(gain);
+    }
+
+    void SetA(const float (&a)[3]) override
+    {
+        StaticFilterT::SetA(a);
+    }
+
+    void SetB(const float (&b)[3]) override
+    {
+        StaticFilterT::SetB(b);
+    }
+
+    void Reset() override
+    {
+        StaticFilterT::Reset();
+    }
+};
+
+/// @brief Virtual version of `StaticOnePoleFilter`.
+class OnePoleFilter : public VirtualFilter<StaticOnePoleFilter>
+{
+};
+
+/// @brief Virtual version of `StaticOneZeroFilter`.
+class OneZeroFilter : public VirtualFilter<StaticOneZeroFilter>
+{
+};
+
+/// @brief Virtual version of `StaticTwoPoleFilter`.
+class TwoPoleFilter : public VirtualFilter<StaticTwoPoleFilter>
+{
+};
+
+/// @brief Virtual version of `StaticTwoZeroFilter`.
+class TwoZeroFilter : public VirtualFilter<StaticTwoZeroFilter>
+{
+};
+
+/// @brief Virtual version of `StaticBiquad`.
+class Biquad : public VirtualFilter<StaticBiquad>
+{
+};
+
+/// @brief Requirements for a type that can be used as a filter by templated processors such as `Termination`.
+template <typename T>
+concept FilterType = requires(T& filter, float in) {
+    {
+        filter.Tick(in)
+    } -> std::convertible_to<float>;
+};
+
+/// @brief Biquad filter with coefficients ramped per sample, for smooth block rate modulation.
+/// @details Instead of switching coefficients instantly, `SetTarget` schedules new coefficients that are linearly
+/// interpolated over the next call to `ProcessBlock`, so a cutoff sweep only needs one call to `DesignBiquad` per
+/// block. The stability region of (a1, a2) is a triangle, which is convex, so no set of coefficients along the ramp
+/// between two stable filters is unstable on its own. That does not make the time-varying filter stable: a direct form
+/// biquad whose coefficients move quickly can still grow. The direct form I structure is used as it is the best
+/// behaved of the direct forms under coefficient changes, but for fast or audio rate sweeps use
+/// `StateVariableFilter`, which stays stable under modulation.
+class InterpolatedBiquad
+{
+  public:
+    InterpolatedBiquad() = default;
+    ~InterpolatedBiquad() = default;
+
+    /// @brief Set the coefficients immediately, cancelling any pending interpolation.
+    /// @param coeffs The new coefficients.
+    void SetCoefficients(const BiquadCoefficients& coeffs);
+
+    /// @brief Set the coefficients to reach at the end of the next block.
+    /// @param coeffs The target coefficients.
+    void SetTarget(const BiquadCoefficients& coeffs);
+
+    /// @brief Returns the coefficients currently in use.
+    /// @return The current coefficients.
+    BiquadCoefficients GetCoefficients() const;
+
+    /// @brief Clear the filter state.
+    void Reset();
+
+    /// @brief Input a sample in the filter and return the next output. Uses the current coefficients.
+    /// @param in The input sample
+    /// @return The next output sample
+    float Tick(float in);
+
+    /// @brief Filter a block of samples while interpolating toward the target coefficients. The target is reached
+    /// on the last sample of the block. 'in' and 'out' can be the same buffer.
+    /// @param in The input buffer.
+    /// @param out The output buffer.
+    /// @param size The size of the buffer.
+    void ProcessBlock(const float* in, float* out, size_t size);
+
+  private:
+    BiquadCoefficients current_;
+    BiquadCoefficients target_;
+    bool ramping_ = false;
+
+    float x1_ = 0.f;
+    float x2_ = 0.f;
+    float y1_ = 0.f;
+    float y2_ = 0.f;
+};
+
+inline float StaticOnePoleFilter::Tick(float in)
+{
+    outputs_[0] = gain_ * in * b_[0] - outputs_[1] * a_[1];
+    outputs_[1] = outputs_[0];
+    return outputs_[0];
+}
+
+inline void StaticOnePoleFilter::ProcessBlock(const float* in, float* out, size_t size)
+{
+    assert(in != nullptr);
+    assert(out != nullptr);
+
+    const float gain = gain_;
+    const float b0 = b_[0];
+    const float a1 = a_[1];
+    float y1 = outputs_[1];
+    for (size_t i = 0; i < size; ++i)
+    {
+        y1 = gain * in[i] * b0 - y1 * a1;
+        out[i] = y1;
+    }
+    outputs_[0] = y1;
+    outputs_[1] = y1;
+}
+
+inline float StaticOneZeroFilter::Tick(float in)
+{
+    float out = gain_ * in * b_[0] + inputs_[0] * b_[1];
+    inputs_[0] = in;
+    return out;
+}
+
+inline void StaticOneZeroFilter::ProcessBlock(const float* in, float* out, size_t size)
+{
+    assert(in != nullptr);
+    assert(out != nullptr);
+
+    const float gain = gain_;
+    const float b0 = b_[0];
+    const float b1 = b_[1];
+    float x1 = inputs_[0];
+    for (size_t i = 0; i < size; ++i)
+    {
+        const float x = in[i];
+        out[i] = gain * x * b0 + x1 * b1;
+        x1 = x;
+    }
+    inputs_[0] = x1;
+}
+
+inline float StaticTwoPoleFilter::Tick(float in)
+{
+    outputs_[0] = gain_ * in * b_[0] - outputs_[1] * a_[1] - outputs_[2] * a_[2];
+    outputs_[2] = outputs_[1];
+    outputs_[1] = outputs_[0];
+    return outputs_[0];
+}
+
+inline void StaticTwoPoleFilter::ProcessBlock(const float* in, float* out, size_t size)
+{
+    assert(in != nullptr);
+    assert(out != nullptr);
+
+    const float gain = gain_;
+    const float b0 = b_[0];
+    const float a1 = a_[1];
+    const float a2 = a_[2];
+    float y1 = outputs_[1];
+    float y2 = outputs_[2];
+    for (size_t i = 0; i < size; ++i)
+    {
+        const float y = gain * in[i] * b0 - y1 * a1 - y2 * a2;
+        y2 = y1;
+        y1 = y;
+        out[i] = y;
+    }
+    outputs_[0] = y1;
+    outputs_[1] = y1;
+    outputs_[2] = y2;
+}
+
+inline float StaticTwoZeroFilter::Tick(float in)
+{
+    float out = gain_ * in * b_[0] + inputs_[0] * b_[1] + inputs_[1] * b_[2];
+    inputs_[1] = inputs_[0];
+    inputs_[0] = in;
+    return out;
+}
+
+inline void StaticTwoZeroFilter::ProcessBlock(const float* in, float* out, size_t size)
+{
+    assert(in != nullptr);
+    assert(out != nullptr);
+
+    const float gain = gain_;
+    const float b0 = b_[0];
+    const float b1 = b_[1];
+    const float b2 = b_[2];
+    float x1 = inputs_[0];
+    float x2 = inputs_[1];
+    for (size_t i = 0; i < size; ++i)
+    {
+        const float x = in[i];
+        out[i] = gain * x * b0 + x1 * b1 + x2 * b2;
+        x2 = x1;
+        x1 = x;
+    }
+    inputs_[0] = x1;
+    inputs_[1] = x2;
+}
+
+inline float StaticBiquad::Tick(float in)
+{
+    inputs_[0] = gain_ * in;
+    outputs_[0] = inputs_[0] * b_[0] + inputs_[1] * b_[1] + inputs_[2] * b_[2];
+    outputs_[0] -= outputs_[1] * a_[1] + outputs_[2] * a_[2];
+    inputs_[2] = inputs_[1];
+    inputs_[1] = inputs_[0];
+    outputs_[2] = outputs_[1];
+    outputs_[1] = outputs_[0];
+    return outputs_[0];
+}
+
+inline void StaticBiquad::ProcessBlock(const float* in, float* out, size_t size)
+{
+    assert(in != nullptr);
+    assert(out != nullptr);
+
+    const float gain = gain_;
+    const float b0 = b_[0];
+    const float b1 = b_[1];
+    const float b2 = b_[2];
+    const float a1 = a_[1];
+    const float a2 = a_[2];
+    float x1 = inputs_[1];
+    float x2 = inputs_[2];
+    float y1 = outputs_[1];
+    float y2 = outputs_[2];
+    for (size_t i = 0; i < size; ++i)
+    {
+        const float x = gain * in[i];
+        const float y = x * b0 + x1 * b1 + x2 * b2 - (y1 * a1 + y2 * a2);
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+        out[i] = y;
+    }
+    inputs_[0] = x1;
+    inputs_[1] = x1;
+    inputs_[2] = x2;
+    outputs_[0] = y1;
+    outputs_[1] = y1;
+    outputs_[2] = y2;
+}
 } // namespace sfdsp
\ No newline at end of file
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "fft.h"
+
+namespace sfdsp
+{
+
+/// @brief Window used by `DesignLowpassFir`.
+enum class WindowType
+{
+    Rectangular,
+    Hann,
+    Blackman,
+    Kaiser,
+};
+
+/// @brief Design a linear phase lowpass FIR filter with the windowed sinc method.
+/// @param taps The output buffer, `count` taps.
+/// @param count The number of taps.
+/// @param cutoff The normalized cutoff frequency (f / samplerate), between 0 and 0.5.
+/// @param window The window applied to the sinc.
+/// @param gain The passband gain. Use the interpolation factor when designing the filter of a `FirInterpolator`.
+/// @param kaiser_beta The shape parameter of the Kaiser window. Ignored for other windows.
+void DesignLowpassFir(float* taps, size_t count, float cutoff, WindowType window = WindowType::Blackman,
+                      float gain = 1.f, float kaiser_beta = 8.f);
+
+/// @brief Linear buffer of past input samples used by the FIR classes.
+/// @details New samples are appended after the previous ones so that the input history is always contiguous in
+/// memory and can be read with vector loads. When the end of the buffer is reached, the history is moved back to the
+/// start of the buffer.
+class FirHistory
+{
+  public:
+    FirHistory() = default;
+    ~FirHistory() = default;
+
+    /// @brief Allocate the buffer.
+    /// @param history The number of past samples that must stay available before the newest block.
+    /// @param max_block The maximum number of samples appended at once.
+    void Init(size_t history, size_t max_block);
+
+    /// @brief Clear the history.
+    void Reset();
+
+    /// @brief Append a block of samples.
+    /// @param in The input samples.
+    /// @param count The number of samples, at most `max_block`.
+    /// @return A pointer to the first appended sample. The `history` samples before it are valid.
+    const float* Append(const float* in, size_t count);
+
+  private:
+    std::vector<float> buffer_;
+    size_t history_ = 0;
+    size_t write_ = 0;
+};
+
+/// @brief General FIR filter with an arbitrary number of taps.
+/// @details Short filters use a direct form kernel vectorized over the taps. Filters with `kFftThreshold` taps or
+/// more use uniformly partitioned overlap-save convolution: the first `kFftPartitionSize` taps run in the direct form,
+/// and the remaining taps are split in partitions of `kFftPartitionSize` taps convolved in the frequency domain. Every
+/// `kFftPartitionSize` input samples, one forward and one inverse FFT of `2 * kFftPartitionSize` points and one
+/// complex multiply-add per partition compute the contribution of the remaining taps to the next `kFftPartitionSize`
+/// outputs. The cost per sample is therefore about `kFftPartitionSize + 2 * taps / kFftPartitionSize` multiply-adds
+/// plus the FFTs, whatever the size of the blocks passed to `ProcessBlock`. Both paths give the same output (up to
+/// rounding) with zero latency. The FFT work is done by the call that completes a partition, so the cost of a call is
+/// not spread evenly over the samples.
+class FirFilter
+{
+  public:
+    /// @brief Tap count from which the filter uses FFT block convolution.
+    static constexpr size_t kFftThreshold = 256;
+
+    /// @brief Size of the tap partitions, and number of samples between two FFTs, when the filter uses FFT block
+    /// convolution.
+    static constexpr size_t kFftPartitionSize = 64;
+
+    FirFilter() = default;
+    ~FirFilter() = default;
+
+    /// @brief Set the filter taps. Allocates memory and clears the filter state.
+    /// @param taps The impulse response of the filter.
+    /// @param count The number of taps.
+    void SetTaps(const float* taps, size_t count);
+
+    /// @brief Returns the number of taps.
+    size_t GetTapCount() const;
+
+    /// @brief Returns true if the filter uses FFT block convolution.
+    bool UsesFft() const;
+
+    /// @brief Clear the filter state.
+    void Reset();
+
+    /// @brief Filter one sample.
+    /// @param in The input sample.
+    /// @return The filtered sample.
+    float Tick(float in);
+
+    /// @brief Filter a block of samples.
+    /// @param in The input buffer.
+    /// @param out The output buffer. Can be the same buffer as `in`.
+    /// @param size The size of the buffers.
+    void ProcessBlock(const float* in, float* out, size_t size);
+
+  private:
+    void ProcessDirect(const float* in, float* out, size_t size);
+    void ProcessFft(const float* in, float* out, size_t size);
+
+    /// @brief Adds the new input partition to the delay line and computes the contribution of the partitioned taps
+    /// to the next `kFftPartitionSize` outputs.
+    void UpdateTail(const float* frame);
+
+    size_t tap_count_ = 0;
+    // All the taps in the direct form, only the first partition with FFT block convolution.
+    std::vector<float> reversed_taps_;
+    FirHistory history_;
+
+    std::unique_ptr<FFT> fft_;
+    // Spectra of the tap partitions after the first one, `bins` values each.
+    std::vector<std::complex<float>> taps_spectrum_;
+    // Frequency domain delay line of the input spectra, one per tap partition, used as a ring buffer.
+    std::vector<std::complex<float>> input_spectra_;
+    size_t partition_count_ = 0;
+    size_t newest_spectrum_ = 0;
+    std::vector<std::complex<float>> spectrum_;
+    std::vector<float> fft_buffer_;
+    // Output of the partitioned taps for the current partition, and the position in it.
+    std::vector<float> tail_;
+    size_t position_ = 0;
+};
+
+/// @brief FIR filter followed by downsampling.
+/// @details Only the output samples that are kept are computed, so the cost per input sample is taps / factor.
+class FirDecimator
+{
+  public:
+    FirDecimator() = default;
+    ~FirDecimator() = default;
+
+    /// @brief Initialize the decimator. Allocates memory and clears the state.
+    /// @param factor The decimation factor.
+    /// @param taps The anti-aliasing filter taps, running at the input samplerate.
+    /// @param count The number of taps.
+    void Init(size_t factor, const float* taps, size_t count);
+
+    /// @brief Clear the state.
+    void Reset();
+
+    /// @brief Process a block of samples.
+    /// @param in The input buffer.
+    /// @param out The output buffer. Must hold at least `size / factor + 1` samples.
+    /// @param size The number of input samples.
+    /// @return The number of output samples written.
+    size_t ProcessBlock(const float* in, float* out, size_t size);
+
+  private:
+    size_t factor_ = 1;
+    size_t phase_ = 0;
+    std::vector<float> reversed_taps_;
+    FirHistory history_;
+};
+
+/// @brief Upsampling followed by a FIR filter, implemented as a polyphase filter bank.
+/// @details The filter is split in `factor` sub-filters of taps / factor taps each, so none of the zeros inserted by
+/// the upsampling are multiplied.
+class FirInterpolator
+{
+  public:
+    FirInterpolator() = default;
+    ~FirInterpolator() = default;
+
+    /// @brief Initialize the interpolator. Allocates memory and clears the state.
+    /// @param factor The interpolation factor.
+    /// @param taps The anti-imaging filter taps, running at the output samplerate. The passband gain should be
+    /// `factor` to compensate for the inserted zeros.
+    /// @param count The number of taps.
+    void Init(size_t factor, const float* taps, size_t count);
+
+    /// @brief Clear the state.
+    void Reset();
+
+    /// @brief Process a block of samples.
+    /// @param in The input buffer.
+    /// @param out The output buffer, `size * factor` samples.
+    /// @param size The number of input samples.
+    void ProcessBlock(const float* in, float* out, size_t size);
+
+  private:
+    size_t factor_ = 1;
+    size_t phase_length_ = 0;
+    std::vector<float> phases_;
+    FirHistory history_;
+};
+} // namespace sfdsp
@@ -0,0 +1,171 @@
+// =============================================================================
+// halfband.h -- 2:1 half-band decimators and interpolators
+//
+// The IIR filters follow the polyphase allpass structure and design procedure of:
+// R. A. Valenzuela, A. G. Constantinides, "Digital signal processing schemes for efficient interpolation and
+// decimation", IEE Proceedings, vol. 130, 1983.
+// L. de Soras, "HIIR", http://ldesoras.free.fr/prod.html
+// =============================================================================
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "fir_filter.h"
+
+namespace sfdsp
+{
+
+/// @brief Design a linear phase half-band lowpass filter.
+/// @details Every other tap of a half-band filter is zero, except the center tap which is 0.5. Only the non-zero
+/// taps outside of the center are returned, which is what the half-band decimator and interpolator use.
+/// @param tap_count The length of the full filter. Must be of the form 4 * K - 1.
+/// @param kaiser_beta The shape parameter of the Kaiser window.
+/// @return The 2 * K non-zero taps outside of the center, in order.
+std::vector<float> DesignHalfbandFir(size_t tap_count, float kaiser_beta = 8.f);
+
+/// @brief Design the coefficients of a polyphase allpass half-band IIR filter.
+/// @param coefs The output coefficients.
+/// @param max_count The size of `coefs`.
+/// @param attenuation_db The stopband attenuation in dB.
+/// @param transition The width of the transition band, relative to the high samplerate. Between 0 and 0.5.
+/// @return The number of coefficients, at most `max_count`. Using fewer coefficients than needed reduces the
+/// attenuation.
+size_t DesignHalfbandIir(float* coefs, size_t max_count, float attenuation_db, float transition);
+
+/// @brief 2:1 decimator using a linear phase half-band FIR filter.
+/// @details The zero taps are skipped and the remaining ones are folded by symmetry, so a filter of 4 * K - 1 taps
+/// costs K multiplies per output sample. Outputs are computed `simd::kFloatWidth` at a time.
+class HalfbandFirDecimator
+{
+  public:
+    HalfbandFirDecimator() = default;
+    ~HalfbandFirDecimator() = default;
+
+    /// @brief Initialize the decimator. Allocates memory and clears the state.
+    /// @param tap_count The length of the half-band filter. Must be of the form 4 * K - 1.
+    /// @param kaiser_beta The shape parameter of the Kaiser window.
+    void Init(size_t tap_count = 47, float kaiser_beta = 8.f);
+
+    /// @brief Clear the state.
+    void Reset();
+
+    /// @brief Returns the delay of the filter, in output samples.
+    float GetLatency() const;
+
+    /// @brief Process a block.
+    /// @param in The input buffer, `2 * size` samples.
+    /// @param out The output buffer, `size` samples.
+    /// @param size The number of output samples.
+    void ProcessBlock(const float* in, float* out, size_t size);
+
+  private:
+    std::vector<float> taps_;
+    FirHistory even_;
+    FirHistory odd_;
+};
+
+/// @brief 1:2 interpolator using a linear phase half-band FIR filter.
+/// @details The odd output samples are delayed copies of the input, only the even ones go through the filter.
+class HalfbandFirInterpolator
+{
+  public:
+    HalfbandFirInterpolator() = default;
+    ~HalfbandFirInterpolator() = default;
+
+    /// @brief Initialize the interpolator. Allocates memory and clears the state.
+    /// @param tap_count The length of the half-band filter. Must be of the form 4 * K - 1.
+    /// @param kaiser_beta The shape parameter of the Kaiser window.
+    void Init(size_t tap_count = 47, float kaiser_beta = 8.f);
+
+    /// @brief Clear the state.
+    void Reset();
+
+    /// @brief Returns the delay of the filter, in input samples.
+    float GetLatency() const;
+
+    /// @brief Process a block.
+    /// @param in The input buffer, `size` samples.
+    /// @param out The output buffer, `2 * size` samples.
+    /// @param size The number of input samples.
+    void ProcessBlock(const float* in, float* out, size_t size);
+
+  private:
+    std::vector<float> taps_;
+    FirHistory history_;
+};
+
+/// @brief Maximum number of coefficients of the half-band IIR filters.
+constexpr size_t kMaxHalfbandIirCoefs = 16;
+
+/// @brief State of the two paths of cascaded first order allpass filters in z^2, shared by the IIR decimator and
+/// interpolator.
+struct HalfbandIirPaths
+{
+    void Init(const float* coefs, size_t count);
+    void Reset();
+
+    size_t count = 0;
+    std::array<float, kMaxHalfbandIirCoefs> coefs = {0.f};
+    std::array<float, kMaxHalfbandIirCoefs + 2> x1 = {0.f};
+};
+
+/// @brief 2:1 decimator using a polyphase allpass half-band IIR filter.
+/// @details Much cheaper than the FIR version for the same attenuation, at the cost of a non-linear phase response.
+/// Each coefficient costs one multiply per output sample.
+class HalfbandIirDecimator
+{
+  public:
+    HalfbandIirDecimator() = default;
+    ~HalfbandIirDecimator() = default;
+
+    /// @brief Initialize the decimator and clear the state.
+    /// @param attenuation_db The stopband attenuation in dB.
+    /// @param transition The width of the transition band, relative to the input samplerate.
+    void Init(float attenuation_db = 96.f, float transition = 0.05f);
+
+    /// @brief Clear the state.
+    void Reset();
+
+    /// @brief Returns the number of allpass coefficients.
+    size_t GetCoefficientCount() const;
+
+    /// @brief Process a block.
+    /// @param in The input buffer, `2 * size` samples.
+    /// @param out The output buffer, `size` samples.
+    /// @param size The number of output samples.
+    void ProcessBlock(const float* in, float* out, size_t size);
+
+  private:
+    HalfbandIirPaths paths_;
+};
+
+/// @brief 1:2 interpolator using a polyphase allpass half-band IIR filter.
+class HalfbandIirInterpolator
+{
+  public:
+    HalfbandIirInterpolator() = default;
+    ~HalfbandIirInterpolator() = default;
+
+    /// @brief Initialize the interpolator and clear the state.
+    /// @param attenuation_db The stopband attenuation in dB.
+    /// @param transition The width of the transition band, relative to the output samplerate.
+    void Init(float attenuation_db = 96.f, float transition = 0.05f);
+
+    /// @brief Clear the state.
+    void Reset();
+
+    /// @brief Returns the number of allpass coefficients.
+    size_t GetCoefficientCount() const;
+
+    /// @brief Process a block.
+    /// @param in The input buffer, `size` samples.
+    /// @param out The output buffer, `2 * size` samples.
+    /// @param size The number of input samples.
+    void ProcessBlock(const float* in, float* out, size_t size);
+
+  private:
+    HalfbandIirPaths paths_;
+};
+} // namespace sfdsp
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "basic_oscillators.h"
+
+namespace sfdsp
+{
+
+/// @brief Bank of sine partials summed to one output, for additive synthesis.
+/// @details The state of the partials is stored in structure-of-arrays layout and `simd::kFloatWidth` partials are
+/// rendered per instruction. Frequency and amplitude changes are ramped linearly over the next block, so a
+/// resynthesis can update every partial once per block without clicks. Partials at or above the Nyquist frequency are
+/// ramped to silence.
+/// @ingroup Oscillators
+class OscillatorBank
+{
+  public:
+    /// @brief How the partials are rendered.
+    enum class Mode
+    {
+        /// @brief Phase accumulators through the polynomial `Sine` block kernel. Exact phase, any frequency ramp.
+        Polynomial,
+
+        /// @brief Recursive oscillators, a complex number rotated by one phase increment per sample. Cheaper per
+        /// sample, the magnitude is renormalized every `kRenormalizeInterval` samples to stop it from drifting.
+        Rotator,
+    };
+
+    /// @brief Number of samples between two renormalizations of the rotators, also the size of the internal chunks.
+    static constexpr size_t kRenormalizeInterval = 64;
+
+    OscillatorBank() = default;
+    ~OscillatorBank() = default;
+
+    /// @brief Initialize the bank. Every partial starts silent at 0 Hz, with a phase of 0.
+    /// @param samplerate The samplerate of the audio system
+    /// @param partial_count The number of partials
+    /// @param mode How the partials are rendered
+    /// @param accuracy The accuracy of the sine kernel in `Mode::Polynomial`
+    void Init(float samplerate, size_t partial_count, Mode mode = Mode::Polynomial,
+              SineAccuracy accuracy = SineAccuracy::Low);
+
+    /// @brief Returns the number of partials.
+    size_t GetPartialCount() const;
+
+    /// @brief Set the frequency of a partial. The change is ramped over the next block.
+    /// @param partial The partial index
+    /// @param frequency The frequency in Hz
+    void SetFrequency(size_t partial, float frequency);
+
+    /// @brief Set the amplitude of a partial. The change is ramped over the next block.
+    /// @param partial The partial index
+    /// @param amplitude The amplitude
+    void SetAmplitude(size_t partial, float amplitude);
+
+    /// @brief Set the frequency and amplitude of a partial immediately, without a ramp.
+    /// @param partial The partial index
+    /// @param frequency The frequency in Hz
+    /// @param amplitude The amplitude
+    void SetPartial(size_t partial, float frequency, float amplitude);
+
+    /// @brief Set the phase of a partial.
+    /// @param partial The partial index
+    /// @param phase The phase, 1 is a full period
+    void SetPhase(size_t partial, float phase);
+
+    /// @brief Reset the phase of every partial to 0.
+    void Reset();
+
+    /// @brief Render the sum of the partials.
+    /// @param out The output buffer
+    /// @param size The number of samples
+    void ProcessBlock(float* out, size_t size);
+
+  private:
+    /// @brief Number of vectors of partials rendered together, the partial count is padded to a multiple of it.
+    static constexpr size_t kGroupsPerPass = 4;
+
+    /// @brief Accumulate one chunk of every partial into `lane_sums_`.
+    /// @param size The number of samples, at most `kRenormalizeInterval`
+    /// @param ramp_scale One over the number of samples left in the block
+    void RenderPolynomial(size_t size, float ramp_scale);
+    void RenderRotator(size_t size, float ramp_scale);
+
+    /// @brief Compute the rotations of the target frequencies, after a frequency change.
+    void UpdateRotations();
+
+    float samplerate_ = 48000.f;
+    size_t partial_count_ = 0;
+    Mode mode_ = Mode::Polynomial;
+    SineAccuracy accuracy_ = SineAccuracy::Low;
+
+    // One entry per partial, padded to a multiple of `kGroupsPerPass` vectors. The padding partials stay silent.
+    std::vector<float> increment_;
+    std::vector<float> target_increment_;
+    std::vector<float> amplitude_;
+    std::vector<float> target_amplitude_;
+
+    // Mode::Polynomial state.
+    std::vector<float> phase_;
+
+    // Mode::Rotator state, the partial is the imaginary part of re + j im.
+    std::vector<float> re_;
+    std::vector<float> im_;
+    std::vector<float> cos_;
+    std::vector<float> sin_;
+    std::vector<float> target_cos_;
+    std::vector<float> target_sin_;
+    bool rotations_dirty_ = false;
+
+    // Per-lane partial sums of a chunk, and the phases of a chunk of partials.
+    std::vector<float> lane_sums_;
+    std::vector<float> chunk_phases_;
+};
+} // namespace sfdsp
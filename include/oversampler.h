@@ -0,0 +1,205 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "halfband.h"
+
+namespace sfdsp
+{
+
+/// @brief Runs a processing function at `Factor` times the samplerate.
+/// @details The signal is upsampled and downsampled by cascaded 2x half-band FIR stages, so that only the wrapped
+/// section (typically a nonlinearity) runs at the high rate. The stage closest to the base samplerate uses a long
+/// filter with a passband up to 0.4 * the base Nyquist frequency and about 70 dB of image rejection. The following
+/// stages only have to reject the images of an already band limited signal and use short filters.
+///
+/// The filters are linear phase, which adds `GetLatency()` samples of delay. Because of that, the wrapper is meant
+/// for feed-forward sections, not for a nonlinearity inside a feedback loop like the bow of `BowedString`.
+/// @tparam Factor The oversampling factor, 2, 4 or 8.
+template <size_t Factor>
+class Oversampler
+{
+    static_assert(Factor == 2 || Factor == 4 || Factor == 8, "Oversampler supports factors of 2, 4 and 8");
+
+  public:
+    /// @brief The oversampling factor.
+    static constexpr size_t kFactor = Factor;
+
+    /// @brief The maximum number of base rate samples processed at once. Longer blocks are split.
+    static constexpr size_t kMaxBlockSize = 128;
+
+    /// @brief Construct the oversampler. Designs the filters and allocates the internal buffers.
+    Oversampler();
+    ~Oversampler() = default;
+
+    /// @brief Clear the state of every filter.
+    void Reset();
+
+    /// @brief Returns the delay added by the upsampling and downsampling filters, in base rate samples.
+    float GetLatency() const;
+
+    /// @brief Returns the delay added by the downsampling filters alone, in base rate samples. This is the latency of
+    /// a signal generated at the high rate and only passed through `Downsample`.
+    float GetDownsampleLatency() const;
+
+    /// @brief Upsample a block.
+    /// @param in The input buffer, `size` samples at the base rate.
+    /// @param out The output buffer, `size * Factor` samples.
+    /// @param size The number of input samples, at most `kMaxBlockSize`.
+    void Upsample(const float* in, float* out, size_t size);
+
+    /// @brief Downsample a block.
+    /// @param in The input buffer, `size * Factor` samples at the high rate.
+    /// @param out The output buffer, `size` samples at the base rate.
+    /// @param size The number of output samples, at most `kMaxBlockSize`.
+    void Downsample(const float* in, float* out, size_t size);
+
+    /// @brief Upsample a block, process it at the high rate and downsample the result.
+    /// @param in The input buffer.
+    /// @param out The output buffer. Can be the same buffer as `in`.
+    /// @param size The number of base rate samples.
+    /// @param process Called as `process(float* buffer, size_t count)` on the upsampled signal, in place.
+    template <typename ProcessFn>
+    void Process(const float* in, float* out, size_t size, ProcessFn&& process);
+
+  private:
+    static constexpr size_t kStageCount = (Factor == 2) ? 1 : (Factor == 4) ? 2 : 3;
+    static constexpr size_t kFirstStageTaps = 47;
+    static constexpr size_t kStageTaps = 19;
+    static constexpr float kKaiserBeta = 7.f;
+
+    static constexpr size_t StageTaps(size_t stage)
+    {
+        return (stage == 0) ? kFirstStageTaps : kStageTaps;
+    }
+
+    /// @brief Run the upsampling stages. Stage k goes from 2^k to 2^(k+1) times the base rate.
+    void UpsampleStages(const float* in, float* out, size_t size);
+
+    std::array<HalfbandFirInterpolator, kStageCount> up_;
+    std::array<HalfbandFirDecimator, kStageCount> down_;
+    std::vector<float> scratch_;
+    std::vector<float> oversampled_;
+};
+
+template <size_t Factor>
+Oversampler<Factor>::Oversampler()
+{
+    for (size_t stage = 0; stage < kStageCount; ++stage)
+    {
+        up_[stage].Init(StageTaps(stage), kKaiserBeta);
+        down_[stage].Init(StageTaps(stage), kKaiserBeta);
+    }
+
+    scratch_.resize(kMaxBlockSize * Factor);
+    oversampled_.resize(kMaxBlockSize * Factor);
+}
+
+template <size_t Factor>
+void Oversampler<Factor>::Reset()
+{
+    for (size_t stage = 0; stage < kStageCount; ++stage)
+    {
+        up_[stage].Reset();
+        down_[stage].Reset();
+    }
+}
+
+template <size_t Factor>
+float Oversampler<Factor>::GetLatency() const
+{
+    // Each stage reports its latency at its low rate, stage k runs at 2^k times the base rate.
+    float latency = 0.f;
+    float rate = 1.f;
+    for (size_t stage = 0; stage < kStageCount; ++stage)
+    {
+        latency += (up_[stage].GetLatency() + down_[stage].GetLatency()) / rate;
+        rate *= 2.f;
+    }
+    return latency;
+}
+
+template <size_t Factor>
+float Oversampler<Factor>::GetDownsampleLatency() const
+{
+    // The decimators report their latency at their output rate, stage k outputs 2^k times the base rate.
+    float latency = 0.f;
+    float rate = 1.f;
+    for (size_t stage = 0; stage < kStageCount; ++stage)
+    {
+        latency += down_[stage].GetLatency() / rate;
+        rate *= 2.f;
+    }
+    return latency;
+}
+
+template <size_t Factor>
+void Oversampler<Factor>::UpsampleStages(const float* in, float* out, size_t size)
+{
+    // Ping-pong between the scratch buffer and the output so that the last stage writes into `out`.
+    float* buffers[2] = {out, scratch_.data()};
+    size_t target = (kStageCount % 2 == 0) ? 1 : 0;
+
+    const float* stage_in = in;
+    for (size_t stage = 0; stage < kStageCount; ++stage)
+    {
+        float* stage_out = buffers[target];
+        up_[stage].ProcessBlock(stage_in, stage_out, size);
+        stage_in = stage_out;
+        size *= 2;
+        target ^= 1;
+    }
+}
+
+template <size_t Factor>
+void Oversampler<Factor>::Upsample(const float* in, float* out, size_t size)
+{
+    assert(in != nullptr);
+    assert(out != nullptr);
+    assert(size <= kMaxBlockSize);
+
+    UpsampleStages(in, out, size);
+}
+
+template <size_t Factor>
+void Oversampler<Factor>::Downsample(const float* in, float* out, size_t size)
+{
+    assert(in != nullptr);
+    assert(out != nullptr);
+    assert(size <= kMaxBlockSize);
+
+    const float* stage_in = in;
+    size_t count = size * Factor;
+    for (size_t stage = kStageCount; stage-- > 0;)
+    {
+        float* stage_out = (stage == 0) ? out : scratch_.data();
+        count /= 2;
+        down_[stage].ProcessBlock(stage_in, stage_out, count);
+        stage_in = stage_out;
+    }
+}
+
+template <size_t Factor>
+template <typename ProcessFn>
+void Oversampler<Factor>::Process(const float* in, float* out, size_t size, ProcessFn&& process)
+{
+    assert(in != nullptr);
+    assert(out != nullptr);
+
+    while (size > 0)
+    {
+        const size_t block = std::min(size, kMaxBlockSize);
+        UpsampleStages(in, oversampled_.data(), block);
+        process(oversampled_.data(), block * Factor);
+        Downsample(oversampled_.data(), out, block);
+
+        in += block;
+        out += block;
+        size -= block;
+    }
+}
+} // namespace sfdsp
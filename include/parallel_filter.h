@@ -0,0 +1,169 @@
+// =============================================================================
+// parallel_filter.h -- Parallel form IIR filter
+//
+// A cascade of second order sections is converted to a sum of independent second order sections using a partial
+// fraction expansion. See J.O. Smith, "Introduction to Digital Filters", Parallel Form:
+// https://ccrma.stanford.edu/~jos/filters/Parallel_Form.html
+// =============================================================================
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+#include "filter.h"
+#include "simd.h"
+
+namespace sfdsp
+{
+
+/// @brief Convert a cascade of biquads into an equivalent parallel sum of second order sections plus a direct gain.
+/// @details With H(z) = gain * prod(B_k(z) / A_k(z)), the output is H(z) = direct_gain + sum(P_k(z) / A_k(z)) where
+/// P_k(z) = b0 + b1 z^-1. The denominators are unchanged, only the numerators are recomputed from the residues of the
+/// poles. This is meant to be done once at initialization time.
+/// @param cascade The normalized coefficients of the cascaded sections.
+/// @param count The number of sections.
+/// @param gain Gain applied to the input of the cascade.
+/// @param parallel Output array of `count` sections. The b2 coefficients are always 0.
+/// @param direct_gain The gain of the direct (FIR) path.
+/// @return False if the cascade cannot be expanded: every section must have two poles (a2 != 0) and all poles must be
+/// distinct.
+bool CascadeToParallel(const BiquadCoefficients* cascade, size_t count, float gain, BiquadCoefficients* parallel,
+                       float& direct_gain);
+
+/// @brief Sum of N independent second order sections and a direct path.
+/// @details Unlike a cascade, where every section depends on the output of the previous one, the sections are all
+/// fed the same input and are processed in parallel, `simd::kFloatWidth` at a time.
+/// @tparam N The number of sections.
+template <size_t N>
+class ParallelFilter
+{
+    static_assert(N > 0, "ParallelFilter needs at least one section");
+
+  public:
+    ParallelFilter() = default;
+    ~ParallelFilter() = default;
+
+    /// @brief Set the filter from a cascade of N biquads.
+    /// @param cascade The normalized coefficients of the cascaded sections.
+    /// @param gain Gain applied to the input of the cascade.
+    /// @return False if the cascade cannot be converted. See `CascadeToParallel`.
+    bool SetCascade(const std::array<BiquadCoefficients, N>& cascade, float gain = 1.f);
+
+    /// @brief Set the parallel sections directly.
+    /// @param sections The sections. The b2 coefficients are ignored.
+    /// @param direct_gain The gain of the direct path.
+    void SetSections(const std::array<BiquadCoefficients, N>& sections, float direct_gain);
+
+    /// @brief Clear the filter state.
+    void Reset();
+
+    /// @brief Input a sample in the filter and return the next output
+    /// @param in The input sample
+    /// @return The next output sample
+    float Tick(float in);
+
+    /// @brief Filter a block of samples. 'in' and 'out' can be the same buffer.
+    /// @param in The input buffer.
+    /// @param out The output buffer.
+    /// @param size The size of the buffer.
+    void ProcessBlock(const float* in, float* out, size_t size);
+
+  private:
+    static constexpr size_t kPaddedCount = simd::PaddedSize(N);
+    static constexpr size_t kGroupCount = kPaddedCount / simd::kFloatWidth;
+
+    // Unused lanes have zero coefficients and never produce any output.
+    std::array<float, kPaddedCount> b0_ = {0.f};
+    std::array<float, kPaddedCount> b1_ = {0.f};
+    std::array<float, kPaddedCount> a1_ = {0.f};
+    std::array<float, kPaddedCount> a2_ = {0.f};
+
+    std::array<float, kPaddedCount> z1_ = {0.f};
+    std::array<float, kPaddedCount> z2_ = {0.f};
+
+    float direct_gain_ = 0.f;
+};
+
+template <size_t N>
+bool ParallelFilter<N>::SetCascade(const std::array<BiquadCoefficients, N>& cascade, float gain)
+{
+    std::array<BiquadCoefficients, N> sections;
+    float direct_gain = 0.f;
+    if (!CascadeToParallel(cascade.data(), N, gain, sections.data(), direct_gain))
+    {
+        return false;
+    }
+
+    SetSections(sections, direct_gain);
+    return true;
+}
+
+template <size_t N>
+void ParallelFilter<N>::SetSections(const std::array<BiquadCoefficients, N>& sections, float direct_gain)
+{
+    for (size_t i = 0; i < N; ++i)
+    {
+        b0_[i] = sections[i].b0;
+        b1_[i] = sections[i].b1;
+        a1_[i] = sections[i].a1;
+        a2_[i] = sections[i].a2;
+    }
+    direct_gain_ = direct_gain;
+}
+
+template <size_t N>
+void ParallelFilter<N>::Reset()
+{
+    z1_.fill(0.f);
+    z2_.fill(0.f);
+}
+
+template <size_t N>
+float ParallelFilter<N>::Tick(float in)
+{
+    float out = 0.f;
+    ProcessBlock(&in, &out, 1);
+    return out;
+}
+
+template <size_t N>
+void ParallelFilter<N>::ProcessBlock(const float* in, float* out, size_t size)
+{
+    assert(in != nullptr);
+    assert(out != nullptr);
+
+    simd::float_v z1[kGroupCount];
+    simd::float_v z2[kGroupCount];
+    for (size_t g = 0; g < kGroupCount; ++g)
+    {
+        z1[g] = simd::Load(&z1_[g * simd::kFloatWidth]);
+        z2[g] = simd::Load(&z2_[g * simd::kFloatWidth]);
+    }
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        const float x = in[i];
+        const simd::float_v xv = simd::Broadcast(x);
+        simd::float_v acc = simd::Zero();
+
+        // Transposed direct form II, the sections only depend on their own state.
+        for (size_t g = 0; g < kGroupCount; ++g)
+        {
+            const size_t c = g * simd::kFloatWidth;
+            const simd::float_v y = simd::MulAdd(simd::Load(&b0_[c]), xv, z1[g]);
+            z1[g] = simd::Sub(simd::MulAdd(simd::Load(&b1_[c]), xv, z2[g]), simd::Mul(simd::Load(&a1_[c]), y));
+            z2[g] = simd::Sub(simd::Zero(), simd::Mul(simd::Load(&a2_[c]), y));
+            acc = simd::Add(acc, y);
+        }
+
+        out[i] = direct_gain_ * x + simd::ReduceAdd(acc);
+    }
+
+    for (size_t g = 0; g < kGroupCount; ++g)
+    {
+        simd::Store(&z1_[g * simd::kFloatWidth], z1[g]);
+        simd::Store(&z2_[g * simd::kFloatWidth], z2[g]);
+    }
+}
+} // namespace sfdsp
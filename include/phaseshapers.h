@@ -10,6 +10,7 @@
 // Alex St-Onge
 // =============================================================================
 #pragma once
+#include <array>
 #include <cstddef>
 #include <cstdint>
 
@@ -76,39 +77,68 @@ class Phaseshaper
     /// For example, for Waveform::VARIABLE_SLOPE, the modulation parameter controls the width of the waveform.
     void SetMod(float mod);
 
+    /// @brief Renders from precomputed wavetables instead of evaluating the phaseshaping functions.
+    /// @details Each waveform is pre-rendered at 9 evenly spaced modulation amounts and band-limited into one table
+    /// per octave, so a sample is a few table reads whatever the waveform, without aliasing. Modulation amounts between
+    /// two renderings are crossfaded, which only approximates the waveforms whose edges move with the modulation, like
+    /// Waveform::SUPERSAW and Waveform::TRIANGLE_MOD. The tables of a waveform are built the first time it is played in
+    /// this mode and shared by every Phaseshaper, about 150 kB per waveform. Building allocates and takes a few
+    /// milliseconds, call PrepareWavetables beforehand to keep it off the audio thread.
+    /// @param enabled True to render from the wavetables
+    void SetWavetableMode(bool enabled)
+    {
+        wavetable_mode_ = enabled;
+    }
+
+    /// @brief Builds the wavetables of a waveform used by SetWavetableMode, if they are not built yet.
+    /// @details Allocates and blocks for a few milliseconds. Call it from a setup or loading thread, before playing the
+    /// waveform in wavetable mode. Safe to call from several threads at once.
+    /// @param wave The waveform
+    static void PrepareWavetables(Waveform wave);
+
+    /// @brief Builds the wavetables of every waveform. See PrepareWavetables(Waveform).
+    static void PrepareWavetables();
+
     /// @brief Processes the oscillator
     /// @return The next sample
     float Process();
 
+    /// @brief Renders a block of samples.
+    /// @param out The output buffer
+    /// @param size The number of samples
     void ProcessBlock(float* out, size_t size);
 
+    /// @brief Renders a block of samples with audio rate frequency and modulation.
+    /// @details Each buffer holds one value per sample and overrides SetFreq or SetMod for this block only. The
+    /// output is the same as calling SetFreq and SetMod before every call to Process. When both buffers are null,
+    /// this is the same as the constant parameter ProcessBlock.
+    /// @param out The output buffer
+    /// @param size The number of samples
+    /// @param freq Frequency of each sample in Hz, or nullptr to use the frequency set with SetFreq
+    /// @param mod Modulation amount of each sample, clamped between 0 and 1, or nullptr to use the value set with
+    /// SetMod
+    void ProcessBlock(float* out, size_t size, const float* freq, const float* mod);
+
   private:
     float ProcessWaveSlice() const;
-    void ProcessWaveSliceBlock(const float* p, float* out, size_t size, float gain) const;
 
     float ProcessHardSync() const;
     void ProcessHardSyncBlock(const float* p, float* out, size_t size, float gain) const;
 
     float ProcessSoftSync() const;
-    void ProcessSoftSyncBlock(const float* p, float* out, size_t size, float gain) const;
 
     float ProcessTriMod() const;
-    void ProcessTriModBlock(const float* p, float* out, size_t size, float gain) const;
 
     float ProcessSupersaw() const;
-    void ProcessSupersawBlock(const float* p, float* out, size_t size, float gain) const;
 
     float ProcessVarSlope(float phase) const;
-    void ProcessVarSlopeBlock(const float* p, float* out, size_t size, float gain) const;
 
     float ProcessVarTri() const;
     void ProcessVarTriBlock(const float* p, float* out, size_t size, float gain) const;
 
     float ProcessRipple() const;
-    void ProcessRippleBlock(const float* p, float* out, size_t size, float gain) const;
 
     float ProcessWave(Waveform wave);
-    void ProcessWaveBlock(const float* p, float* out, size_t size, Waveform wave, float gain);
 
   private:
     float samplerate_ = 0.f;
@@ -119,5 +149,95 @@ class Phaseshaper
     float waveform_ = static_cast<float>(Waveform::WAVESLICE);
 
     float mod_ = 0.f;
+    bool wavetable_mode_ = false;
+};
+
+/// @brief Stack of detuned Phaseshaper voices spread across the stereo field, for unison and supersaw pads.
+/// @details The voices are stored in structure-of-arrays layout and interleaved in the phase buffers, so that the
+/// phase accumulators and the stereo mix process `simd::kFloatWidth` voices per instruction. The waveform is resolved
+/// once per block and each waveform kernel runs over every voice at once.
+class PhaseshaperUnison
+{
+  public:
+    /// @brief Maximum number of voices.
+    static constexpr size_t kMaxVoices = 16;
+
+    using Waveform = Phaseshaper::Waveform;
+
+    PhaseshaperUnison() = default;
+    ~PhaseshaperUnison() = default;
+
+    /// @brief Initializes the oscillator
+    /// @param sampleRate
+    /// @param voice_count Number of voices, clamped between 1 and kMaxVoices
+    void Init(float sampleRate, size_t voice_count = 7);
+
+    /// @brief Sets the number of voices. The phase of the voices is reset.
+    /// @param voice_count Number of voices, clamped between 1 and kMaxVoices
+    void SetVoiceCount(size_t voice_count);
+
+    /// @brief Returns the number of voices.
+    size_t GetVoiceCount() const
+    {
+        return voice_count_;
+    }
+
+    /// @brief Sets the waveform
+    /// @param wave floating point value between Waveform::VARIABLE_SLOPE and Waveform::NUM_WAVES
+    /// @note See Phaseshaper::SetWaveform.
+    void SetWaveform(float wave)
+    {
+        waveform_ = wave;
+    }
+
+    /// @brief Sets the waveform.
+    /// @param wave Waveform to use.
+    void SetWaveform(Waveform wave)
+    {
+        waveform_ = static_cast<float>(wave);
+    }
+
+    /// @brief Sets the frequency of the center of the stack
+    /// @param freq Frequency in Hz
+    void SetFreq(float freq);
+
+    /// @brief Sets the detuning of the voices. The voices are spread evenly between -detune and +detune.
+    /// @param cents Detuning of the outermost voices, in cents
+    void SetDetune(float cents);
+
+    /// @brief Sets the stereo spread of the voices. The lowest voice is panned left and the highest voice right.
+    /// @param spread Stereo width, clamped between 0 (mono) and 1 (outermost voices panned hard)
+    void SetSpread(float spread);
+
+    /// @brief Sets the modulation amount. See Phaseshaper::SetMod.
+    /// @param mod Modulation amount, clamped between 0 and 1
+    void SetMod(float mod);
+
+    /// @brief Renders a block of stereo output.
+    /// @details The voices are panned with an equal power law and summed with a gain of 1/sqrt(voice count).
+    /// @param left Left output buffer
+    /// @param right Right output buffer
+    /// @param size Number of samples
+    void ProcessBlock(float* left, float* right, size_t size);
+
+  private:
+    void UpdateIncrements();
+    void UpdateGains();
+
+    float samplerate_ = 0.f;
+    float freq_ = 220.f;
+    float detune_ = 0.f;
+    float spread_ = 0.f;
+    float waveform_ = static_cast<float>(Waveform::SUPERSAW);
+    float mod_ = 0.f;
+
+    size_t voice_count_ = 1;
+    // Voice count rounded up to the vector width. The padding voices are silent.
+    size_t lane_count_ = 1;
+
+    std::array<float, kMaxVoices> phases_ = {};
+    std::array<float, kMaxVoices> increments_ = {};
+    std::array<float, kMaxVoices> left_gains_ = {};
+    std::array<float, kMaxVoices> right_gains_ = {};
 };
 } // namespace sfdsp
\ No newline at end of file
@@ -0,0 +1,589 @@
+// =============================================================================
+// simd.h -- Thin portable wrapper around the platform's float vector type
+//
+// The widest instruction set enabled at compile time is selected:
+// AVX-512 (16 lanes), AVX (8 lanes), SSE2 or NEON (4 lanes). When none of these are available (e.g. the Daisy
+// Cortex-M7 build), or when LIBDSP_NO_SIMD is defined, a scalar fallback with a single lane is used.
+// =============================================================================
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(LIBDSP_NO_SIMD)
+#define LIBDSP_SIMD_SCALAR
+#elif defined(__AVX512F__)
+#define LIBDSP_SIMD_AVX512
+#include <immintrin.h>
+#elif defined(__AVX__)
+#define LIBDSP_SIMD_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LIBDSP_SIMD_SSE
+#include <emmintrin.h>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define LIBDSP_SIMD_NEON
+#include <arm_neon.h>
+#else
+#define LIBDSP_SIMD_SCALAR
+#endif
+
+#if defined(LIBDSP_SIMD_SCALAR)
+#include <cmath>
+#endif
+
+namespace sfdsp::simd
+{
+
+#if defined(LIBDSP_SIMD_AVX512)
+
+/// @brief Number of float lanes in a vector.
+constexpr size_t kFloatWidth = 16;
+/// @brief Native float vector type.
+using float_v = __m512;
+/// @brief Native comparison mask type.
+using mask_v = __mmask16;
+
+inline float_v Load(const float* p)
+{
+    return _mm512_loadu_ps(p);
+}
+
+inline void Store(float* p, float_v v)
+{
+    _mm512_storeu_ps(p, v);
+}
+
+inline float_v Broadcast(float x)
+{
+    return _mm512_set1_ps(x);
+}
+
+inline float_v Add(float_v a, float_v b)
+{
+    return _mm512_add_ps(a, b);
+}
+
+inline float_v Sub(float_v a, float_v b)
+{
+    return _mm512_sub_ps(a, b);
+}
+
+inline float_v Mul(float_v a, float_v b)
+{
+    return _mm512_mul_ps(a, b);
+}
+
+inline float_v Div(float_v a, float_v b)
+{
+    return _mm512_div_ps(a, b);
+}
+
+inline float_v MulAdd(float_v a, float_v b, float_v c)
+{
+    return _mm512_fmadd_ps(a, b, c);
+}
+
+inline float_v Min(float_v a, float_v b)
+{
+    // Masked form for the same -Wmaybe-uninitialized reason as `Floor`.
+    return _mm512_mask_min_ps(a, 0xFFFF, a, b);
+}
+
+inline float_v Max(float_v a, float_v b)
+{
+    return _mm512_mask_max_ps(a, 0xFFFF, a, b);
+}
+
+inline float_v Abs(float_v a)
+{
+    return _mm512_abs_ps(a);
+}
+
+inline float_v Floor(float_v a)
+{
+    // The unmasked intrinsic passes an undefined source vector that trips -Wmaybe-uninitialized on GCC, use the masked
+    // form with all lanes set instead.
+    return _mm512_mask_roundscale_ps(a, 0xFFFF, a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+}
+
+inline mask_v CmpLt(float_v a, float_v b)
+{
+    return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);
+}
+
+inline mask_v CmpGt(float_v a, float_v b)
+{
+    return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ);
+}
+
+inline float_v Select(mask_v m, float_v if_true, float_v if_false)
+{
+    return _mm512_mask_blend_ps(m, if_false, if_true);
+}
+
+inline bool Any(mask_v m)
+{
+    return m != 0;
+}
+
+inline float ReduceAdd(float_v a)
+{
+    // The GCC extract intrinsics used by _mm512_reduce_add_ps trip -Wmaybe-uninitialized, go through memory instead.
+    alignas(64) float lanes[16];
+    _mm512_store_ps(lanes, a);
+    __m256 sum = _mm256_add_ps(_mm256_load_ps(lanes), _mm256_load_ps(lanes + 8));
+    __m128 sum4 = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+    sum4 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+    sum4 = _mm_add_ss(sum4, _mm_shuffle_ps(sum4, sum4, 0x1));
+    return _mm_cvtss_f32(sum4);
+}
+
+#elif defined(LIBDSP_SIMD_AVX)
+
+constexpr size_t kFloatWidth = 8;
+using float_v = __m256;
+using mask_v = __m256;
+
+inline float_v Load(const float* p)
+{
+    return _mm256_loadu_ps(p);
+}
+
+inline void Store(float* p, float_v v)
+{
+    _mm256_storeu_ps(p, v);
+}
+
+inline float_v Broadcast(float x)
+{
+    return _mm256_set1_ps(x);
+}
+
+inline float_v Add(float_v a, float_v b)
+{
+    return _mm256_add_ps(a, b);
+}
+
+inline float_v Sub(float_v a, float_v b)
+{
+    return _mm256_sub_ps(a, b);
+}
+
+inline float_v Mul(float_v a, float_v b)
+{
+    return _mm256_mul_ps(a, b);
+}
+
+inline float_v Div(float_v a, float_v b)
+{
+    return _mm256_div_ps(a, b);
+}
+
+inline float_v MulAdd(float_v a, float_v b, float_v c)
+{
+#if defined(__FMA__)
+    return _mm256_fmadd_ps(a, b, c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+
+inline float_v Min(float_v a, float_v b)
+{
+    return _mm256_min_ps(a, b);
+}
+
+inline float_v Max(float_v a, float_v b)
+{
+    return _mm256_max_ps(a, b);
+}
+
+inline float_v Abs(float_v a)
+{
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a);
+}
+
+inline float_v Floor(float_v a)
+{
+    return _mm256_floor_ps(a);
+}
+
+inline mask_v CmpLt(float_v a, float_v b)
+{
+    return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+}
+
+inline mask_v CmpGt(float_v a, float_v b)
+{
+    return _mm256_cmp_ps(a, b, _CMP_GT_OQ);
+}
+
+inline float_v Select(mask_v m, float_v if_true, float_v if_false)
+{
+    return _mm256_blendv_ps(if_false, if_true, m);
+}
+
+inline bool Any(mask_v m)
+{
+    return _mm256_movemask_ps(m) != 0;
+}
+
+inline float ReduceAdd(float_v a)
+{
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 0x1));
+    return _mm_cvtss_f32(sum);
+}
+
+#elif defined(LIBDSP_SIMD_SSE)
+
+constexpr size_t kFloatWidth = 4;
+using float_v = __m128;
+using mask_v = __m128;
+
+inline float_v Load(const float* p)
+{
+    return _mm_loadu_ps(p);
+}
+
+inline void Store(float* p, float_v v)
+{
+    _mm_storeu_ps(p, v);
+}
+
+inline float_v Broadcast(float x)
+{
+    return _mm_set1_ps(x);
+}
+
+inline float_v Add(float_v a, float_v b)
+{
+    return _mm_add_ps(a, b);
+}
+
+inline float_v Sub(float_v a, float_v b)
+{
+    return _mm_sub_ps(a, b);
+}
+
+inline float_v Mul(float_v a, float_v b)
+{
+    return _mm_mul_ps(a, b);
+}
+
+inline float_v Div(float_v a, float_v b)
+{
+    return _mm_div_ps(a, b);
+}
+
+inline float_v MulAdd(float_v a, float_v b, float_v c)
+{
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+}
+
+inline float_v Min(float_v a, float_v b)
+{
+    return _mm_min_ps(a, b);
+}
+
+inline float_v Max(float_v a, float_v b)
+{
+    return _mm_max_ps(a, b);
+}
+
+inline float_v Abs(float_v a)
+{
+    return _mm_andnot_ps(_mm_set1_ps(-0.f), a);
+}
+
+inline float_v Floor(float_v a)
+{
+#if defined(__SSE4_1__)
+    return _mm_floor_ps(a);
+#else
+    // Truncate, then correct the negative non-integer values. Only valid for |a| < 2^31.
+    const __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+    return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a), _mm_set1_ps(1.f)));
+#endif
+}
+
+inline mask_v CmpLt(float_v a, float_v b)
+{
+    return _mm_cmplt_ps(a, b);
+}
+
+inline mask_v CmpGt(float_v a, float_v b)
+{
+    return _mm_cmpgt_ps(a, b);
+}
+
+inline float_v Select(mask_v m, float_v if_true, float_v if_false)
+{
+#if defined(__SSE4_1__)
+    return _mm_blendv_ps(if_false, if_true, m);
+#else
+    return _mm_or_ps(_mm_and_ps(m, if_true), _mm_andnot_ps(m, if_false));
+#endif
+}
+
+inline bool Any(mask_v m)
+{
+    return _mm_movemask_ps(m) != 0;
+}
+
+inline float ReduceAdd(float_v a)
+{
+    __m128 sum = _mm_add_ps(a, _mm_movehl_ps(a, a));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 0x1));
+    return _mm_cvtss_f32(sum);
+}
+
+#elif defined(LIBDSP_SIMD_NEON)
+
+constexpr size_t kFloatWidth = 4;
+using float_v = float32x4_t;
+using mask_v = uint32x4_t;
+
+inline float_v Load(const float* p)
+{
+    return vld1q_f32(p);
+}
+
+inline void Store(float* p, float_v v)
+{
+    vst1q_f32(p, v);
+}
+
+inline float_v Broadcast(float x)
+{
+    return vdupq_n_f32(x);
+}
+
+inline float_v Add(float_v a, float_v b)
+{
+    return vaddq_f32(a, b);
+}
+
+inline float_v Sub(float_v a, float_v b)
+{
+    return vsubq_f32(a, b);
+}
+
+inline float_v Mul(float_v a, float_v b)
+{
+    return vmulq_f32(a, b);
+}
+
+inline float_v Div(float_v a, float_v b)
+{
+#if defined(__aarch64__)
+    return vdivq_f32(a, b);
+#else
+    // No vector division on ARMv7, refine the reciprocal estimate with two Newton-Raphson steps.
+    float32x4_t r = vrecpeq_f32(b);
+    r = vmulq_f32(vrecpsq_f32(b, r), r);
+    r = vmulq_f32(vrecpsq_f32(b, r), r);
+    return vmulq_f32(a, r);
+#endif
+}
+
+inline float_v MulAdd(float_v a, float_v b, float_v c)
+{
+#if defined(__aarch64__)
+    return vfmaq_f32(c, a, b);
+#else
+    return vmlaq_f32(c, a, b);
+#endif
+}
+
+inline float_v Min(float_v a, float_v b)
+{
+    return vminq_f32(a, b);
+}
+
+inline float_v Max(float_v a, float_v b)
+{
+    return vmaxq_f32(a, b);
+}
+
+inline float_v Abs(float_v a)
+{
+    return vabsq_f32(a);
+}
+
+inline float_v Floor(float_v a)
+{
+#if defined(__aarch64__)
+    return vrndmq_f32(a);
+#else
+    const float32x4_t t = vcvtq_f32_s32(vcvtq_s32_f32(a));
+    const uint32x4_t m = vcgtq_f32(t, a);
+    return vsubq_f32(t, vreinterpretq_f32_u32(vandq_u32(m, vreinterpretq_u32_f32(vdupq_n_f32(1.f)))));
+#endif
+}
+
+inline mask_v CmpLt(float_v a, float_v b)
+{
+    return vcltq_f32(a, b);
+}
+
+inline mask_v CmpGt(float_v a, float_v b)
+{
+    return vcgtq_f32(a, b);
+}
+
+inline float_v Select(mask_v m, float_v if_true, float_v if_false)
+{
+    return vbslq_f32(m, if_true, if_false);
+}
+
+inline bool Any(mask_v m)
+{
+#if defined(__aarch64__)
+    return vmaxvq_u32(m) != 0;
+#else
+    const uint32x2_t r = vorr_u32(vget_low_u32(m), vget_high_u32(m));
+    return (vget_lane_u32(r, 0) | vget_lane_u32(r, 1)) != 0;
+#endif
+}
+
+inline float ReduceAdd(float_v a)
+{
+#if defined(__aarch64__)
+    return vaddvq_f32(a);
+#else
+    const float32x2_t r = vadd_f32(vget_low_f32(a), vget_high_f32(a));
+    return vget_lane_f32(vpadd_f32(r, r), 0);
+#endif
+}
+
+#else // LIBDSP_SIMD_SCALAR
+
+constexpr size_t kFloatWidth = 1;
+using float_v = float;
+using mask_v = bool;
+
+inline float_v Load(const float* p)
+{
+    return *p;
+}
+
+inline void Store(float* p, float_v v)
+{
+    *p = v;
+}
+
+inline float_v Broadcast(float x)
+{
+    return x;
+}
+
+inline float_v Add(float_v a, float_v b)
+{
+    return a + b;
+}
+
+inline float_v Sub(float_v a, float_v b)
+{
+    return a - b;
+}
+
+inline float_v Mul(float_v a, float_v b)
+{
+    return a * b;
+}
+
+inline float_v Div(float_v a, float_v b)
+{
+    return a / b;
+}
+
+inline float_v MulAdd(float_v a, float_v b, float_v c)
+{
+    return a * b + c;
+}
+
+inline float_v Min(float_v a, float_v b)
+{
+    return (b < a) ? b : a;
+}
+
+inline float_v Max(float_v a, float_v b)
+{
+    return (a < b) ? b : a;
+}
+
+inline float_v Abs(float_v a)
+{
+    return std::fabs(a);
+}
+
+inline float_v Floor(float_v a)
+{
+    return std::floor(a);
+}
+
+inline mask_v CmpLt(float_v a, float_v b)
+{
+    return a < b;
+}
+
+inline mask_v CmpGt(float_v a, float_v b)
+{
+    return a > b;
+}
+
+inline float_v Select(mask_v m, float_v if_true, float_v if_false)
+{
+    return m ? if_true : if_false;
+}
+
+inline bool Any(mask_v m)
+{
+    return m;
+}
+
+inline float ReduceAdd(float_v a)
+{
+    return a;
+}
+
+#endif
+
+/// @brief Returns a vector with all lanes set to zero.
+inline float_v Zero()
+{
+    return Broadcast(0.f);
+}
+
+/// @brief Rounds `count` up to the next multiple of the vector width.
+constexpr size_t PaddedSize(size_t count)
+{
+    return (count + kFloatWidth - 1) / kFloatWidth * kFloatWidth;
+}
+
+/// @brief Dot product of two buffers. `count` must be a multiple of the vector width.
+inline float Dot(const float* a, const float* b, size_t count)
+{
+    // Two accumulators to hide the latency of the multiply-add.
+    float_v acc0 = Zero();
+    float_v acc1 = Zero();
+    size_t i = 0;
+    for (; i + 2 * kFloatWidth <= count; i += 2 * kFloatWidth)
+    {
+        acc0 = MulAdd(Load(a + i), Load(b + i), acc0);
+        acc1 = MulAdd(Load(a + i + kFloatWidth), Load(b + i + kFloatWidth), acc1);
+    }
+    if (i < count)
+    {
+        acc0 = MulAdd(Load(a + i), Load(b + i), acc0);
+    }
+    return ReduceAdd(Add(acc0, acc1));
+}
+
+} // namespace sfdsp::simd
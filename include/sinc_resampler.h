@@ -6,6 +6,10 @@
 #pragma once
 
 #include <stdlib.h>
+#include <vector>
+
+#include "fir_filter.h"
+#include "sinc_tables.h"
 
 namespace sfdsp
 {
@@ -16,4 +20,164 @@ namespace sfdsp
 /// @param out Output signal
 /// @param[in, out] out_size Size of the output signal
 void sinc_resample(const float* in, size_t input_size, float ratio, float* out, size_t& out_size);
-} // namespace sfdsp
\ No newline at end of file
+
+/// @brief Resamples an interleaved multichannel signal by the given ratio using a windowed sinc filter
+/// @details The filter weights of each output frame are computed once and shared by all channels.
+/// @param in Interleaved input signal
+/// @param input_size Number of input frames
+/// @param channels Number of channels
+/// @param ratio Ratio to resample by
+/// @param out Interleaved output signal
+/// @param[in, out] out_size Number of output frames
+void sinc_resample(const float* in, size_t input_size, size_t channels, float ratio, float* out, size_t& out_size);
+
+/// @brief Streaming resampler for rational ratios, using the same windowed sinc filter as `sinc_resample`.
+/// @details The ratio is reduced to L / M and the filter is sampled once per output phase when the resampler is
+/// initialized, so every output sample is a single dot product between a precomputed row of taps and the input
+/// history. Input can be pushed in blocks of any size, the output is the same as processing the whole signal at once.
+/// Multichannel signals are interleaved. They are split into one history per channel and every channel shares the
+/// same rows of taps.
+class SincResampler
+{
+  public:
+    /// @brief Maximum number of filter phases. Ratios that need more are approximated.
+    static constexpr size_t kMaxPhaseCount = 1024;
+
+    SincResampler() = default;
+    ~SincResampler() = default;
+
+    /// @brief Initialize the resampler with the `SincQuality::Best` table. Computes the filter bank and clears the
+    /// state.
+    /// @param input_rate The input samplerate.
+    /// @param output_rate The output samplerate.
+    /// @param channels The number of interleaved channels.
+    /// @details If output_rate / input_rate reduces to a fraction with a denominator larger than `kMaxPhaseCount`,
+    /// the closest fraction with at most `kMaxPhaseCount` phases is used instead.
+    void Init(size_t input_rate, size_t output_rate, size_t channels = 1);
+
+    /// @brief Initialize the resampler with a quality tier chosen at runtime. This links every tier, pass
+    /// `GetSincTable<Quality>()` instead to keep only one.
+    /// @param quality The sinc table used to build the filter. Lower tiers give shorter filters.
+    void Init(size_t input_rate, size_t output_rate, size_t channels, SincQuality quality);
+
+    /// @brief Initialize the resampler with a sinc table.
+    /// @param table The sinc table used to build the filter, typically `GetSincTable<Quality>()`. Only read during
+    /// the call.
+    void Init(size_t input_rate, size_t output_rate, size_t channels, const SincTable& table);
+
+    /// @brief Clear the state.
+    void Reset();
+
+    /// @brief Returns the resampling ratio actually used, output rate / input rate.
+    double GetRatio() const;
+
+    /// @brief Returns the number of channels.
+    size_t GetChannelCount() const;
+
+    /// @brief Returns how many input frames the output lags behind. Push that many zeros at the end of a signal to
+    /// get all of its output samples.
+    size_t GetLatency() const;
+
+    /// @brief Returns the maximum number of output frames that `Process` can write for `input_size` frames.
+    size_t GetMaxOutputSize(size_t input_size) const;
+
+    /// @brief Resample a block.
+    /// @param in The interleaved input frames.
+    /// @param input_size The number of input frames.
+    /// @param out The interleaved output buffer. Must hold at least `GetMaxOutputSize(input_size)` frames.
+    /// @return The number of output frames written.
+    size_t Process(const float* in, size_t input_size, float* out);
+
+  private:
+    size_t channels_ = 1;
+    size_t up_ = 1;   // L
+    size_t down_ = 1; // M
+    size_t half_length_ = 0;
+    size_t stride_ = 0;
+    std::vector<float> bank_;
+
+    std::vector<FirHistory> histories_;
+    std::vector<const float*> blocks_;
+    size_t input_count_ = 0;
+    size_t next_index_ = 0;
+    size_t next_phase_ = 0;
+};
+
+/// @brief Streaming windowed sinc resampler with a time-varying ratio, for varispeed and pitch bend.
+/// @details The ratio can be set per block, in which case it glides smoothly to the new value, or given per output
+/// sample. The filter taps are evaluated from the sinc table for every output sample so that the cutoff follows the
+/// ratio continuously: when downsampling, the sinc is stretched to keep the output free of aliasing. Ratios are
+/// clamped to [`kMinRatio`, `kMaxRatio`], which bounds the filter length and the cost of an output sample.
+class VarispeedResampler
+{
+  public:
+    /// @brief Smallest supported ratio. The filter is 1 / kMinRatio times longer than at ratios of 1 and above.
+    static constexpr float kMinRatio = 0.25f;
+
+    /// @brief Largest supported ratio.
+    static constexpr float kMaxRatio = 16.f;
+
+    /// @brief Number of output samples for the ratio to get about 2/3 of the way to a new target.
+    static constexpr float kGlideTime = 64.f;
+
+    VarispeedResampler() = default;
+    ~VarispeedResampler() = default;
+
+    /// @brief Initialize the resampler with the `SincQuality::Best` table. Allocates memory and clears the state.
+    /// @param ratio The initial ratio, output rate / input rate.
+    void Init(float ratio = 1.f);
+
+    /// @brief Initialize the resampler with a quality tier chosen at runtime. This links every tier, pass
+    /// `GetSincTable<Quality>()` instead to keep only one.
+    /// @param quality The sinc table used for the filter. Lower tiers give shorter filters.
+    void Init(float ratio, SincQuality quality);
+
+    /// @brief Initialize the resampler with a sinc table.
+    /// @param table The sinc table used for the filter, typically `GetSincTable<Quality>()`. It is read while
+    /// processing and must outlive the resampler.
+    void Init(float ratio, const SincTable& table);
+
+    /// @brief Clear the state. The ratio jumps to its target.
+    void Reset();
+
+    /// @brief Set the ratio used by `Process` without a ratio buffer. The ratio glides to the new value over about
+    /// `kGlideTime` output samples.
+    void SetRatio(float ratio);
+
+    /// @brief Returns the current, smoothed, ratio.
+    float GetRatio() const;
+
+    /// @brief Resample until the output is full or more input is needed, with the ratio set by `SetRatio`.
+    /// @param in The input samples.
+    /// @param input_size The number of input samples.
+    /// @param[out] input_used The number of input samples consumed. The remaining ones must be passed again.
+    /// @param out The output buffer.
+    /// @param output_size The size of the output buffer.
+    /// @return The number of output samples written.
+    size_t Process(const float* in, size_t input_size, size_t& input_used, float* out, size_t output_size);
+
+    /// @brief Resample until the output is full or more input is needed, with a ratio per output sample.
+    /// @param ratios The ratio of every output sample, `output_size` values.
+    size_t Process(const float* in, size_t input_size, size_t& input_used, float* out, size_t output_size,
+                   const float* ratios);
+
+  private:
+    template <bool Smooth>
+    size_t ProcessImpl(const float* in, size_t input_size, size_t& input_used, float* out, size_t output_size,
+                       const float* ratios);
+
+    size_t max_half_length_ = 0;
+    std::vector<float> weights_;
+    const SincTable* table_ = nullptr;
+    const float* unit_filters_ = nullptr;
+
+    FirHistory history_;
+    const float* block_ = nullptr;
+    size_t block_start_ = 0;
+    size_t input_count_ = 0;
+    double position_ = 0.0;
+
+    float ratio_ = 1.f;
+    float target_ratio_ = 1.f;
+};
+} // namespace sfdsp
@@ -16,7 +16,7 @@ constexpr size_t SAMPLES_PER_CROSSING = 512;
 constexpr size_t sinc_table_size = 16384;
 
 /// @brief Lookup table including one side of a windowed sinc function.
-const float sinc_table[16385] = {
+inline constexpr float sinc_table[16385] = {
     1.0f,
     0.9999937074173879f,
     0.999974829812632f,
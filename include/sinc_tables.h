@@ -0,0 +1,129 @@
+// =============================================================================
+// sinc_tables.h -- Windowed sinc tables of different quality, generated at compile time
+//
+// The tables hold one side of a Kaiser windowed sinc, like the one produced by scripts/make_sinc_table.py.
+// =============================================================================
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace sfdsp
+{
+namespace detail
+{
+/// @brief sin(pi * x) for x in [0, 1].
+constexpr double SinPi(double x)
+{
+    // sin(pi * x) = sin(pi * (1 - x)), the Taylor series then converges in a few terms.
+    const double y = (x > 0.5 ? 1.0 - x : x) * 3.14159265358979323846;
+    const double y2 = y * y;
+    double term = y;
+    double sum = y;
+    for (int k = 1; k < 12; ++k)
+    {
+        term *= -y2 / static_cast<double>((2 * k) * (2 * k + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double Sqrt(double x)
+{
+    if (x <= 0.0)
+    {
+        return 0.0;
+    }
+    double y = x > 1.0 ? x : 1.0;
+    for (int i = 0; i < 64; ++i)
+    {
+        const double next = 0.5 * (y + x / y);
+        if (next >= y)
+        {
+            break;
+        }
+        y = next;
+    }
+    return y;
+}
+
+/// @brief Zeroth order modified Bessel function of the first kind, same series as `BesselI0`.
+constexpr double BesselI0(double x)
+{
+    const double half_x = 0.5 * x;
+    double term = 1.0;
+    double sum = 1.0;
+    for (int k = 1; k < 64 && term > sum * 1e-17; ++k)
+    {
+        const double t = half_x / k;
+        term *= t * t;
+        sum += term;
+    }
+    return sum;
+}
+} // namespace detail
+
+/// @brief Generate one side of a Kaiser windowed sinc, from 0 to `ZeroCount` zero crossings.
+/// @tparam ZeroCount Number of zero crossings on one side of the sinc.
+/// @tparam SamplesPerCrossing Number of samples per zero crossing.
+/// @param kaiser_beta The shape parameter of the Kaiser window.
+/// @return `ZeroCount * SamplesPerCrossing + 1` samples, the last one is zero.
+template <size_t ZeroCount, size_t SamplesPerCrossing>
+constexpr std::array<float, ZeroCount * SamplesPerCrossing + 1> MakeSincTable(double kaiser_beta)
+{
+    constexpr size_t kSize = ZeroCount * SamplesPerCrossing;
+    std::array<float, kSize + 1> table = {1.f};
+    const double window_norm = 1.0 / detail::BesselI0(kaiser_beta);
+    for (size_t i = 1; i <= kSize; ++i)
+    {
+        const size_t crossing = i / SamplesPerCrossing;
+        const double fraction = static_cast<double>(i % SamplesPerCrossing) / SamplesPerCrossing;
+        const double x = static_cast<double>(crossing) + fraction;
+        const double sin_pi_x = (crossing % 2 == 0 ? 1.0 : -1.0) * detail::SinPi(fraction);
+        const double sinc = sin_pi_x / (3.14159265358979323846 * x);
+
+        const double r = static_cast<double>(i) / kSize;
+        const double window = detail::BesselI0(kaiser_beta * detail::Sqrt(1.0 - r * r)) * window_norm;
+        table[i] = static_cast<float>(sinc * window);
+    }
+    return table;
+}
+
+/// @brief Sinc table quality tiers. Shorter tables give shorter filters, cheaper to run and small enough to stay in
+/// cache, at the cost of a wider transition band and less stopband attenuation.
+enum class SincQuality
+{
+    /// @brief 8 zero crossings, 128 samples per crossing, Kaiser beta 6. About 4 KB.
+    Fast,
+    /// @brief 16 zero crossings, 256 samples per crossing, Kaiser beta 8. About 16 KB.
+    Balanced,
+    /// @brief 32 zero crossings, 512 samples per crossing, Kaiser beta 10, the table in sinc_table.h. About 64 KB.
+    Best,
+};
+
+/// @brief A windowed sinc table and its layout.
+struct SincTable
+{
+    /// @brief `size + 1` samples, the last one is zero.
+    const float* values = nullptr;
+    size_t zero_count = 0;
+    size_t samples_per_crossing = 0;
+    size_t size = 0;
+};
+
+/// @brief Returns the table of a quality tier known at compile time.
+/// @details Each tier is a separate function with its own data, so when linking with section garbage collection
+/// (`-ffunction-sections -fdata-sections -Wl,--gc-sections`) only the tiers that are referenced end up in the binary.
+template <SincQuality Quality>
+const SincTable& GetSincTable();
+
+template <>
+const SincTable& GetSincTable<SincQuality::Fast>();
+template <>
+const SincTable& GetSincTable<SincQuality::Balanced>();
+template <>
+const SincTable& GetSincTable<SincQuality::Best>();
+
+/// @brief Returns the table of a quality tier chosen at runtime. References every tier.
+const SincTable& GetSincTable(SincQuality quality);
+} // namespace sfdsp
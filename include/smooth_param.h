@@ -45,6 +45,6 @@ class SmoothParam
     SmoothingType type_;
     float value_;
 
-    OnePoleFilter smoothing_filter_;
+    StaticOnePoleFilter smoothing_filter_;
 };
 } // namespace sfdsp
\ No newline at end of file
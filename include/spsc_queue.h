@@ -0,0 +1,85 @@
+/// @file
+/// Lock-free single producer, single consumer queue
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace sfdsp
+{
+
+/// @brief Fixed capacity, lock-free queue between one producer thread and one consumer thread.
+/// @details Neither side allocates, locks or waits: `TryPush` fails when the queue is full and `TryPop` when it is
+/// empty. Typical use is sending events from a control or MIDI thread to the audio thread.
+/// @tparam T The element type, copied in and out of the queue.
+/// @tparam Capacity The maximum number of elements in the queue, a power of two.
+template <class T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+  public:
+    SpscQueue() = default;
+    ~SpscQueue() = default;
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /// @brief Adds an element at the back of the queue. Producer thread only.
+    /// @param value The element
+    /// @return False if the queue is full, the element is then dropped.
+    bool TryPush(const T& value);
+
+    /// @brief Removes the element at the front of the queue. Consumer thread only.
+    /// @param value Receives the element
+    /// @return False if the queue is empty.
+    bool TryPop(T& value);
+
+    /// @brief Returns true if the queue is empty. Exact on the consumer thread, a hint anywhere else.
+    bool IsEmpty() const;
+
+  private:
+    static constexpr size_t kMask = Capacity - 1;
+
+    std::array<T, Capacity> buffer_ = {};
+
+    // The indices only ever increase and are masked on access. Each is written by one thread and lives on its own
+    // cache line, so that the producer and the consumer do not invalidate each other's line on every access.
+    alignas(64) std::atomic<size_t> write_index_ = 0;
+    alignas(64) std::atomic<size_t> read_index_ = 0;
+};
+
+template <class T, size_t Capacity>
+bool SpscQueue<T, Capacity>::TryPush(const T& value)
+{
+    const size_t write = write_index_.load(std::memory_order_relaxed);
+    if (write - read_index_.load(std::memory_order_acquire) == Capacity)
+    {
+        return false;
+    }
+    buffer_[write & kMask] = value;
+    write_index_.store(write + 1, std::memory_order_release);
+    return true;
+}
+
+template <class T, size_t Capacity>
+bool SpscQueue<T, Capacity>::TryPop(T& value)
+{
+    const size_t read = read_index_.load(std::memory_order_relaxed);
+    if (read == write_index_.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+    value = buffer_[read & kMask];
+    read_index_.store(read + 1, std::memory_order_release);
+    return true;
+}
+
+template <class T, size_t Capacity>
+bool SpscQueue<T, Capacity>::IsEmpty() const
+{
+    return read_index_.load(std::memory_order_acquire) == write_index_.load(std::memory_order_acquire);
+}
+
+} // namespace sfdsp
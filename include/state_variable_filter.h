@@ -0,0 +1,90 @@
+// =============================================================================
+// state_variable_filter.h -- Topology-preserving transform state variable filter
+//
+// Based on:
+// V. Zavalishin, "The Art of VA Filter Design", rev. 2.1.0, 2018, chapter 4.
+// A. Simper, "Linear Trapezoidal Integrated State Variable Filter With Low Noise Optimisation", 2014.
+// =============================================================================
+#pragma once
+
+#include <cstddef>
+
+namespace sfdsp
+{
+
+/// @brief Trapezoidal (TPT) state variable filter with simultaneous lowpass, bandpass and highpass outputs.
+/// @details Unlike the direct form `Biquad`, the TPT structure stays stable and free of zipper noise when the cutoff
+/// is modulated at audio rate. The bilinear prewarping tan() is read from a lookup table so that the per-sample
+/// cutoff API does not need any trigonometric function call.
+class StateVariableFilter
+{
+  public:
+    StateVariableFilter() = default;
+    ~StateVariableFilter() = default;
+
+    /// @brief Initialize the filter.
+    /// @param samplerate The samplerate of the system.
+    void Init(float samplerate);
+
+    /// @brief Set the cutoff frequency.
+    /// @param freq The cutoff frequency in Hz. Clamped to 0.49 * samplerate.
+    void SetCutoff(float freq);
+
+    /// @brief Returns the cutoff frequency in Hz.
+    float GetCutoff() const;
+
+    /// @brief Set the resonance of the filter.
+    /// @param q The quality factor. 0.5 gives a critically damped filter and 1/sqrt(2) a Butterworth response.
+    void SetQ(float q);
+
+    /// @brief Clear the filter state.
+    void Reset();
+
+    /// @brief Filter one sample.
+    /// @param in The input sample.
+    /// @param lp The lowpass output.
+    /// @param bp The bandpass output.
+    /// @param hp The highpass output.
+    void Tick(float in, float& lp, float& bp, float& hp);
+
+    /// @brief Filter one sample and return the lowpass output.
+    /// @param in The input sample.
+    /// @return The lowpass output.
+    float Tick(float in);
+
+    /// @brief Filter a block of samples with the current cutoff.
+    /// @param in The input buffer.
+    /// @param lp The lowpass output buffer. Can be nullptr.
+    /// @param bp The bandpass output buffer. Can be nullptr.
+    /// @param hp The highpass output buffer. Can be nullptr.
+    /// @param size The size of the buffers.
+    /// @note Any output buffer can be the same as `in`.
+    void ProcessBlock(const float* in, float* lp, float* bp, float* hp, size_t size);
+
+    /// @brief Filter a block of samples with a per-sample cutoff.
+    /// @param in The input buffer.
+    /// @param cutoff The cutoff frequency in Hz for each sample. The last value becomes the filter cutoff.
+    /// @param lp The lowpass output buffer. Can be nullptr.
+    /// @param bp The bandpass output buffer. Can be nullptr.
+    /// @param hp The highpass output buffer. Can be nullptr.
+    /// @param size The size of the buffers.
+    /// @note Any output buffer can be the same as `in`.
+    void ProcessBlock(const float* in, const float* cutoff, float* lp, float* bp, float* hp, size_t size);
+
+  private:
+    void UpdateCoefficients();
+
+    float samplerate_ = 48000.f;
+    float inv_samplerate_ = 1.f / 48000.f;
+    float cutoff_ = 1000.f;
+
+    float g_ = 0.f;
+    float k_ = 1.4142135f;
+    float a1_ = 0.f;
+    float a2_ = 0.f;
+    float a3_ = 0.f;
+
+    float ic1eq_ = 0.f;
+    float ic2eq_ = 0.f;
+};
+} // namespace sfdsp
@@ -41,8 +41,15 @@ class StringEnsemble
     /// @brief Process and return block of samples.
     /// @param out The output buffer where the processed samples will be written.
     /// @param size The size of the output buffer.
+    /// @note Almost nothing is computed while the ensemble is silent, see `IsSilent()`.
     void ProcessBlock(float* out, size_t size);
 
+    /// @brief Returns true if every string is silent.
+    /// @details While the ensemble is silent, `ProcessBlock()` skips the bridge coupling and only runs the parameter
+    /// smoothing of each string.
+    /// @return True if every string is silent.
+    bool IsSilent() const;
+
     /// @brief Subscript operator to access each individual string
     /// @param string_number The string number to access. Between 0 and `kStringCount-1`
     /// @return A reference to the string object.
@@ -72,7 +79,7 @@ class StringEnsemble
     std::array<float, kStringCount> openTuning_;
     float bridgeTransmission_ = 0.0f;
 
-    OnePoleFilter transmission_filter_;
-    std::array<Biquad, 6> body_filters_;
+    StaticOnePoleFilter transmission_filter_;
+    std::array<StaticBiquad, 6> body_filters_;
 };
 } // namespace sfdsp
\ No newline at end of file
@@ -0,0 +1,185 @@
+// Auto-generated file from make_tan_table.py
+#pragma once
+
+#include <array>
+
+namespace sfdsp
+{
+/// @brief Size of the tan lookup table.
+constexpr size_t TAN_LUT_SIZE = 1024;
+
+/// @brief tan(pi * f) lookup table for normalized frequencies f between 0 and 0.5.
+const std::array<float, TAN_LUT_SIZE + 1> tan_lut = {
+    0.00000000e+00f, 1.53398199e-03f, 3.06797120e-03f, 4.60197485e-03f, 6.13600016e-03f, 7.67005434e-03f,
+    9.20414463e-03f, 1.07382782e-02f, 1.22724624e-02f, 1.38067043e-02f, 1.53410112e-02f, 1.68753903e-02f,
+    1.84098489e-02f, 1.99443941e-02f, 2.14790332e-02f, 2.30137735e-02f, 2.45486221e-02f, 2.60835863e-02f,
+    2.76186734e-02f, 2.91538905e-02f, 3.06892450e-02f, 3.22247440e-02f, 3.37603949e-02f, 3.52962048e-02f,
+    3.68321810e-02f, 3.83683308e-02f, 3.99046614e-02f, 4.14411802e-02f, 4.29778943e-02f, 4.45148110e-02f,
+    4.60519376e-02f, 4.75892815e-02f, 4.91268498e-02f, 5.06646498e-02f, 5.22026889e-02f, 5.37409744e-02f,
+    5.52795135e-02f, 5.68183136e-02f, 5.83573819e-02f, 5.98967258e-02f, 6.14363526e-02f, 6.29762696e-02f,
+    6.45164842e-02f, 6.60570036e-02f, 6.75978353e-02f, 6.91389866e-02f, 7.06804648e-02f, 7.22222773e-02f,
+    7.37644315e-02f, 7.53069347e-02f, 7.68497944e-02f, 7.83930178e-02f, 7.99366125e-02f, 8.14805857e-02f,
+    8.30249450e-02f, 8.45696977e-02f, 8.61148512e-02f, 8.76604130e-02f, 8.92063905e-02f, 9.07527912e-02f,
+    9.22996225e-02f, 9.38468919e-02f, 9.53946069e-02f, 9.69427749e-02f, 9.84914034e-02f, 1.00040500e-01f,
+    1.01590072e-01f, 1.03140127e-01f, 1.04690673e-01f, 1.06241716e-01f, 1.07793266e-01f, 1.09345328e-01f,
+    1.10897912e-01f, 1.12451023e-01f, 1.14004671e-01f, 1.15558862e-01f, 1.17113604e-01f, 1.18668905e-01f,
+    1.20224772e-01f, 1.21781213e-01f, 1.23338236e-01f, 1.24895848e-01f, 1.26454057e-01f, 1.28012871e-01f,
+    1.29572297e-01f, 1.31132343e-01f, 1.32693017e-01f, 1.34254326e-01f, 1.35816279e-01f, 1.37378882e-01f,
+    1.38942144e-01f, 1.40506073e-01f, 1.42070676e-01f, 1.43635961e-01f, 1.45201936e-01f, 1.46768609e-01f,
+    1.48335988e-01f, 1.49904079e-01f, 1.51472893e-01f, 1.53042435e-01f, 1.54612715e-01f, 1.56183739e-01f,
+    1.57755517e-01f, 1.59328055e-01f, 1.60901362e-01f, 1.62475447e-01f, 1.64050316e-01f, 1.65625977e-01f,
+    1.67202440e-01f, 1.68779712e-01f, 1.70357800e-01f, 1.71936714e-01f, 1.73516460e-01f, 1.75097048e-01f,
+    1.76678485e-01f, 1.78260779e-01f, 1.79843940e-01f, 1.81427973e-01f, 1.83012889e-01f, 1.84598695e-01f,
+    1.86185400e-01f, 1.87773010e-01f, 1.89361536e-01f, 1.90950985e-01f, 1.92541365e-01f, 1.94132685e-01f,
+    1.95724954e-01f, 1.97318178e-01f, 1.98912367e-01f, 2.00507530e-01f, 2.02103674e-01f, 2.03700808e-01f,
+    2.05298940e-01f, 2.06898080e-01f, 2.08498234e-01f, 2.10099413e-01f, 2.11701624e-01f, 2.13304876e-01f,
+    2.14909178e-01f, 2.16514537e-01f, 2.18120964e-01f, 2.19728465e-01f, 2.21337051e-01f, 2.22946729e-01f,
+    2.24557509e-01f, 2.26169399e-01f, 2.27782408e-01f, 2.29396544e-01f, 2.31011817e-01f, 2.32628235e-01f,
+    2.34245807e-01f, 2.35864542e-01f, 2.37484449e-01f, 2.39105536e-01f, 2.40727813e-01f, 2.42351289e-01f,
+    2.43975972e-01f, 2.45601872e-01f, 2.47228997e-01f, 2.48857357e-01f, 2.50486960e-01f, 2.52117817e-01f,
+    2.53749935e-01f, 2.55383324e-01f, 2.57017994e-01f, 2.58653953e-01f, 2.60291211e-01f, 2.61929777e-01f,
+    2.63569660e-01f, 2.65210870e-01f, 2.66853415e-01f, 2.68497306e-01f, 2.70142552e-01f, 2.71789161e-01f,
+    2.73437145e-01f, 2.75086511e-01f, 2.76737270e-01f, 2.78389431e-01f, 2.80043004e-01f, 2.81697998e-01f,
+    2.83354423e-01f, 2.85012289e-01f, 2.86671605e-01f, 2.88332380e-01f, 2.89994626e-01f, 2.91658351e-01f,
+    2.93323566e-01f, 2.94990280e-01f, 2.96658503e-01f, 2.98328244e-01f, 2.99999515e-01f, 3.01672325e-01f,
+    3.03346684e-01f, 3.05022601e-01f, 3.06700088e-01f, 3.08379154e-01f, 3.10059809e-01f, 3.11742064e-01f,
+    3.13425928e-01f, 3.15111412e-01f, 3.16798527e-01f, 3.18487282e-01f, 3.20177688e-01f, 3.21869755e-01f,
+    3.23563494e-01f, 3.25258916e-01f, 3.26956029e-01f, 3.28654846e-01f, 3.30355377e-01f, 3.32057633e-01f,
+    3.33761623e-01f, 3.35467359e-01f, 3.37174851e-01f, 3.38884111e-01f, 3.40595149e-01f, 3.42307975e-01f,
+    3.44022602e-01f, 3.45739039e-01f, 3.47457297e-01f, 3.49177388e-01f, 3.50899323e-01f, 3.52623113e-01f,
+    3.54348768e-01f, 3.56076301e-01f, 3.57805721e-01f, 3.59537042e-01f, 3.61270272e-01f, 3.63005426e-01f,
+    3.64742512e-01f, 3.66481544e-01f, 3.68222532e-01f, 3.69965487e-01f, 3.71710423e-01f, 3.73457349e-01f,
+    3.75206278e-01f, 3.76957221e-01f, 3.78710191e-01f, 3.80465198e-01f, 3.82222255e-01f, 3.83981374e-01f,
+    3.85742566e-01f, 3.87505844e-01f, 3.89271219e-01f, 3.91038704e-01f, 3.92808311e-01f, 3.94580051e-01f,
+    3.96353938e-01f, 3.98129983e-01f, 3.99908199e-01f, 4.01688597e-01f, 4.03471191e-01f, 4.05255993e-01f,
+    4.07043016e-01f, 4.08832271e-01f, 4.10623772e-01f, 4.12417532e-01f, 4.14213562e-01f, 4.16011877e-01f,
+    4.17812488e-01f, 4.19615408e-01f, 4.21420651e-01f, 4.23228230e-01f, 4.25038157e-01f, 4.26850446e-01f,
+    4.28665110e-01f, 4.30482162e-01f, 4.32301615e-01f, 4.34123483e-01f, 4.35947779e-01f, 4.37774516e-01f,
+    4.39603709e-01f, 4.41435370e-01f, 4.43269514e-01f, 4.45106154e-01f, 4.46945303e-01f, 4.48786976e-01f,
+    4.50631187e-01f, 4.52477949e-01f, 4.54327276e-01f, 4.56179183e-01f, 4.58033683e-01f, 4.59890792e-01f,
+    4.61750522e-01f, 4.63612889e-01f, 4.65477907e-01f, 4.67345590e-01f, 4.69215952e-01f, 4.71089010e-01f,
+    4.72964776e-01f, 4.74843266e-01f, 4.76724495e-01f, 4.78608477e-01f, 4.80495227e-01f, 4.82384761e-01f,
+    4.84277093e-01f, 4.86172239e-01f, 4.88070214e-01f, 4.89971033e-01f, 4.91874711e-01f, 4.93781264e-01f,
+    4.95690708e-01f, 4.97603058e-01f, 4.99518329e-01f, 5.01436538e-01f, 5.03357700e-01f, 5.05281831e-01f,
+    5.07208947e-01f, 5.09139064e-01f, 5.11072199e-01f, 5.13008367e-01f, 5.14947585e-01f, 5.16889869e-01f,
+    5.18835235e-01f, 5.20783700e-01f, 5.22735281e-01f, 5.24689995e-01f, 5.26647857e-01f, 5.28608885e-01f,
+    5.30573097e-01f, 5.32540508e-01f, 5.34511136e-01f, 5.36484998e-01f, 5.38462112e-01f, 5.40442495e-01f,
+    5.42426164e-01f, 5.44413137e-01f, 5.46403431e-01f, 5.48397065e-01f, 5.50394056e-01f, 5.52394421e-01f,
+    5.54398180e-01f, 5.56405349e-01f, 5.58415948e-01f, 5.60429994e-01f, 5.62447507e-01f, 5.64468503e-01f,
+    5.66493003e-01f, 5.68521024e-01f, 5.70552585e-01f, 5.72587706e-01f, 5.74626405e-01f, 5.76668701e-01f,
+    5.78714614e-01f, 5.80764162e-01f, 5.82817365e-01f, 5.84874243e-01f, 5.86934815e-01f, 5.88999101e-01f,
+    5.91067120e-01f, 5.93138893e-01f, 5.95214440e-01f, 5.97293780e-01f, 5.99376934e-01f, 6.01463922e-01f,
+    6.03554764e-01f, 6.05649482e-01f, 6.07748096e-01f, 6.09850626e-01f, 6.11957094e-01f, 6.14067520e-01f,
+    6.16181926e-01f, 6.18300333e-01f, 6.20422762e-01f, 6.22549235e-01f, 6.24679773e-01f, 6.26814399e-01f,
+    6.28953133e-01f, 6.31095998e-01f, 6.33243016e-01f, 6.35394210e-01f, 6.37549600e-01f, 6.39709211e-01f,
+    6.41873065e-01f, 6.44041184e-01f, 6.46213591e-01f, 6.48390309e-01f, 6.50571362e-01f, 6.52756772e-01f,
+    6.54946564e-01f, 6.57140759e-01f, 6.59339383e-01f, 6.61542459e-01f, 6.63750011e-01f, 6.65962062e-01f,
+    6.68178638e-01f, 6.70399762e-01f, 6.72625460e-01f, 6.74855755e-01f, 6.77090672e-01f, 6.79330237e-01f,
+    6.81574474e-01f, 6.83823409e-01f, 6.86077068e-01f, 6.88335474e-01f, 6.90598655e-01f, 6.92866637e-01f,
+    6.95139444e-01f, 6.97417104e-01f, 6.99699642e-01f, 7.01987086e-01f, 7.04279461e-01f, 7.06576795e-01f,
+    7.08879114e-01f, 7.11186445e-01f, 7.13498817e-01f, 7.15816256e-01f, 7.18138789e-01f, 7.20466446e-01f,
+    7.22799253e-01f, 7.25137239e-01f, 7.27480432e-01f, 7.29828860e-01f, 7.32182553e-01f, 7.34541539e-01f,
+    7.36905847e-01f, 7.39275506e-01f, 7.41650546e-01f, 7.44030996e-01f, 7.46416886e-01f, 7.48808246e-01f,
+    7.51205106e-01f, 7.53607497e-01f, 7.56015448e-01f, 7.58428991e-01f, 7.60848156e-01f, 7.63272975e-01f,
+    7.65703478e-01f, 7.68139698e-01f, 7.70581666e-01f, 7.73029414e-01f, 7.75482974e-01f, 7.77942378e-01f,
+    7.80407660e-01f, 7.82878850e-01f, 7.85355984e-01f, 7.87839093e-01f, 7.90328211e-01f, 7.92823372e-01f,
+    7.95324609e-01f, 7.97831957e-01f, 8.00345449e-01f, 8.02865121e-01f, 8.05391007e-01f, 8.07923142e-01f,
+    8.10461561e-01f, 8.13006300e-01f, 8.15557394e-01f, 8.18114879e-01f, 8.20678791e-01f, 8.23249167e-01f,
+    8.25826042e-01f, 8.28409455e-01f, 8.30999443e-01f, 8.33596041e-01f, 8.36199289e-01f, 8.38809224e-01f,
+    8.41425884e-01f, 8.44049308e-01f, 8.46679533e-01f, 8.49316600e-01f, 8.51960547e-01f, 8.54611414e-01f,
+    8.57269241e-01f, 8.59934067e-01f, 8.62605932e-01f, 8.65284878e-01f, 8.67970945e-01f, 8.70664175e-01f,
+    8.73364608e-01f, 8.76072286e-01f, 8.78787252e-01f, 8.81509547e-01f, 8.84239215e-01f, 8.86976298e-01f,
+    8.89720839e-01f, 8.92472882e-01f, 8.95232471e-01f, 8.97999649e-01f, 9.00774462e-01f, 9.03556954e-01f,
+    9.06347169e-01f, 9.09145154e-01f, 9.11950954e-01f, 9.14764615e-01f, 9.17586184e-01f, 9.20415707e-01f,
+    9.23253231e-01f, 9.26098804e-01f, 9.28952473e-01f, 9.31814287e-01f, 9.34684294e-01f, 9.37562543e-01f,
+    9.40449083e-01f, 9.43343963e-01f, 9.46247233e-01f, 9.49158944e-01f, 9.52079147e-01f, 9.55007891e-01f,
+    9.57945229e-01f, 9.60891213e-01f, 9.63845894e-01f, 9.66809325e-01f, 9.69781559e-01f, 9.72762649e-01f,
+    9.75752650e-01f, 9.78751615e-01f, 9.81759598e-01f, 9.84776655e-01f, 9.87802841e-01f, 9.90838213e-01f,
+    9.93882825e-01f, 9.96936735e-01f, 1.00000000e+00f, 1.00307268e+00f, 1.00615483e+00f, 1.00924650e+00f,
+    1.01234777e+00f, 1.01545868e+00f, 1.01857930e+00f, 1.02170968e+00f, 1.02484989e+00f, 1.02800000e+00f,
+    1.03116005e+00f, 1.03433011e+00f, 1.03751026e+00f, 1.04070054e+00f, 1.04390102e+00f, 1.04711177e+00f,
+    1.05033285e+00f, 1.05356432e+00f, 1.05680626e+00f, 1.06005873e+00f, 1.06332179e+00f, 1.06659551e+00f,
+    1.06987996e+00f, 1.07317522e+00f, 1.07648134e+00f, 1.07979839e+00f, 1.08312646e+00f, 1.08646560e+00f,
+    1.08981589e+00f, 1.09317740e+00f, 1.09655020e+00f, 1.09993437e+00f, 1.10332998e+00f, 1.10673710e+00f,
+    1.11015581e+00f, 1.11358618e+00f, 1.11702829e+00f, 1.12048222e+00f, 1.12394805e+00f, 1.12742584e+00f,
+    1.13091569e+00f, 1.13441766e+00f, 1.13793185e+00f, 1.14145832e+00f, 1.14499717e+00f, 1.14854846e+00f,
+    1.15211230e+00f, 1.15568875e+00f, 1.15927791e+00f, 1.16287985e+00f, 1.16649467e+00f, 1.17012245e+00f,
+    1.17376327e+00f, 1.17741723e+00f, 1.18108441e+00f, 1.18476491e+00f, 1.18845880e+00f, 1.19216619e+00f,
+    1.19588717e+00f, 1.19962182e+00f, 1.20337024e+00f, 1.20713253e+00f, 1.21090877e+00f, 1.21469907e+00f,
+    1.21850353e+00f, 1.22232223e+00f, 1.22615527e+00f, 1.23000277e+00f, 1.23386481e+00f, 1.23774150e+00f,
+    1.24163293e+00f, 1.24553922e+00f, 1.24946047e+00f, 1.25339677e+00f, 1.25734824e+00f, 1.26131499e+00f,
+    1.26529711e+00f, 1.26929472e+00f, 1.27330793e+00f, 1.27733684e+00f, 1.28138158e+00f, 1.28544225e+00f,
+    1.28951896e+00f, 1.29361184e+00f, 1.29772099e+00f, 1.30184653e+00f, 1.30598858e+00f, 1.31014726e+00f,
+    1.31432270e+00f, 1.31851500e+00f, 1.32272429e+00f, 1.32695071e+00f, 1.33119436e+00f, 1.33545538e+00f,
+    1.33973389e+00f, 1.34403003e+00f, 1.34834391e+00f, 1.35267568e+00f, 1.35702547e+00f, 1.36139340e+00f,
+    1.36577961e+00f, 1.37018424e+00f, 1.37460742e+00f, 1.37904930e+00f, 1.38351001e+00f, 1.38798969e+00f,
+    1.39248849e+00f, 1.39700655e+00f, 1.40154402e+00f, 1.40610104e+00f, 1.41067776e+00f, 1.41527433e+00f,
+    1.41989090e+00f, 1.42452763e+00f, 1.42918467e+00f, 1.43386217e+00f, 1.43856029e+00f, 1.44327919e+00f,
+    1.44801904e+00f, 1.45277998e+00f, 1.45756220e+00f, 1.46236585e+00f, 1.46719110e+00f, 1.47203811e+00f,
+    1.47690707e+00f, 1.48179814e+00f, 1.48671149e+00f, 1.49164731e+00f, 1.49660576e+00f, 1.50158704e+00f,
+    1.50659131e+00f, 1.51161877e+00f, 1.51666960e+00f, 1.52174399e+00f, 1.52684212e+00f, 1.53196419e+00f,
+    1.53711039e+00f, 1.54228092e+00f, 1.54747596e+00f, 1.55269574e+00f, 1.55794043e+00f, 1.56321026e+00f,
+    1.56850541e+00f, 1.57382611e+00f, 1.57917257e+00f, 1.58454499e+00f, 1.58994359e+00f, 1.59536858e+00f,
+    1.60082020e+00f, 1.60629866e+00f, 1.61180418e+00f, 1.61733699e+00f, 1.62289733e+00f, 1.62848541e+00f,
+    1.63410149e+00f, 1.63974580e+00f, 1.64541857e+00f, 1.65112004e+00f, 1.65685048e+00f, 1.66261011e+00f,
+    1.66839921e+00f, 1.67421800e+00f, 1.68006677e+00f, 1.68594576e+00f, 1.69185523e+00f, 1.69779546e+00f,
+    1.70376671e+00f, 1.70976926e+00f, 1.71580337e+00f, 1.72186933e+00f, 1.72796742e+00f, 1.73409793e+00f,
+    1.74026114e+00f, 1.74645734e+00f, 1.75268683e+00f, 1.75894990e+00f, 1.76524687e+00f, 1.77157803e+00f,
+    1.77794370e+00f, 1.78434418e+00f, 1.79077980e+00f, 1.79725087e+00f, 1.80375773e+00f, 1.81030069e+00f,
+    1.81688009e+00f, 1.82349627e+00f, 1.83014956e+00f, 1.83684032e+00f, 1.84356889e+00f, 1.85033562e+00f,
+    1.85714088e+00f, 1.86398502e+00f, 1.87086841e+00f, 1.87779143e+00f, 1.88475444e+00f, 1.89175783e+00f,
+    1.89880199e+00f, 1.90588731e+00f, 1.91301417e+00f, 1.92018298e+00f, 1.92739416e+00f, 1.93464810e+00f,
+    1.94194522e+00f, 1.94928595e+00f, 1.95667070e+00f, 1.96409993e+00f, 1.97157405e+00f, 1.97909353e+00f,
+    1.98665879e+00f, 1.99427031e+00f, 2.00192854e+00f, 2.00963395e+00f, 2.01738702e+00f, 2.02518822e+00f,
+    2.03303804e+00f, 2.04093698e+00f, 2.04888553e+00f, 2.05688421e+00f, 2.06493351e+00f, 2.07303398e+00f,
+    2.08118613e+00f, 2.08939049e+00f, 2.09764762e+00f, 2.10595805e+00f, 2.11432236e+00f, 2.12274109e+00f,
+    2.13121484e+00f, 2.13974417e+00f, 2.14832967e+00f, 2.15697196e+00f, 2.16567162e+00f, 2.17442927e+00f,
+    2.18324555e+00f, 2.19212107e+00f, 2.20105649e+00f, 2.21005245e+00f, 2.21910962e+00f, 2.22822865e+00f,
+    2.23741025e+00f, 2.24665508e+00f, 2.25596385e+00f, 2.26533728e+00f, 2.27477608e+00f, 2.28428098e+00f,
+    2.29385273e+00f, 2.30349207e+00f, 2.31319978e+00f, 2.32297663e+00f, 2.33282340e+00f, 2.34274090e+00f,
+    2.35272994e+00f, 2.36279135e+00f, 2.37292595e+00f, 2.38313460e+00f, 2.39341817e+00f, 2.40377753e+00f,
+    2.41421356e+00f, 2.42472718e+00f, 2.43531930e+00f, 2.44599086e+00f, 2.45674280e+00f, 2.46757609e+00f,
+    2.47849170e+00f, 2.48949063e+00f, 2.50057389e+00f, 2.51174250e+00f, 2.52299751e+00f, 2.53433998e+00f,
+    2.54577098e+00f, 2.55729162e+00f, 2.56890299e+00f, 2.58060624e+00f, 2.59240252e+00f, 2.60429299e+00f,
+    2.61627884e+00f, 2.62836129e+00f, 2.64054157e+00f, 2.65282091e+00f, 2.66520061e+00f, 2.67768194e+00f,
+    2.69026624e+00f, 2.70295483e+00f, 2.71574908e+00f, 2.72865037e+00f, 2.74166012e+00f, 2.75477976e+00f,
+    2.76801076e+00f, 2.78135459e+00f, 2.79481277e+00f, 2.80838685e+00f, 2.82207839e+00f, 2.83588898e+00f,
+    2.84982026e+00f, 2.86387387e+00f, 2.87805151e+00f, 2.89235489e+00f, 2.90678576e+00f, 2.92134590e+00f,
+    2.93603712e+00f, 2.95086127e+00f, 2.96582024e+00f, 2.98091595e+00f, 2.99615034e+00f, 3.01152542e+00f,
+    3.02704320e+00f, 3.04270578e+00f, 3.05851524e+00f, 3.07447376e+00f, 3.09058351e+00f, 3.10684674e+00f,
+    3.12326573e+00f, 3.13984280e+00f, 3.15658033e+00f, 3.17348075e+00f, 3.19054651e+00f, 3.20778014e+00f,
+    3.22518421e+00f, 3.24276135e+00f, 3.26051423e+00f, 3.27844558e+00f, 3.29655821e+00f, 3.31485495e+00f,
+    3.33333872e+00f, 3.35201249e+00f, 3.37087928e+00f, 3.38994221e+00f, 3.40920443e+00f, 3.42866918e+00f,
+    3.44833976e+00f, 3.46821955e+00f, 3.48831201e+00f, 3.50862064e+00f, 3.52914907e+00f, 3.54990098e+00f,
+    3.57088014e+00f, 3.59209039e+00f, 3.61353568e+00f, 3.63522005e+00f, 3.65714761e+00f, 3.67932258e+00f,
+    3.70174929e+00f, 3.72443215e+00f, 3.74737569e+00f, 3.77058452e+00f, 3.79406340e+00f, 3.81781717e+00f,
+    3.84185081e+00f, 3.86616941e+00f, 3.89077817e+00f, 3.91568245e+00f, 3.94088771e+00f, 3.96639957e+00f,
+    3.99222378e+00f, 4.01836624e+00f, 4.04483298e+00f, 4.07163021e+00f, 4.09876429e+00f, 4.12624173e+00f,
+    4.15406922e+00f, 4.18225364e+00f, 4.21080203e+00f, 4.23972163e+00f, 4.26901985e+00f, 4.29870432e+00f,
+    4.32878288e+00f, 4.35926357e+00f, 4.39015466e+00f, 4.42146463e+00f, 4.45320222e+00f, 4.48537640e+00f,
+    4.51799640e+00f, 4.55107170e+00f, 4.58461206e+00f, 4.61862752e+00f, 4.65312841e+00f, 4.68812537e+00f,
+    4.72362933e+00f, 4.75965157e+00f, 4.79620369e+00f, 4.83329764e+00f, 4.87094575e+00f, 4.90916070e+00f,
+    4.94795558e+00f, 4.98734387e+00f, 5.02733949e+00f, 5.06795679e+00f, 5.10921056e+00f, 5.15111609e+00f,
+    5.19368915e+00f, 5.23694601e+00f, 5.28090350e+00f, 5.32557899e+00f, 5.37099044e+00f, 5.41715638e+00f,
+    5.46409602e+00f, 5.51182919e+00f, 5.56037641e+00f, 5.60975893e+00f, 5.65999873e+00f, 5.71111856e+00f,
+    5.76314201e+00f, 5.81609349e+00f, 5.86999832e+00f, 5.92488274e+00f, 5.98077396e+00f, 6.03770022e+00f,
+    6.09569080e+00f, 6.15477613e+00f, 6.21498777e+00f, 6.27635854e+00f, 6.33892254e+00f, 6.40271520e+00f,
+    6.46777338e+00f, 6.53413545e+00f, 6.60184131e+00f, 6.67093253e+00f, 6.74145241e+00f, 6.81344605e+00f,
+    6.88696050e+00f, 6.96204482e+00f, 7.03875020e+00f, 7.11713009e+00f, 7.19724029e+00f, 7.27913915e+00f,
+    7.36288764e+00f, 7.44854954e+00f, 7.53619160e+00f, 7.62588372e+00f, 7.71769910e+00f, 7.81171449e+00f,
+    7.90801040e+00f, 8.00667127e+00f, 8.10778580e+00f, 8.21144718e+00f, 8.31775334e+00f, 8.42680735e+00f,
+    8.53871767e+00f, 8.65359856e+00f, 8.77157044e+00f, 8.89276034e+00f, 9.01730236e+00f, 9.14533813e+00f,
+    9.27701738e+00f, 9.41249854e+00f, 9.55194933e+00f, 9.69554750e+00f, 9.84348156e+00f, 9.99595165e+00f,
+    1.01531704e+01f, 1.03153639e+01f, 1.04827729e+01f, 1.06556539e+01f, 1.08342805e+01f, 1.10189448e+01f,
+    1.12099592e+01f, 1.14076579e+01f, 1.16123989e+01f, 1.18245663e+01f, 1.20445729e+01f, 1.22728622e+01f,
+    1.25099122e+01f, 1.27562381e+01f, 1.30123966e+01f, 1.32789896e+01f, 1.35566692e+01f, 1.38461433e+01f,
+    1.41481809e+01f, 1.44636196e+01f, 1.47933731e+01f, 1.51384402e+01f, 1.54999147e+01f, 1.58789971e+01f,
+    1.62770080e+01f, 1.66954034e+01f, 1.71357927e+01f, 1.75999592e+01f, 1.80898842e+01f, 1.86077757e+01f,
+    1.91561013e+01f, 1.97376278e+01f, 2.03554676e+01f, 2.10131351e+01f, 2.17146129e+01f, 2.24644332e+01f,
+    2.32677756e+01f, 2.41305869e+01f, 2.50597290e+01f, 2.60631614e+01f, 2.71501707e+01f, 2.83316579e+01f,
+    2.96205066e+01f, 3.10320541e+01f, 3.25847052e+01f, 3.43007393e+01f, 3.62073871e+01f, 3.83382863e+01f,
+    4.07354839e+01f, 4.34522396e+01f, 4.65570303e+01f, 5.01394023e+01f, 5.43187512e+01f, 5.92578887e+01f,
+    6.51847513e+01f, 7.24285810e+01f, 8.14832402e+01f, 9.31247988e+01f, 1.08646707e+02f, 1.30377173e+02f,
+    1.62972616e+02f, 2.17298015e+02f, 3.25948301e+02f, 6.51898136e+02f, 3.18309876e+03f,
+};
+} // namespace sfdsp
@@ -9,33 +9,64 @@ namespace sfdsp
 {
 /// @brief Base class for termination points between two delaylines
 /// @note For now, a termination is simply a gain and a filter and the class mostly exists for readability.
+/// @tparam FilterT Type of the optional filter. Defaults to the virtual `Filter` interface. Use one of the `Static*`
+/// filters to have the filter inlined in `Tick()`.
+template <FilterType FilterT = Filter>
 class Termination
 {
   public:
     /// @brief Construct a new Termination object.
     /// @param gain Gain of the termination. Defaults the -1.
     Termination(float gain = -1.f);
-    virtual ~Termination() = default;
+    ~Termination() = default;
 
     /// @brief Set the gain of the termination.
     /// @param gain
-    virtual void SetGain(float gain);
+    void SetGain(float gain);
 
     /// @brief Set the filter of the termination.
     /// @param filter Filter to set.
-    virtual void SetFilter(Filter* filter);
+    void SetFilter(FilterT* filter);
 
     /// @brief Tick the termination.
     /// @param in Input sample.
     /// @return Output sample.
     /// @note If a filter is set, the input sample will be filtered before being multiplied by the gain.
-    virtual float Tick(float in);
+    float Tick(float in);
 
   protected:
     /// @brief The gain of the termination.
     float gain_ = -1.f;
 
     /// @brief Optional filter used to filter signals coming through the termination.
-    Filter* filter_ = nullptr;
+    FilterT* filter_ = nullptr;
 };
-} // namespace sfdsp
\ No newline at end of file
+
+template <FilterType FilterT>
+Termination<FilterT>::Termination(float gain) : gain_(gain)
+{
+}
+
+template <FilterType FilterT>
+void Termination<FilterT>::SetGain(float gain)
+{
+    gain_ = gain;
+}
+
+template <FilterType FilterT>
+void Termination<FilterT>::SetFilter(FilterT* filter)
+{
+    filter_ = filter;
+}
+
+template <FilterType FilterT>
+float Termination<FilterT>::Tick(float in)
+{
+    if (filter_)
+    {
+        in = filter_->Tick(in);
+    }
+
+    return in * gain_;
+}
+} // namespace sfdsp
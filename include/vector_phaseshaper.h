@@ -2,6 +2,8 @@
 
 #include <cstddef>
 
+#include "oversampler.h"
+
 namespace sfdsp
 {
 
@@ -17,6 +19,16 @@ class VectorPhaseshaper
         RATIO,
     };
 
+    enum class AntiAliasing
+    {
+        /// @brief The oscillator runs at the samplerate
+        NONE,
+
+        /// @brief The oscillator runs at 4 times the samplerate and is decimated with `Oversampler<4>`. Adds
+        /// `GetLatency()` samples of delay.
+        OVERSAMPLE_4X,
+    };
+
     VectorPhaseshaper() = default;
     ~VectorPhaseshaper() = default;
 
@@ -39,12 +51,24 @@ class VectorPhaseshaper
 
     FormantMode GetFormantMode() const;
 
+    /// @brief Sets the anti-aliasing mode. Changing the mode clears the state of the decimation filters.
+    /// @param mode The anti-aliasing mode
+    void SetAntiAliasing(AntiAliasing mode);
+
+    AntiAliasing GetAntiAliasing() const;
+
+    /// @brief Returns the delay added by the anti-aliasing mode, in samples.
+    float GetLatency() const;
+
     /// @brief Processes a block of samples
     /// @param out The output buffer
     /// @param size The size of the buffer
     void ProcessBlock(float* out, size_t size);
 
   private:
+    /// @brief Renders a block at the current phase, advancing it by `increment` per sample.
+    void Render(float* out, size_t size, float increment);
+
     float samplerate_ = 0.f;
     float freq_ = 0.f;
     float phase_ = 0.f;
@@ -54,6 +78,9 @@ class VectorPhaseshaper
     float v_ = 0.5f;
 
     FormantMode formantMode_ = FormantMode::FREE;
+    AntiAliasing antiAliasing_ = AntiAliasing::NONE;
+
+    Oversampler<4> oversampler_;
 };
 
 } // namespace sfdsp
\ No newline at end of file
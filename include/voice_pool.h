@@ -0,0 +1,336 @@
+/// @file
+/// Fixed capacity polyphonic voice allocator
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "dsp_utils.h"
+#include "spsc_queue.h"
+
+namespace sfdsp
+{
+
+/// @brief Plays notes on a fixed set of oscillator voices, stealing voices when all of them are in use.
+/// @details `NoteOn` and `NoteOff` only push an event to a lock-free queue and can be called from a MIDI or control
+/// thread, one thread at a time. Every other method belongs to the audio thread, and the events are applied at the
+/// start of the next `ProcessBlock`.
+///
+/// Each voice has an exponential attack/release envelope scaled by the velocity. A note goes, in order of preference,
+/// to the voice already playing that note, to a free voice, to the quietest released voice, and finally to the
+/// voice holding the oldest note. Only the voices that are playing or releasing are rendered, so the cost of a block
+/// follows the number of sounding notes and not `Capacity`.
+/// @tparam Voice An oscillator with `Init(float)`, `SetFreq(float)` and `ProcessBlock(float*, size_t)`, like
+/// `Phaseshaper` or `VectorPhaseshaper`.
+/// @tparam Capacity The number of voices.
+/// @ingroup Oscillators
+template <class Voice, size_t Capacity>
+class VoicePool
+{
+  public:
+    /// @brief The number of voices.
+    static constexpr size_t kCapacity = Capacity;
+
+    /// @brief The maximum number of note events queued between two blocks. Further events are dropped.
+    static constexpr size_t kEventQueueSize = 256;
+
+    VoicePool() = default;
+    ~VoicePool() = default;
+
+    /// @brief Initializes every voice and releases all notes.
+    /// @param samplerate The samplerate
+    void Init(float samplerate);
+
+    /// @brief Sets the time constant of the envelope attack.
+    /// @param seconds The attack time in seconds
+    void SetAttack(float seconds);
+
+    /// @brief Sets the time constant of the envelope release.
+    /// @param seconds The release time in seconds
+    void SetRelease(float seconds);
+
+    /// @brief Starts a note. Lock-free, can be called from the MIDI thread.
+    /// @param note The MIDI note number
+    /// @param velocity The velocity, between 0 and 1. A velocity of 0 is a note off.
+    /// @return False if the event queue is full and the event was dropped.
+    bool NoteOn(uint8_t note, float velocity);
+
+    /// @brief Releases a note. Lock-free, can be called from the MIDI thread.
+    /// @param note The MIDI note number
+    /// @return False if the event queue is full and the event was dropped.
+    bool NoteOff(uint8_t note);
+
+    /// @brief Returns a voice, to configure it. Audio thread only.
+    /// @param index The voice index, below `kCapacity`
+    Voice& GetVoice(size_t index);
+
+    /// @brief Returns the number of voices playing or releasing a note.
+    size_t GetActiveVoiceCount() const;
+
+    /// @brief Returns true if a voice is playing or releasing the note.
+    /// @param note The MIDI note number
+    bool IsPlaying(uint8_t note) const;
+
+    /// @brief Renders the sum of the active voices.
+    /// @param out The output buffer
+    /// @param size The number of samples
+    void ProcessBlock(float* out, size_t size);
+
+  private:
+    /// @brief The voices are rendered in chunks of at most this size.
+    static constexpr size_t kChunkSize = 128;
+
+    /// @brief Level below which a released voice is silent and becomes free, -80 dB.
+    static constexpr float kSilence = 1e-4f;
+
+    struct NoteEvent
+    {
+        uint8_t note;
+        float velocity;
+    };
+
+    struct VoiceState
+    {
+        Voice voice;
+        uint8_t note = 0;
+        bool active = false;
+        bool held = false;
+        float level = 0.f;
+        float target = 0.f;
+        uint32_t age = 0;
+    };
+
+    void StartNote(uint8_t note, float velocity);
+    void ReleaseNote(uint8_t note);
+
+    /// @brief Returns the index of the voice that plays a new note.
+    size_t Allocate(uint8_t note) const;
+
+    float TimeToCoeff(float seconds) const;
+
+    float samplerate_ = 48000.f;
+    float attack_coeff_ = 0.f;
+    float release_coeff_ = 0.f;
+    uint32_t note_count_ = 0;
+
+    std::array<VoiceState, Capacity> voices_;
+
+    // Indices of the active voices, in no particular order.
+    std::array<size_t, Capacity> active_ = {};
+    size_t active_count_ = 0;
+
+    std::array<float, kChunkSize> scratch_ = {};
+
+    SpscQueue<NoteEvent, kEventQueueSize> events_;
+};
+
+template <class Voice, size_t Capacity>
+void VoicePool<Voice, Capacity>::Init(float samplerate)
+{
+    samplerate_ = samplerate;
+    SetAttack(0.005f);
+    SetRelease(0.1f);
+
+    for (auto& state : voices_)
+    {
+        state.voice.Init(samplerate);
+        state.active = false;
+        state.held = false;
+        state.level = 0.f;
+        state.target = 0.f;
+    }
+    active_count_ = 0;
+}
+
+template <class Voice, size_t Capacity>
+void VoicePool<Voice, Capacity>::SetAttack(float seconds)
+{
+    attack_coeff_ = TimeToCoeff(seconds);
+}
+
+template <class Voice, size_t Capacity>
+void VoicePool<Voice, Capacity>::SetRelease(float seconds)
+{
+    release_coeff_ = TimeToCoeff(seconds);
+}
+
+template <class Voice, size_t Capacity>
+bool VoicePool<Voice, Capacity>::NoteOn(uint8_t note, float velocity)
+{
+    return events_.TryPush({note, std::clamp(velocity, 0.f, 1.f)});
+}
+
+template <class Voice, size_t Capacity>
+bool VoicePool<Voice, Capacity>::NoteOff(uint8_t note)
+{
+    return events_.TryPush({note, 0.f});
+}
+
+template <class Voice, size_t Capacity>
+Voice& VoicePool<Voice, Capacity>::GetVoice(size_t index)
+{
+    assert(index < Capacity);
+    return voices_[index].voice;
+}
+
+template <class Voice, size_t Capacity>
+size_t VoicePool<Voice, Capacity>::GetActiveVoiceCount() const
+{
+    return active_count_;
+}
+
+template <class Voice, size_t Capacity>
+bool VoicePool<Voice, Capacity>::IsPlaying(uint8_t note) const
+{
+    for (size_t i = 0; i < active_count_; ++i)
+    {
+        if (voices_[active_[i]].note == note)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class Voice, size_t Capacity>
+void VoicePool<Voice, Capacity>::ProcessBlock(float* out, size_t size)
+{
+    assert(out != nullptr);
+
+    NoteEvent event;
+    while (events_.TryPop(event))
+    {
+        if (event.velocity > 0.f)
+        {
+            StartNote(event.note, event.velocity);
+        }
+        else
+        {
+            ReleaseNote(event.note);
+        }
+    }
+
+    std::fill(out, out + size, 0.f);
+    for (size_t start = 0; start < size; start += kChunkSize)
+    {
+        const size_t count = std::min(kChunkSize, size - start);
+        float* chunk = out + start;
+
+        size_t i = 0;
+        while (i < active_count_)
+        {
+            VoiceState& state = voices_[active_[i]];
+            state.voice.ProcessBlock(scratch_.data(), count);
+
+            // The envelope is exact at the chunk boundaries and linear in between.
+            const float coeff = state.held ? attack_coeff_ : release_coeff_;
+            const float end = state.target + (state.level - state.target) * std::pow(coeff, static_cast<float>(count));
+            const float step = (end - state.level) / static_cast<float>(count);
+            const float level = state.level;
+            for (size_t j = 0; j < count; ++j)
+            {
+                chunk[j] += scratch_[j] * (level + step * static_cast<float>(j + 1));
+            }
+            state.level = end;
+
+            if (!state.held && end < kSilence)
+            {
+                state.active = false;
+                active_[i] = active_[--active_count_];
+                continue;
+            }
+            ++i;
+        }
+    }
+}
+
+template <class Voice, size_t Capacity>
+void VoicePool<Voice, Capacity>::StartNote(uint8_t note, float velocity)
+{
+    const size_t index = Allocate(note);
+    VoiceState& state = voices_[index];
+    if (!state.active)
+    {
+        state.active = true;
+        state.level = 0.f;
+        active_[active_count_++] = index;
+    }
+
+    // A stolen voice starts its attack from its current level.
+    state.note = note;
+    state.held = true;
+    state.target = velocity;
+    state.age = note_count_++;
+    state.voice.SetFreq(MidiToFreq(note));
+}
+
+template <class Voice, size_t Capacity>
+void VoicePool<Voice, Capacity>::ReleaseNote(uint8_t note)
+{
+    for (size_t i = 0; i < active_count_; ++i)
+    {
+        VoiceState& state = voices_[active_[i]];
+        if (state.held && state.note == note)
+        {
+            state.held = false;
+            state.target = 0.f;
+        }
+    }
+}
+
+template <class Voice, size_t Capacity>
+size_t VoicePool<Voice, Capacity>::Allocate(uint8_t note) const
+{
+    for (size_t i = 0; i < active_count_; ++i)
+    {
+        if (voices_[active_[i]].note == note)
+        {
+            return active_[i];
+        }
+    }
+
+    if (active_count_ < Capacity)
+    {
+        for (size_t i = 0; i < Capacity; ++i)
+        {
+            if (!voices_[i].active)
+            {
+                return i;
+            }
+        }
+    }
+
+    // Every voice is in use: steal the quietest released voice, or else the oldest note. The ages are compared
+    // relative to the newest note so that the counter can wrap around.
+    size_t quietest = Capacity;
+    size_t oldest = 0;
+    for (size_t i = 0; i < Capacity; ++i)
+    {
+        const VoiceState& state = voices_[i];
+        if (!state.held && (quietest == Capacity || state.level < voices_[quietest].level))
+        {
+            quietest = i;
+        }
+        if (note_count_ - state.age > note_count_ - voices_[oldest].age)
+        {
+            oldest = i;
+        }
+    }
+    return (quietest != Capacity) ? quietest : oldest;
+}
+
+template <class Voice, size_t Capacity>
+float VoicePool<Voice, Capacity>::TimeToCoeff(float seconds) const
+{
+    if (seconds <= 0.f)
+    {
+        return 0.f;
+    }
+    return std::exp(-1.f / (seconds * samplerate_));
+}
+
+} // namespace sfdsp
@@ -7,11 +7,51 @@
 namespace sfdsp
 {
 /// @brief Returns the value of a Hann window of size L at index x.
-/// @param i Index of the Hann window.
-/// @param size Size of the Hann window.
+/// @param x Index of the Hann window.
+/// @param L Size of the Hann window.
 /// @return float
-float Hann(float x, float L)
+inline float Hann(float x, float L)
 {
     return 0.5f * (1.f - std::cos((TWO_PI * x) / L));
 }
-} // namespace sfdsp
\ No newline at end of file
+
+/// @brief Returns the value of a Blackman window of size L at index x.
+/// @param x Index of the Blackman window.
+/// @param L Size of the Blackman window.
+/// @return float
+inline float Blackman(float x, float L)
+{
+    const float phase = (TWO_PI * x) / L;
+    return 0.42f - 0.5f * std::cos(phase) + 0.08f * std::cos(2.f * phase);
+}
+
+/// @brief Zeroth order modified Bessel function of the first kind.
+/// @param x The input value.
+/// @return float
+inline float BesselI0(float x)
+{
+    // Power series sum((x/2)^k / k!)^2, converges quickly for the arguments used by the Kaiser window.
+    const double half_x = 0.5 * static_cast<double>(x);
+    double term = 1.0;
+    double sum = 1.0;
+    for (int k = 1; k < 64 && term > sum * 1e-12; ++k)
+    {
+        const double t = half_x / k;
+        term *= t * t;
+        sum += term;
+    }
+    return static_cast<float>(sum);
+}
+
+/// @brief Returns the value of a Kaiser window of size L at index x.
+/// @param x Index of the Kaiser window.
+/// @param L Size of the Kaiser window.
+/// @param beta Shape parameter. Larger values give a wider main lobe and a lower sidelobe level.
+/// @return float
+inline float Kaiser(float x, float L, float beta)
+{
+    const float r = 2.f * x / L - 1.f;
+    const float arg = 1.f - r * r;
+    return BesselI0(beta * std::sqrt(arg > 0.f ? arg : 0.f)) / BesselI0(beta);
+}
+} // namespace sfdsp
@@ -31,7 +31,7 @@ print("")
 print(f"constexpr size_t SINC_ZERO_COUNT = {NZ};")
 print(f"constexpr size_t SAMPLES_PER_CROSSING = {SAMPLES_PER_CROSSING};")
 print(f"constexpr size_t sinc_table_size = {SINC_SIZE};")
-print(f"const float sinc_table[{SINC_SIZE+1}] = {{")
+print(f"inline constexpr float sinc_table[{SINC_SIZE+1}] = {{")
 
 for val in half_y:
     print(f"{val}f,")
@@ -0,0 +1,36 @@
+import numpy as np
+
+# Lookup table for the bilinear transform prewarping: g = tan(pi * f) where f is the cutoff frequency normalized
+# by the samplerate, between 0 and 0.5.
+TABLE_SIZE = 1024
+
+f = np.linspace(0, 0.5, TABLE_SIZE + 1)
+# tan(pi/2) is infinite, keep the last entry finite.
+f[-1] = 0.4999
+x = np.tan(np.pi * f)
+
+print(f"// Auto-generated file from make_tan_table.py")
+print("#pragma once")
+print("")
+print("#include <array>")
+print("")
+print("namespace sfdsp")
+print("{")
+print("/// @brief Size of the tan lookup table.")
+print(f"constexpr size_t TAN_LUT_SIZE = {TABLE_SIZE};")
+print("")
+print("/// @brief tan(pi * f) lookup table for normalized frequencies f between 0 and 0.5.")
+print(f"const std::array<float, TAN_LUT_SIZE + 1> tan_lut = {{")
+
+VAL_PER_LINE = 6
+for i, val in enumerate(x):
+    if i % VAL_PER_LINE == 0:
+        print("    ", end="")
+    print(f"{val:.8e}f,", end="")
+    if i % VAL_PER_LINE == VAL_PER_LINE - 1 or i == len(x) - 1:
+        print("")
+    else:
+        print(" ", end="")
+
+print("};")
+print("} // namespace sfdsp")
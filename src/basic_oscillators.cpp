@@ -1,10 +1,12 @@
 #include "basic_oscillators.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <iterator>
 
 #include "dsp_utils.h"
-#include "sin_table.h"
+#include "simd.h"
 
 #define MOD1(x) (x - std::floor(x))
 
@@ -19,56 +21,273 @@ float Fast_RandFloat()
     gRandSeed *= 16807;
     return (float)gRandSeed * 4.6566129e-010f;
 }
-} // namespace
 
-namespace sfdsp
-{
+// Minimax coefficients of sin(2 pi x) / x as a polynomial in x^2, relative error, for x in [-1/4, 1/4].
+constexpr float kSinCoefs5[] = {6.282505600084896f, -41.166442330889105f, 74.45241870632212f};
+constexpr float kSinCoefs7[] = {6.283179406633921f, -41.33894249846165f, 81.39535863071282f, -71.47469428870525f};
+constexpr float kSinCoefs9[] = {6.283185273790786f, -41.34167747839169f, 81.60223124273945f, -76.57499218231393f,
+                                39.71091814639996f};
 
-float Sine(float phase)
+/// @brief sin(2 pi phase), for any phase.
+template <size_t N>
+float SinCycles(float phase, const float (&coefs)[N])
 {
-    while (phase < 0.f)
+    // Reduce to [-1/2, 1/2], then fold into [-1/4, 1/4] with sin(pi - a) = sin(a).
+    float x = phase - std::floor(phase + 0.5f);
+    x = (x > 0.25f) ? 0.5f - x : x;
+    x = (x < -0.25f) ? -0.5f - x : x;
+
+    const float z = x * x;
+    float p = coefs[N - 1];
+    for (size_t k = N - 1; k-- > 0;)
     {
-        phase += 1.f;
+        p = p * z + coefs[k];
     }
+    return p * x;
+}
 
-    phase = MOD1(phase);
-    float idx = phase * SIN_LUT_SIZE;
-    auto idx0 = static_cast<size_t>(idx);
-    auto frac = idx - static_cast<float>(idx0);
-    return sin_lut[idx0] + frac * (sin_lut[idx0 + 1] - sin_lut[idx0]);
+#if !defined(LIBDSP_SIMD_SCALAR)
+/// @brief Vector version of `SinCycles`. With the scalar fallback `float_v` is `float` and the version above is used.
+template <size_t N>
+sfdsp::simd::float_v SinCycles(sfdsp::simd::float_v phase, const float (&coefs)[N])
+{
+    using namespace sfdsp::simd;
+    const float_v half = Broadcast(0.5f);
+    const float_v quarter = Broadcast(0.25f);
+
+    float_v x = Sub(phase, Floor(Add(phase, half)));
+    x = Select(CmpGt(x, quarter), Sub(half, x), x);
+    x = Select(CmpLt(x, Sub(Zero(), quarter)), Sub(Sub(Zero(), half), x), x);
+
+    const float_v z = Mul(x, x);
+    float_v p = Broadcast(coefs[N - 1]);
+    for (size_t k = N - 1; k-- > 0;)
+    {
+        p = MulAdd(p, z, Broadcast(coefs[k]));
+    }
+    return Mul(p, x);
 }
+#endif
 
-float Cosine(float phase)
+/// @brief sin(2 pi (phases[i] + offset)) for a block, `simd::kFloatWidth` samples at a time.
+template <size_t N>
+void SinBlock(const float* phases, float* out, size_t size, float offset, const float (&coefs)[N])
 {
-    return Sine(phase + 0.25f);
+    using namespace sfdsp::simd;
+    const float_v offset_v = Broadcast(offset);
+    size_t i = 0;
+    for (; i + kFloatWidth <= size; i += kFloatWidth)
+    {
+        Store(out + i, SinCycles(Add(Load(phases + i), offset_v), coefs));
+    }
+    for (; i < size; ++i)
+    {
+        out[i] = SinCycles(phases[i] + offset, coefs);
+    }
 }
 
-void Sine(const float* phases, float* out, size_t size)
+void SinBlock(const float* phases, float* out, size_t size, float offset, sfdsp::SineAccuracy accuracy)
 {
-    for (size_t i = 0; i < size; ++i)
+    switch (accuracy)
     {
-        float idx1 = phases[i] * SIN_LUT_SIZE;
+    case sfdsp::SineAccuracy::Low:
+        SinBlock(phases, out, size, offset, kSinCoefs5);
+        break;
+    case sfdsp::SineAccuracy::High:
+        SinBlock(phases, out, size, offset, kSinCoefs9);
+        break;
+    case sfdsp::SineAccuracy::Medium:
+    default:
+        SinBlock(phases, out, size, offset, kSinCoefs7);
+        break;
+    }
+}
 
-        static_assert(SIN_LUT_SIZE == 0x1FF + 1);
-        auto idxint_1 = static_cast<size_t>(idx1) & 0x1FF;
+/// @brief Smallest width of the PolyBLEP corrections, avoids dividing by zero when the oscillator is stopped.
+constexpr float kMinBlepWidth = 1e-6f;
 
-        auto frac_1 = idx1 - static_cast<size_t>(idx1);
-        out[i] = sin_lut[idxint_1] + frac_1 * (sin_lut[idxint_1 + 1] - sin_lut[idxint_1]);
-    }
+/// @brief Width of the PolyBLEP and PolyBLAMP corrections for a phase increment, at most half a period.
+float BlepWidth(float phase_increment)
+{
+    return std::clamp(std::fabs(phase_increment), kMinBlepWidth, 0.5f);
 }
 
-void Cosine(const float* phases, float* out, size_t size)
+float Wrap(float phase)
 {
-    for (size_t i = 0; i < size; ++i)
+    return phase - std::floor(phase);
+}
+
+/// @brief PolyBLEP residual of a unit rising step at phase 0.
+/// @param t Phase in [0, 1)
+/// @param dt Width of the correction, in phase
+float BlepResidual(float t, float dt)
+{
+    const float r = std::max(1.f - std::min(t, 1.f - t) / dt, 0.f);
+    const float c = 0.5f * r * r;
+    return t < 0.5f ? -c : c;
+}
+
+/// @brief PolyBLAMP residual of a unit slope change at phase 0, the integral of `BlepResidual`.
+/// @param t Phase in [0, 1)
+/// @param dt Width of the correction, in phase
+float BlampResidual(float t, float dt)
+{
+    const float r = std::max(1.f - std::min(t, 1.f - t) / dt, 0.f);
+    return dt * r * r * r * (1.f / 6.f);
+}
+
+/// @brief Vector version of the PolyBLEP and PolyBLAMP residuals for a fixed width.
+struct BlepKernel
+{
+    explicit BlepKernel(float width)
+        : dt(sfdsp::simd::Broadcast(width))
+        , inv_dt(sfdsp::simd::Broadcast(1.f / width))
     {
-        float idx1 = (phases[i] + 0.25f) * SIN_LUT_SIZE;
+    }
 
-        static_assert(SIN_LUT_SIZE == 0x1FF + 1);
-        auto idxint_1 = static_cast<size_t>(idx1) & 0x1FF;
+    /// @brief Returns true if any lane is within `dt` of the discontinuity at phase 0.
+    bool Near(sfdsp::simd::float_v t) const
+    {
+        using namespace sfdsp::simd;
+        return Any(CmpLt(Min(t, Sub(Broadcast(1.f), t)), dt));
+    }
+
+    /// @brief 1 at the discontinuity, falling linearly to 0 at `dt` on both sides.
+    sfdsp::simd::float_v Proximity(sfdsp::simd::float_v t) const
+    {
+        using namespace sfdsp::simd;
+        const float_v one = Broadcast(1.f);
+        const float_v distance = Min(t, Sub(one, t));
+        return Max(Sub(one, Mul(distance, inv_dt)), Zero());
+    }
 
-        auto frac_1 = idx1 - static_cast<size_t>(idx1);
-        out[i] = sin_lut[idxint_1] + frac_1 * (sin_lut[idxint_1 + 1] - sin_lut[idxint_1]);
+    sfdsp::simd::float_v Blep(sfdsp::simd::float_v t) const
+    {
+        using namespace sfdsp::simd;
+        const float_v r = Proximity(t);
+        const float_v c = Mul(Broadcast(0.5f), Mul(r, r));
+        return Select(CmpLt(t, Broadcast(0.5f)), Sub(Zero(), c), c);
+    }
+
+    sfdsp::simd::float_v Blamp(sfdsp::simd::float_v t) const
+    {
+        using namespace sfdsp::simd;
+        const float_v r = Proximity(t);
+        return Mul(Mul(dt, Broadcast(1.f / 6.f)), Mul(r, Mul(r, r)));
+    }
+
+    sfdsp::simd::float_v dt;
+    sfdsp::simd::float_v inv_dt;
+};
+
+/// @brief Renders `shape(t)` for the wrapped phases of a block, `simd::kFloatWidth` samples at a time.
+/// @return The phase after the block, wrapped to [0, 1)
+template <class Shape>
+float ShapeBlock(float phase, float phase_increment, float* out, size_t size, Shape shape)
+{
+    using namespace sfdsp::simd;
+    constexpr float kLaneIndex[] = {0.f, 1.f, 2.f,  3.f,  4.f,  5.f,  6.f,  7.f,
+                                    8.f, 9.f, 10.f, 11.f, 12.f, 13.f, 14.f, 15.f};
+    static_assert(std::size(kLaneIndex) >= kFloatWidth);
+
+    const float_v lane_phase = Mul(Load(kLaneIndex), Broadcast(phase_increment));
+    const float vector_increment = phase_increment * kFloatWidth;
+
+    size_t i = 0;
+    for (; i + kFloatWidth <= size; i += kFloatWidth)
+    {
+        const float_v p = Add(Broadcast(phase), lane_phase);
+        Store(out + i, shape(Sub(p, Floor(p))));
+        phase = Wrap(phase + vector_increment);
+    }
+    if (i < size)
+    {
+        float tail[kFloatWidth];
+        const float_v p = Add(Broadcast(phase), lane_phase);
+        Store(tail, shape(Sub(p, Floor(p))));
+        std::copy(tail, tail + (size - i), out + i);
+        phase = Wrap(phase + phase_increment * static_cast<float>(size - i));
     }
+    return phase;
+}
+
+float PolyBlepSawBlock(float phase, float phase_increment, float* out, size_t size)
+{
+    using namespace sfdsp::simd;
+    const BlepKernel blep(BlepWidth(phase_increment));
+    return ShapeBlock(phase, phase_increment, out, size, [&](float_v t) {
+        float_v y = MulAdd(Broadcast(2.f), t, Broadcast(-1.f));
+        if (blep.Near(t))
+        {
+            y = MulAdd(Broadcast(-2.f), blep.Blep(t), y);
+        }
+        return y;
+    });
+}
+
+float PolyBlepSquareBlock(float phase, float phase_increment, float* out, size_t size, float duty)
+{
+    using namespace sfdsp::simd;
+    const BlepKernel blep(BlepWidth(phase_increment));
+    const float_v duty_v = Broadcast(duty);
+    return ShapeBlock(phase, phase_increment, out, size, [&](float_v t) {
+        float_v y = Select(CmpGt(t, duty_v), Broadcast(-1.f), Broadcast(1.f));
+        if (blep.Near(t))
+        {
+            y = MulAdd(Broadcast(2.f), blep.Blep(t), y);
+        }
+        float_v fall = Sub(t, duty_v);
+        fall = Sub(fall, Floor(fall));
+        if (blep.Near(fall))
+        {
+            y = MulAdd(Broadcast(-2.f), blep.Blep(fall), y);
+        }
+        return y;
+    });
+}
+
+float PolyBlampTriBlock(float phase, float phase_increment, float* out, size_t size)
+{
+    using namespace sfdsp::simd;
+    const BlepKernel blep(BlepWidth(phase_increment));
+    return ShapeBlock(phase, phase_increment, out, size, [&](float_v t) {
+        float_v y = MulAdd(Broadcast(2.f), Abs(MulAdd(Broadcast(2.f), t, Broadcast(-1.f))), Broadcast(-1.f));
+        if (blep.Near(t))
+        {
+            y = MulAdd(Broadcast(-8.f), blep.Blamp(t), y);
+        }
+        float_v trough = Add(t, Broadcast(0.5f));
+        trough = Sub(trough, Floor(trough));
+        if (blep.Near(trough))
+        {
+            y = MulAdd(Broadcast(8.f), blep.Blamp(trough), y);
+        }
+        return y;
+    });
+}
+} // namespace
+
+namespace sfdsp
+{
+
+float Sine(float phase)
+{
+    return SinCycles(phase, kSinCoefs7);
+}
+
+float Cosine(float phase)
+{
+    return SinCycles(phase + 0.25f, kSinCoefs7);
+}
+
+void Sine(const float* phases, float* out, size_t size, SineAccuracy accuracy)
+{
+    SinBlock(phases, out, size, 0.f, accuracy);
+}
+
+void Cosine(const float* phases, float* out, size_t size, SineAccuracy accuracy)
+{
+    SinBlock(phases, out, size, 0.25f, accuracy);
 }
 
 float Tri(float phase)
@@ -126,6 +345,29 @@ float Square(float phase, float phase_increment, float* out, size_t size, float
     return phase;
 }
 
+float PolyBlepSaw(float phase, float phase_increment)
+{
+    const float t = Wrap(phase);
+    return 2.f * t - 1.f - 2.f * BlepResidual(t, BlepWidth(phase_increment));
+}
+
+float PolyBlepSquare(float phase, float phase_increment, float duty)
+{
+    const float t = Wrap(phase);
+    const float dt = BlepWidth(phase_increment);
+    const float naive = (t > duty) ? -1.f : 1.f;
+    return naive + 2.f * BlepResidual(t, dt) - 2.f * BlepResidual(Wrap(t - duty), dt);
+}
+
+float PolyBlampTri(float phase, float phase_increment)
+{
+    // Corners at 0, where the slope goes from 4 to -4, and at 1/2, where it goes from -4 to 4.
+    const float t = Wrap(phase);
+    const float dt = BlepWidth(phase_increment);
+    const float naive = 2.f * std::fabs(2.f * t - 1.f) - 1.f;
+    return naive - 8.f * BlampResidual(t, dt) + 8.f * BlampResidual(Wrap(t + 0.5f), dt);
+}
+
 float Noise()
 {
     return Fast_RandFloat();
@@ -194,6 +436,15 @@ float BasicOscillator::Tick()
     case OscillatorType::Square:
         out = Square(phase_, duty_);
         break;
+    case OscillatorType::PolyBlepSaw:
+        out = PolyBlepSaw(phase_, phase_increment_);
+        break;
+    case OscillatorType::PolyBlepSquare:
+        out = PolyBlepSquare(phase_, phase_increment_, duty_);
+        break;
+    case OscillatorType::PolyBlampTri:
+        out = PolyBlampTri(phase_, phase_increment_);
+        break;
     default:
         assert(false);
         out = Sine(phase_);
@@ -242,6 +493,15 @@ void BasicOscillator::ProcessBlock(float* out, size_t size)
         phase_ = Square(phase_, phase_increment_, out, size, duty_);
         phase_ = MOD1(phase_);
         break;
+    case OscillatorType::PolyBlepSaw:
+        phase_ = PolyBlepSawBlock(phase_, phase_increment_, out, size);
+        break;
+    case OscillatorType::PolyBlepSquare:
+        phase_ = PolyBlepSquareBlock(phase_, phase_increment_, out, size, duty_);
+        break;
+    case OscillatorType::PolyBlampTri:
+        phase_ = PolyBlampTriBlock(phase_, phase_increment_, out, size);
+        break;
     default:
         assert(false);
         break;
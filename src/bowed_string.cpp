@@ -3,7 +3,6 @@
 #include <cmath>
 #include <vector>
 
-#include "basic_oscillators.h"
 #include "window_functions.h"
 
 namespace sfdsp
@@ -49,7 +48,8 @@ void BowedString::Init(const BowedStringConfig& config)
     decay_filter_.SetDecayFilter(decayDb, timeMs, config.samplerate);
     decay_filter_.SetGain(1.f);
 
-    noise_lp_filter_.SetPole(0.8f);
+    noise_.Seed(config.noise_seed);
+    noise_.GetFilter().SetPole(0.8f);
 
     velocity_.Init(samplerate_, SmoothParam::SmoothingType::Exponential);
     bow_force_.Init(samplerate_, SmoothParam::SmoothingType::Exponential);
@@ -76,6 +76,9 @@ float BowedString::GetFrequency() const
 
 void BowedString::Pluck()
 {
+    silent_ = false;
+    quiet_samples_ = 0;
+
     float L = gate_.GetDelay();
     for (size_t i = 1; i < static_cast<size_t>(L); ++i)
     {
@@ -85,6 +88,11 @@ void BowedString::Pluck()
 
 float BowedString::NextOut()
 {
+    if (IsSilent())
+    {
+        return 0.f;
+    }
+
     float bridge = 0.f;
     float nut = 0.f;
     waveguide_.NextOut(nut, bridge);
@@ -98,6 +106,17 @@ float BowedString::Tick(float input)
     float vel = velocity_.Tick();
     bow_table_.SetForce(bow_force_.Tick());
 
+    if (silent_)
+    {
+        // Everything in the waveguide is zero, only a new excitation can produce sound.
+        if (!note_on_ && std::abs(input) < kSilenceThreshold)
+        {
+            return 0.f;
+        }
+        silent_ = false;
+        quiet_samples_ = 0;
+    }
+
     float bridge = 0.f;
     float nut = 0.f;
     waveguide_.NextOut(nut, bridge);
@@ -114,7 +133,7 @@ float BowedString::Tick(float input)
         const float noise_gain = std::pow(10.f, noise_db / 20.f);
 
         float env = std::sqrt(decay_filter_.Tick(velocity_delta * velocity_delta));
-        float additive_noise = noise_lp_filter_.Tick(Noise()) * env * noise_gain;
+        float additive_noise = noise_.Tick() * env * noise_gain;
 
         bow_output = (velocity_delta + additive_noise) * bow_table_.Tick(velocity_delta + additive_noise);
     }
@@ -124,9 +143,27 @@ float BowedString::Tick(float input)
     gate_.Process(waveguide_);
     waveguide_.Tick(bridge_.Tick(-input), nut_.Tick(nut));
 
+    // Any energy left in the string passes the bridge within one round trip through the waveguide.
+    if (note_on_ || std::abs(bridge) >= kSilenceThreshold || std::abs(input) >= kSilenceThreshold)
+    {
+        quiet_samples_ = 0;
+    }
+    else if (static_cast<float>(++quiet_samples_) > 2.f * waveguide_.GetDelay())
+    {
+        silent_ = true;
+        waveguide_[0].Reset();
+        waveguide_[1].Reset();
+        reflection_filter_.Reset();
+    }
+
     return bridge;
 }
 
+bool BowedString::IsSilent() const
+{
+    return silent_ && !note_on_;
+}
+
 void BowedString::SetParameter(ParamId param_id, float value)
 {
     assert(value >= 0.f && value <= 1.f);
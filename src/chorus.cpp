@@ -1,5 +1,7 @@
 #include "chorus.h"
 
+#include <algorithm>
+
 #include "basic_oscillators.h"
 
 namespace sfdsp
@@ -59,8 +61,6 @@ void Chorus::SetSpeed(float speed)
 
 float Chorus::Tick(float in)
 {
-    // Simple chorus structure based on J. Dattoro, Effect Design Part 2: Delay-line modulation and chorus,
-    // as presented in DAFX Second Edition, p. 77-78, figure 2.34
     float mod = Sine(mod_phase_) * width_;
     mod_phase_ += mod_phase_dt_;
     if (mod_phase_ >= 1.f)
@@ -68,6 +68,39 @@ float Chorus::Tick(float in)
         mod_phase_ -= 1.f;
     }
 
+    return ProcessSample(in, mod);
+}
+
+void Chorus::ProcessBlock(const float* in, float* out, size_t size)
+{
+    constexpr size_t kChunkSize = 64;
+    float mod[kChunkSize];
+    for (size_t start = 0; start < size; start += kChunkSize)
+    {
+        const size_t count = std::min(kChunkSize, size - start);
+        for (size_t i = 0; i < count; ++i)
+        {
+            mod[i] = mod_phase_;
+            mod_phase_ += mod_phase_dt_;
+            if (mod_phase_ >= 1.f)
+            {
+                mod_phase_ -= 1.f;
+            }
+        }
+        Sine(mod, mod, count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[start + i] = ProcessSample(in[start + i], mod[i] * width_);
+        }
+    }
+}
+
+float Chorus::ProcessSample(float in, float mod)
+{
+    // Simple chorus structure based on J. Dattoro, Effect Design Part 2: Delay-line modulation and chorus,
+    // as presented in DAFX Second Edition, p. 77-78, figure 2.34
+
     // Value taken from DAFX Second editions, Table 2.9, p. 77
     // Ideally, these values should be settable by the user.
     constexpr float FB = -0.7f;
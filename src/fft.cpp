@@ -0,0 +1,195 @@
+#include "fft.h"
+
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+#include "simd.h"
+
+namespace
+{
+using complex_f = std::complex<float>;
+
+// std::complex operator* goes through the C99 Annex G NaN checks unless -ffast-math is used, so the split step
+// multiplies manually.
+inline complex_f Mul(complex_f a, complex_f b)
+{
+    return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+}
+
+inline complex_f MulConj(complex_f a, complex_f b)
+{
+    return {a.real() * b.real() + a.imag() * b.imag(), a.imag() * b.real() - a.real() * b.imag()};
+}
+
+inline complex_f Polar(size_t k, size_t n)
+{
+    const double angle = -2.0 * std::numbers::pi * static_cast<double>(k) / static_cast<double>(n);
+    return {static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle))};
+}
+} // namespace
+
+namespace sfdsp
+{
+
+FFT::FFT(size_t size) : size_(size)
+{
+    assert(size >= 4);
+    assert((size & (size - 1)) == 0);
+
+    const size_t half = size_ / 2;
+
+    twiddles_re_.resize(half);
+    twiddles_im_.resize(half);
+    for (size_t h = 1; h < half; h *= 2)
+    {
+        for (size_t j = 0; j < h; ++j)
+        {
+            const complex_f w = Polar(j, 2 * h);
+            twiddles_re_[h - 1 + j] = w.real();
+            twiddles_im_[h - 1 + j] = w.imag();
+        }
+    }
+
+    split_twiddles_.resize(half + 1);
+    for (size_t k = 0; k < split_twiddles_.size(); ++k)
+    {
+        split_twiddles_[k] = Polar(k, size_);
+    }
+
+    size_t bits = 0;
+    while ((size_t{1} << bits) < half)
+    {
+        ++bits;
+    }
+
+    bit_reverse_.resize(half);
+    for (size_t i = 0; i < half; ++i)
+    {
+        size_t reversed = 0;
+        for (size_t b = 0; b < bits; ++b)
+        {
+            reversed |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        bit_reverse_[i] = reversed;
+    }
+
+    work_re_.resize(half);
+    work_im_.resize(half);
+}
+
+size_t FFT::GetSize() const
+{
+    return size_;
+}
+
+void FFT::Forward(const float* in, std::complex<float>* out)
+{
+    assert(in != nullptr);
+    assert(out != nullptr);
+
+    const size_t half = size_ / 2;
+    for (size_t i = 0; i < half; ++i)
+    {
+        work_re_[bit_reverse_[i]] = in[2 * i];
+        work_im_[bit_reverse_[i]] = in[2 * i + 1];
+    }
+
+    Transform();
+
+    // Split the packed spectrum Z into the spectra of the even (E) and odd (O) samples and recombine:
+    // X[k] = E[k] + W^k * O[k]
+    for (size_t k = 0; k <= half; ++k)
+    {
+        const size_t k1 = (k == half) ? 0 : k;
+        const size_t k2 = (k == 0) ? 0 : half - k;
+        const complex_f z = {work_re_[k1], work_im_[k1]};
+        const complex_f zc = {work_re_[k2], -work_im_[k2]};
+        const complex_f even = 0.5f * (z + zc);
+        const complex_f odd = 0.5f * (z - zc);
+        // odd * -i
+        const complex_f odd_rot = {odd.imag(), -odd.real()};
+        out[k] = even + Mul(split_twiddles_[k], odd_rot);
+    }
+}
+
+void FFT::Inverse(const std::complex<float>* in, float* out)
+{
+    assert(in != nullptr);
+    assert(out != nullptr);
+
+    // The inverse complex transform is computed as conj(FFT(conj(Z))).
+    const size_t half = size_ / 2;
+    for (size_t k = 0; k < half; ++k)
+    {
+        const complex_f x = in[k];
+        const complex_f xc = std::conj(in[half - k]);
+        const complex_f even = 0.5f * (x + xc);
+        const complex_f odd = MulConj(0.5f * (x - xc), split_twiddles_[k]);
+        // Z[k] = E[k] + i * O[k]
+        work_re_[bit_reverse_[k]] = even.real() - odd.imag();
+        work_im_[bit_reverse_[k]] = -(even.imag() + odd.real());
+    }
+
+    Transform();
+
+    const float scale = 1.f / static_cast<float>(half);
+    for (size_t i = 0; i < half; ++i)
+    {
+        out[2 * i] = work_re_[i] * scale;
+        out[2 * i + 1] = -work_im_[i] * scale;
+    }
+}
+
+void FFT::Transform()
+{
+    float* re = work_re_.data();
+    float* im = work_im_.data();
+    const size_t n = work_re_.size();
+
+    for (size_t h = 1; h < n; h *= 2)
+    {
+        const float* w_re = twiddles_re_.data() + h - 1;
+        const float* w_im = twiddles_im_.data() + h - 1;
+
+        // The first stages have fewer butterflies per group than lanes in a vector.
+        if (h < simd::kFloatWidth)
+        {
+            for (size_t i = 0; i < n; i += 2 * h)
+            {
+                for (size_t j = 0; j < h; ++j)
+                {
+                    const float br = re[i + j + h];
+                    const float bi = im[i + j + h];
+                    const float vr = br * w_re[j] - bi * w_im[j];
+                    const float vi = br * w_im[j] + bi * w_re[j];
+                    re[i + j + h] = re[i + j] - vr;
+                    im[i + j + h] = im[i + j] - vi;
+                    re[i + j] += vr;
+                    im[i + j] += vi;
+                }
+            }
+            continue;
+        }
+
+        for (size_t i = 0; i < n; i += 2 * h)
+        {
+            for (size_t j = 0; j < h; j += simd::kFloatWidth)
+            {
+                const simd::float_v wr = simd::Load(w_re + j);
+                const simd::float_v wi = simd::Load(w_im + j);
+                const simd::float_v ur = simd::Load(re + i + j);
+                const simd::float_v ui = simd::Load(im + i + j);
+                const simd::float_v br = simd::Load(re + i + j + h);
+                const simd::float_v bi = simd::Load(im + i + j + h);
+                const simd::float_v vr = simd::Sub(simd::Mul(br, wr), simd::Mul(bi, wi));
+                const simd::float_v vi = simd::MulAdd(br, wi, simd::Mul(bi, wr));
+                simd::Store(re + i + j, simd::Add(ur, vr));
+                simd::Store(im + i + j, simd::Add(ui, vi));
+                simd::Store(re + i + j + h, simd::Sub(ur, vr));
+                simd::Store(im + i + j + h, simd::Sub(ui, vi));
+            }
+        }
+    }
+}
+} // namespace sfdsp
@@ -4,12 +4,110 @@
 
 namespace sfdsp
 {
-void Filter::SetGain(float gain)
+BiquadCoefficients DesignBiquad(BiquadType type, float cutoff, float q, float gain_db)
+{
+    assert(cutoff > 0.f && cutoff < 0.5f);
+    assert(q > 0.f);
+
+    const float w0 = TWO_PI * cutoff;
+    const float cos_w0 = std::cos(w0);
+    const float alpha = std::sin(w0) / (2.f * q);
+    const float A = std::pow(10.f, gain_db / 40.f);
+
+    float b0 = 1.f;
+    float b1 = 0.f;
+    float b2 = 0.f;
+    float a0 = 1.f;
+    float a1 = 0.f;
+    float a2 = 0.f;
+
+    switch (type)
+    {
+    case BiquadType::Lowpass:
+        b0 = (1.f - cos_w0) * 0.5f;
+        b1 = 1.f - cos_w0;
+        b2 = b0;
+        a0 = 1.f + alpha;
+        a1 = -2.f * cos_w0;
+        a2 = 1.f - alpha;
+        break;
+    case BiquadType::Highpass:
+        b0 = (1.f + cos_w0) * 0.5f;
+        b1 = -(1.f + cos_w0);
+        b2 = b0;
+        a0 = 1.f + alpha;
+        a1 = -2.f * cos_w0;
+        a2 = 1.f - alpha;
+        break;
+    case BiquadType::Bandpass:
+        b0 = alpha;
+        b1 = 0.f;
+        b2 = -alpha;
+        a0 = 1.f + alpha;
+        a1 = -2.f * cos_w0;
+        a2 = 1.f - alpha;
+        break;
+    case BiquadType::Notch:
+        b0 = 1.f;
+        b1 = -2.f * cos_w0;
+        b2 = 1.f;
+        a0 = 1.f + alpha;
+        a1 = -2.f * cos_w0;
+        a2 = 1.f - alpha;
+        break;
+    case BiquadType::Allpass:
+        b0 = 1.f - alpha;
+        b1 = -2.f * cos_w0;
+        b2 = 1.f + alpha;
+        a0 = 1.f + alpha;
+        a1 = -2.f * cos_w0;
+        a2 = 1.f - alpha;
+        break;
+    case BiquadType::Peak:
+        b0 = 1.f + alpha * A;
+        b1 = -2.f * cos_w0;
+        b2 = 1.f - alpha * A;
+        a0 = 1.f + alpha / A;
+        a1 = -2.f * cos_w0;
+        a2 = 1.f - alpha / A;
+        break;
+    case BiquadType::LowShelf:
+    {
+        const float sqrt_a_alpha = 2.f * std::sqrt(A) * alpha;
+        b0 = A * ((A + 1.f) - (A - 1.f) * cos_w0 + sqrt_a_alpha);
+        b1 = 2.f * A * ((A - 1.f) - (A + 1.f) * cos_w0);
+        b2 = A * ((A + 1.f) - (A - 1.f) * cos_w0 - sqrt_a_alpha);
+        a0 = (A + 1.f) + (A - 1.f) * cos_w0 + sqrt_a_alpha;
+        a1 = -2.f * ((A - 1.f) + (A + 1.f) * cos_w0);
+        a2 = (A + 1.f) + (A - 1.f) * cos_w0 - sqrt_a_alpha;
+        break;
+    }
+    case BiquadType::HighShelf:
+    {
+        const float sqrt_a_alpha = 2.f * std::sqrt(A) * alpha;
+        b0 = A * ((A + 1.f) + (A - 1.f) * cos_w0 + sqrt_a_alpha);
+        b1 = -2.f * A * ((A - 1.f) + (A + 1.f) * cos_w0);
+        b2 = A * ((A + 1.f) + (A - 1.f) * cos_w0 - sqrt_a_alpha);
+        a0 = (A + 1.f) - (A - 1.f) * cos_w0 + sqrt_a_alpha;
+        a1 = 2.f * ((A - 1.f) - (A + 1.f) * cos_w0);
+        a2 = (A + 1.f) - (A - 1.f) * cos_w0 - sqrt_a_alpha;
+        break;
+    }
+    default:
+        assert(false);
+        break;
+    }
+
+    const float a0_inv = 1.f / a0;
+    return {b0 * a0_inv, b1 * a0_inv, b2 * a0_inv, a1 * a0_inv, a2 * a0_inv};
+}
+
+void StaticFilter::SetGain(float gain)
 {
     gain_ = gain;
 }
 
-void Filter::SetA(const float (&a)[COEFFICIENT_COUNT])
+void StaticFilter::SetA(const float (&a)[COEFFICIENT_COUNT])
 {
     for (size_t i = 0; i < COEFFICIENT_COUNT; ++i)
     {
@@ -17,7 +115,7 @@ void Filter::SetA(const float (&a)[COEFFICIENT_COUNT])
     }
 }
 
-void Filter::SetB(const float (&b)[COEFFICIENT_COUNT])
+void StaticFilter::SetB(const float (&b)[COEFFICIENT_COUNT])
 {
     for (size_t i = 0; i < COEFFICIENT_COUNT; ++i)
     {
@@ -25,18 +123,13 @@ void Filter::SetB(const float (&b)[COEFFICIENT_COUNT])
     }
 }
 
-void Filter::ProcessBlock(float* in, float* out, size_t size)
+void StaticFilter::Reset()
 {
-    assert(in != nullptr);
-    assert(out != nullptr);
-
-    for (size_t i = 0; i < size; ++i)
-    {
-        out[i] = Tick(in[i]);
-    }
+    outputs_.fill(0.f);
+    inputs_.fill(0.f);
 }
 
-void OnePoleFilter::SetPole(float pole)
+void StaticOnePoleFilter::SetPole(float pole)
 {
     // https://ccrma.stanford.edu/~jos/fp/One_Pole.html
     // If the filter has a pole at z = -a, then a_[1] will be -pole;
@@ -47,7 +140,7 @@ void OnePoleFilter::SetPole(float pole)
     a_[1] = -pole;
 }
 
-void OnePoleFilter::SetDecayFilter(float decayDb, float timeMs, float samplerate)
+void StaticOnePoleFilter::SetDecayFilter(float decayDb, float timeMs, float samplerate)
 {
     assert(decayDb < 0.f);
     const float lambda = std::log(std::pow(10.f, (decayDb / 20.f)));
@@ -55,7 +148,7 @@ void OnePoleFilter::SetDecayFilter(float decayDb, float timeMs, float samplerate
     SetPole(pole);
 }
 
-void OnePoleFilter::SetLowpass(float cutoff)
+void StaticOnePoleFilter::SetLowpass(float cutoff)
 {
     assert(cutoff >= 0.f && cutoff <= 1.f);
     const float wc = TWO_PI * cutoff;
@@ -64,54 +157,118 @@ void OnePoleFilter::SetLowpass(float cutoff)
     SetPole(1 - p);
 }
 
-float OnePoleFilter::Tick(float in)
+void StaticBiquad::SetCoefficients(float b0, float b1, float b2, float a1, float a2)
 {
-    outputs_[0] = gain_ * in * b_[0] - outputs_[1] * a_[1];
-    outputs_[1] = outputs_[0];
-    return outputs_[0];
+    b_[0] = b0;
+    b_[1] = b1;
+    b_[2] = b2;
+    a_[1] = a1;
+    a_[2] = a2;
 }
 
-float OneZeroFilter::Tick(float in)
+void StaticBiquad::SetCoefficients(const BiquadCoefficients& coeffs)
 {
-    float out = gain_ * in * b_[0] + inputs_[0] * b_[1];
-    inputs_[0] = in;
-    return out;
+    SetCoefficients(coeffs.b0, coeffs.b1, coeffs.b2, coeffs.a1, coeffs.a2);
 }
 
-float TwoPoleFilter::Tick(float in)
+void InterpolatedBiquad::SetCoefficients(const BiquadCoefficients& coeffs)
 {
-    outputs_[0] = gain_ * in * b_[0] - outputs_[1] * a_[1] - outputs_[2] * a_[2];
-    outputs_[2] = outputs_[1];
-    outputs_[1] = outputs_[0];
-    return outputs_[0];
+    current_ = coeffs;
+    target_ = coeffs;
+    ramping_ = false;
 }
 
-float TwoZeroFilter::Tick(float in)
+void InterpolatedBiquad::SetTarget(const BiquadCoefficients& coeffs)
 {
-    float out = gain_ * in * b_[0] + inputs_[0] * b_[1] + inputs_[1] * b_[2];
-    inputs_[1] = inputs_[0];
-    inputs_[0] = in;
-    return out;
+    target_ = coeffs;
+    ramping_ = true;
 }
 
-void Biquad::SetCoefficients(float b0, float b1, float b2, float a1, float a2)
+BiquadCoefficients InterpolatedBiquad::GetCoefficients() const
 {
-    b_[0] = b0;
-    b_[1] = b1;
-    b_[2] = b2;
-    a_[1] = a1;
-    a_[2] = a2;
+    return current_;
+}
+
+void InterpolatedBiquad::Reset()
+{
+    x1_ = 0.f;
+    x2_ = 0.f;
+    y1_ = 0.f;
+    y2_ = 0.f;
+}
+
+float InterpolatedBiquad::Tick(float in)
+{
+    const float out = current_.b0 * in + current_.b1 * x1_ + current_.b2 * x2_ - current_.a1 * y1_ - current_.a2 * y2_;
+    x2_ = x1_;
+    x1_ = in;
+    y2_ = y1_;
+    y1_ = out;
+    return out;
 }
 
-float Biquad::Tick(float in)
+void InterpolatedBiquad::ProcessBlock(const float* in, float* out, size_t size)
 {
-    inputs_[0] = gain_ * in;
-    outputs_[0] = inputs_[0] * b_[0] + inputs_[1] * b_[1] + inputs_[2] * b_[2];
-    outputs_[0] -= outputs_[1] * a_[1] + outputs_[2] * a_[2];
-    inputs_[2] = inputs_[1];
-    inputs_[1] = inputs_[0];
-    outputs_[2] = outputs_[1];
-    outputs_[1] = outputs_[0];
-    return outputs_[0];
+    assert(in != nullptr);
+    assert(out != nullptr);
+
+    if (size == 0)
+    {
+        return;
+    }
+
+    float b0 = current_.b0;
+    float b1 = current_.b1;
+    float b2 = current_.b2;
+    float a1 = current_.a1;
+    float a2 = current_.a2;
+
+    float db0 = 0.f;
+    float db1 = 0.f;
+    float db2 = 0.f;
+    float da1 = 0.f;
+    float da2 = 0.f;
+    if (ramping_)
+    {
+        const float inv_size = 1.f / static_cast<float>(size);
+        db0 = (target_.b0 - b0) * inv_size;
+        db1 = (target_.b1 - b1) * inv_size;
+        db2 = (target_.b2 - b2) * inv_size;
+        da1 = (target_.a1 - a1) * inv_size;
+        da2 = (target_.a2 - a2) * inv_size;
+    }
+
+    float x1 = x1_;
+    float x2 = x2_;
+    float y1 = y1_;
+    float y2 = y2_;
+    for (size_t i = 0; i < size; ++i)
+    {
+        b0 += db0;
+        b1 += db1;
+        b2 += db2;
+        a1 += da1;
+        a2 += da2;
+
+        const float x = in[i];
+        const float y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+        out[i] = y;
+    }
+
+    x1_ = x1;
+    x2_ = x2;
+    y1_ = y1;
+    y2_ = y2;
+
+    if (ramping_)
+    {
+        // Snap to the target to avoid accumulating rounding errors from the increments.
+        current_ = target_;
+        ramping_ = false;
+    }
 }
 } // namespace sfdsp
\ No newline at end of file
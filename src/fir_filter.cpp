@@ -0,0 +1,378 @@
+#include "fir_filter.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#include "dsp_utils.h"
+#include "simd.h"
+#include "window_functions.h"
+
+namespace
+{
+/// @brief Maximum number of samples processed at once by the direct form kernels.
+constexpr size_t kDirectBlockSize = 64;
+
+/// @brief Copy `count` taps in reverse order into a zero padded buffer of `padded` taps, so that the dot product
+/// with the input history ending at the newest sample computes the convolution.
+void ReverseTaps(const float* taps, size_t count, size_t stride, size_t offset, float* out, size_t padded)
+{
+    std::fill(out, out + padded, 0.f);
+    for (size_t k = 0; offset + k * stride < count; ++k)
+    {
+        out[padded - 1 - k] = taps[offset + k * stride];
+    }
+}
+} // namespace
+
+namespace sfdsp
+{
+
+void DesignLowpassFir(float* taps, size_t count, float cutoff, WindowType window, float gain, float kaiser_beta)
+{
+    assert(taps != nullptr);
+    assert(count > 0);
+    assert(cutoff > 0.f && cutoff <= 0.5f);
+
+    // Only the first half is evaluated and mirrored, so that the filter is exactly linear phase.
+    const float center = 0.5f * static_cast<float>(count - 1);
+    for (size_t i = 0; i < (count + 1) / 2; ++i)
+    {
+        const float t = static_cast<float>(i) - center;
+        const float sinc = (t == 0.f) ? 2.f * cutoff : std::sin(TWO_PI * cutoff * t) / (PI_F * t);
+
+        // Hann and Blackman are evaluated on count + 1 points so that the first and last taps are not zero.
+        float w = 1.f;
+        switch (window)
+        {
+        case WindowType::Rectangular:
+            break;
+        case WindowType::Hann:
+            w = Hann(static_cast<float>(i + 1), static_cast<float>(count + 1));
+            break;
+        case WindowType::Blackman:
+            w = Blackman(static_cast<float>(i + 1), static_cast<float>(count + 1));
+            break;
+        case WindowType::Kaiser:
+            w = (count > 1) ? Kaiser(static_cast<float>(i), static_cast<float>(count - 1), kaiser_beta) : 1.f;
+            break;
+        }
+
+        taps[i] = sinc * w;
+        taps[count - 1 - i] = taps[i];
+    }
+
+    float sum = 0.f;
+    for (size_t i = 0; i < count; ++i)
+    {
+        sum += taps[i];
+    }
+
+    // Normalize the DC gain.
+    const float scale = gain / sum;
+    for (size_t i = 0; i < count; ++i)
+    {
+        taps[i] *= scale;
+    }
+}
+
+void FirHistory::Init(size_t history, size_t max_block)
+{
+    history_ = history;
+    // Leave room for a few blocks so that the history is not moved on every call.
+    buffer_.assign(2 * history + 4 * max_block, 0.f);
+    write_ = history_;
+}
+
+void FirHistory::Reset()
+{
+    std::fill(buffer_.begin(), buffer_.end(), 0.f);
+    write_ = history_;
+}
+
+const float* FirHistory::Append(const float* in, size_t count)
+{
+    assert(count <= buffer_.size() - history_);
+
+    if (write_ + count > buffer_.size())
+    {
+        std::memmove(buffer_.data(), buffer_.data() + write_ - history_, history_ * sizeof(float));
+        write_ = history_;
+    }
+
+    float* dst = buffer_.data() + write_;
+    std::memcpy(dst, in, count * sizeof(float));
+    write_ += count;
+    return dst;
+}
+
+void FirFilter::SetTaps(const float* taps, size_t count)
+{
+    assert(taps != nullptr);
+    assert(count > 0);
+
+    tap_count_ = count;
+    if (count < kFftThreshold)
+    {
+        const size_t padded = simd::PaddedSize(count);
+        reversed_taps_.resize(padded);
+        ReverseTaps(taps, count, 1, 0, reversed_taps_.data(), padded);
+
+        fft_.reset();
+        taps_spectrum_.clear();
+        input_spectra_.clear();
+        partition_count_ = 0;
+        spectrum_.clear();
+        fft_buffer_.clear();
+        tail_.clear();
+        history_.Init(padded, kDirectBlockSize);
+        return;
+    }
+
+    // The first partition runs in the direct form so that the output has no latency.
+    constexpr size_t kPartition = kFftPartitionSize;
+    reversed_taps_.resize(kPartition);
+    ReverseTaps(taps, kPartition, 1, 0, reversed_taps_.data(), kPartition);
+
+    // Overlap-save: the FFT of 2 * kPartition samples times the spectrum of a zero padded partition gives
+    // kPartition valid outputs.
+    constexpr size_t kFftSize = 2 * kPartition;
+    constexpr size_t kBins = kFftSize / 2 + 1;
+    partition_count_ = (count - 1) / kPartition;
+    fft_ = std::make_unique<FFT>(kFftSize);
+    taps_spectrum_.resize(partition_count_ * kBins);
+    input_spectra_.resize(partition_count_ * kBins);
+    spectrum_.resize(kBins);
+    fft_buffer_.resize(kFftSize);
+    tail_.resize(kPartition);
+
+    for (size_t p = 0; p < partition_count_; ++p)
+    {
+        const size_t start = (p + 1) * kPartition;
+        const size_t length = std::min(kPartition, count - start);
+        std::fill(fft_buffer_.begin(), fft_buffer_.end(), 0.f);
+        std::copy(taps + start, taps + start + length, fft_buffer_.begin());
+        fft_->Forward(fft_buffer_.data(), taps_spectrum_.data() + p * kBins);
+    }
+
+    history_.Init(kFftSize, kPartition);
+    Reset();
+}
+
+size_t FirFilter::GetTapCount() const
+{
+    return tap_count_;
+}
+
+bool FirFilter::UsesFft() const
+{
+    return fft_ != nullptr;
+}
+
+void FirFilter::Reset()
+{
+    history_.Reset();
+    std::fill(input_spectra_.begin(), input_spectra_.end(), std::complex<float>(0.f));
+    std::fill(tail_.begin(), tail_.end(), 0.f);
+    newest_spectrum_ = 0;
+    position_ = 0;
+}
+
+float FirFilter::Tick(float in)
+{
+    assert(tap_count_ > 0);
+    if (UsesFft())
+    {
+        float out;
+        ProcessFft(&in, &out, 1);
+        return out;
+    }
+
+    const float* x = history_.Append(&in, 1);
+    const size_t padded = reversed_taps_.size();
+    return simd::Dot(reversed_taps_.data(), x + 1 - padded, padded);
+}
+
+void FirFilter::ProcessBlock(const float* in, float* out, size_t size)
+{
+    assert(tap_count_ > 0);
+    assert(in != nullptr);
+    assert(out != nullptr);
+
+    if (UsesFft())
+    {
+        ProcessFft(in, out, size);
+    }
+    else
+    {
+        ProcessDirect(in, out, size);
+    }
+}
+
+void FirFilter::ProcessDirect(const float* in, float* out, size_t size)
+{
+    const size_t padded = reversed_taps_.size();
+    while (size > 0)
+    {
+        const size_t block = std::min(size, kDirectBlockSize);
+        const float* x = history_.Append(in, block);
+        for (size_t i = 0; i < block; ++i)
+        {
+            out[i] = simd::Dot(reversed_taps_.data(), x + i + 1 - padded, padded);
+        }
+        in += block;
+        out += block;
+        size -= block;
+    }
+}
+
+void FirFilter::ProcessFft(const float* in, float* out, size_t size)
+{
+    constexpr size_t kPartition = kFftPartitionSize;
+
+    while (size > 0)
+    {
+        // Blocks never cross a partition boundary, where the tail is updated.
+        const size_t block = std::min(size, kPartition - position_);
+        const float* x = history_.Append(in, block);
+        for (size_t i = 0; i < block; ++i)
+        {
+            out[i] = simd::Dot(reversed_taps_.data(), x + i + 1 - kPartition, kPartition) + tail_[position_ + i];
+        }
+
+        position_ += block;
+        if (position_ == kPartition)
+        {
+            // The frame ends on the newest sample.
+            UpdateTail(x + block - 2 * kPartition);
+            position_ = 0;
+        }
+
+        in += block;
+        out += block;
+        size -= block;
+    }
+}
+
+void FirFilter::UpdateTail(const float* frame)
+{
+    constexpr size_t kBins = kFftPartitionSize + 1;
+
+    newest_spectrum_ = (newest_spectrum_ == 0) ? partition_count_ - 1 : newest_spectrum_ - 1;
+    fft_->Forward(frame, input_spectra_.data() + newest_spectrum_ * kBins);
+
+    // Partition p + 1 of the taps applies to the input delayed by p + 1 partitions: the newest spectrum is the input
+    // partition just completed, which is one partition before the next outputs.
+    std::fill(spectrum_.begin(), spectrum_.end(), std::complex<float>(0.f));
+    size_t slot = newest_spectrum_;
+    for (size_t p = 0; p < partition_count_; ++p)
+    {
+        const std::complex<float>* a = input_spectra_.data() + slot * kBins;
+        const std::complex<float>* b = taps_spectrum_.data() + p * kBins;
+        for (size_t k = 0; k < kBins; ++k)
+        {
+            const float re = spectrum_[k].real() + a[k].real() * b[k].real() - a[k].imag() * b[k].imag();
+            const float im = spectrum_[k].imag() + a[k].real() * b[k].imag() + a[k].imag() * b[k].real();
+            spectrum_[k] = {re, im};
+        }
+        slot = (slot + 1 == partition_count_) ? 0 : slot + 1;
+    }
+
+    // The first half of the circular convolution is aliased, the second half is the linear convolution.
+    fft_->Inverse(spectrum_.data(), fft_buffer_.data());
+    std::copy(fft_buffer_.begin() + kFftPartitionSize, fft_buffer_.end(), tail_.begin());
+}
+
+void FirDecimator::Init(size_t factor, const float* taps, size_t count)
+{
+    assert(factor > 0);
+    assert(taps != nullptr);
+    assert(count > 0);
+
+    factor_ = factor;
+    phase_ = 0;
+    const size_t padded = simd::PaddedSize(count);
+    reversed_taps_.resize(padded);
+    ReverseTaps(taps, count, 1, 0, reversed_taps_.data(), padded);
+    history_.Init(padded, kDirectBlockSize);
+}
+
+void FirDecimator::Reset()
+{
+    phase_ = 0;
+    history_.Reset();
+}
+
+size_t FirDecimator::ProcessBlock(const float* in, float* out, size_t size)
+{
+    assert(in != nullptr);
+    assert(out != nullptr);
+
+    const size_t padded = reversed_taps_.size();
+    size_t out_count = 0;
+    while (size > 0)
+    {
+        const size_t block = std::min(size, kDirectBlockSize);
+        const float* x = history_.Append(in, block);
+
+        // phase_ is the index of the first sample of the block, modulo the decimation factor.
+        size_t i = (phase_ == 0) ? 0 : factor_ - phase_;
+        for (; i < block; i += factor_)
+        {
+            out[out_count++] = simd::Dot(reversed_taps_.data(), x + i + 1 - padded, padded);
+        }
+        phase_ = (phase_ + block) % factor_;
+
+        in += block;
+        size -= block;
+    }
+    return out_count;
+}
+
+void FirInterpolator::Init(size_t factor, const float* taps, size_t count)
+{
+    assert(factor > 0);
+    assert(taps != nullptr);
+    assert(count > 0);
+
+    factor_ = factor;
+    phase_length_ = simd::PaddedSize((count + factor - 1) / factor);
+    phases_.resize(factor_ * phase_length_);
+
+    // Phase p holds the taps h[p], h[p + factor], h[p + 2 * factor], ...
+    for (size_t p = 0; p < factor_; ++p)
+    {
+        ReverseTaps(taps, count, factor_, p, phases_.data() + p * phase_length_, phase_length_);
+    }
+
+    history_.Init(phase_length_, kDirectBlockSize);
+}
+
+void FirInterpolator::Reset()
+{
+    history_.Reset();
+}
+
+void FirInterpolator::ProcessBlock(const float* in, float* out, size_t size)
+{
+    assert(in != nullptr);
+    assert(out != nullptr);
+
+    while (size > 0)
+    {
+        const size_t block = std::min(size, kDirectBlockSize);
+        const float* x = history_.Append(in, block);
+        for (size_t i = 0; i < block; ++i)
+        {
+            const float* window = x + i + 1 - phase_length_;
+            for (size_t p = 0; p < factor_; ++p)
+            {
+                *out++ = simd::Dot(phases_.data() + p * phase_length_, window, phase_length_);
+            }
+        }
+        in += block;
+        size -= block;
+    }
+}
+} // namespace sfdsp
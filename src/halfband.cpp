@@ -0,0 +1,383 @@
+#include "halfband.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+#include "simd.h"
+#include "window_functions.h"
+
+namespace
+{
+/// @brief Maximum number of output samples computed at once by the FIR kernels.
+constexpr size_t kChunkSize = 64;
+
+/// @brief Returns K for a half-band filter of 4 * K - 1 taps.
+size_t HalfLength(size_t tap_count)
+{
+    assert(tap_count >= 3 && (tap_count + 1) % 4 == 0);
+    return (tap_count + 1) / 4;
+}
+
+/// @brief Folded half-band convolution, vectorized over the outputs.
+/// @details Computes out[j] = sum_i taps[i] * (x[j - i] + x[j - (2K - 1 - i)]) for j in [0, count). `x` must have
+/// 2K - 1 valid samples before it.
+void FoldedConvolution(const float* x, const float* taps, size_t half_length, float* out, size_t count)
+{
+    using namespace sfdsp;
+
+    const size_t last = 2 * half_length - 1;
+    size_t j = 0;
+    for (; j + simd::kFloatWidth <= count; j += simd::kFloatWidth)
+    {
+        simd::float_v acc = simd::Zero();
+        for (size_t i = 0; i < half_length; ++i)
+        {
+            const simd::float_v pair = simd::Add(simd::Load(x + j - i), simd::Load(x + j - (last - i)));
+            acc = simd::MulAdd(simd::Broadcast(taps[i]), pair, acc);
+        }
+        simd::Store(out + j, acc);
+    }
+
+    for (; j < count; ++j)
+    {
+        float acc = 0.f;
+        for (size_t i = 0; i < half_length; ++i)
+        {
+            acc += taps[i] * (x[j - i] + x[j - (last - i)]);
+        }
+        out[j] = acc;
+    }
+}
+
+// Polyphase IIR design, after the elliptic filter derivation of HIIR's PolyphaseIir2Designer.
+double AccumulateNumerator(double q, int order, int c)
+{
+    double acc = 0.0;
+    int i = 0;
+    int sign = 1;
+    double term = 0.0;
+    do
+    {
+        term = std::pow(q, i * (i + 1)) * std::sin((i * 2 + 1) * c * std::numbers::pi / order) * sign;
+        acc += term;
+        sign = -sign;
+        ++i;
+    } while (std::abs(term) > 1e-100);
+    return acc;
+}
+
+double AccumulateDenominator(double q, int order, int c)
+{
+    double acc = 0.0;
+    int i = 1;
+    int sign = -1;
+    double term = 0.0;
+    do
+    {
+        term = std::pow(q, i * i) * std::cos(i * 2 * c * std::numbers::pi / order) * sign;
+        acc += term;
+        sign = -sign;
+        ++i;
+    } while (std::abs(term) > 1e-100);
+    return acc;
+}
+
+/// @brief Runs the allpass sections of both paths over a block.
+/// @details The coefficient count is a template parameter so that the sections are unrolled and their state stays
+/// in registers. Even coefficients go to the first path and odd coefficients to the second. Each section is a first
+/// order allpass (a + z^-1) / (1 + a z^-1) running at the low rate. `x1[k]` is the previous input of section k,
+/// which is also the previous output of section k - 2.
+template <size_t Count, bool Decimate>
+void IirKernel(sfdsp::HalfbandIirPaths& paths, const float* in, float* out, size_t size)
+{
+    std::array<float, Count> coefs;
+    std::array<float, Count + 2> x1;
+    std::copy(paths.coefs.begin(), paths.coefs.begin() + Count, coefs.begin());
+    std::copy(paths.x1.begin(), paths.x1.begin() + Count + 2, x1.begin());
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        float path[2];
+        if constexpr (Decimate)
+        {
+            path[0] = in[2 * i + 1];
+            path[1] = in[2 * i];
+        }
+        else
+        {
+            path[0] = in[i];
+            path[1] = in[i];
+        }
+
+        for (size_t k = 0; k < Count; ++k)
+        {
+            float& v = path[k & 1];
+            const float y = (v - x1[k + 2]) * coefs[k] + x1[k];
+            x1[k] = v;
+            v = y;
+        }
+        x1[Count] = path[Count & 1];
+        x1[Count + 1] = path[(Count + 1) & 1];
+
+        if constexpr (Decimate)
+        {
+            out[i] = 0.5f * (path[0] + path[1]);
+        }
+        else
+        {
+            out[2 * i] = path[0];
+            out[2 * i + 1] = path[1];
+        }
+    }
+
+    std::copy(x1.begin(), x1.end(), paths.x1.begin());
+}
+
+using IirKernelFn = void (*)(sfdsp::HalfbandIirPaths&, const float*, float*, size_t);
+
+template <bool Decimate, size_t... I>
+constexpr std::array<IirKernelFn, sizeof...(I)> MakeIirKernels(std::index_sequence<I...>)
+{
+    return {&IirKernel<I + 1, Decimate>...};
+}
+} // namespace
+
+namespace sfdsp
+{
+
+std::vector<float> DesignHalfbandFir(size_t tap_count, float kaiser_beta)
+{
+    const size_t half_length = HalfLength(tap_count);
+    const double center = static_cast<double>(tap_count - 1) / 2.0;
+
+    // Ideal half-band lowpass, 0.5 * sinc(n / 2), windowed. Only the taps at odd distances from the center are
+    // non-zero.
+    std::vector<double> taps(2 * half_length);
+    double sum = 0.0;
+    for (size_t i = 0; i < half_length; ++i)
+    {
+        const double n = static_cast<double>(2 * i) - center;
+        const double sinc = std::sin(std::numbers::pi * n / 2.0) / (std::numbers::pi * n);
+        const double w = Kaiser(static_cast<float>(2 * i), static_cast<float>(tap_count - 1), kaiser_beta);
+        taps[i] = sinc * w;
+        taps[taps.size() - 1 - i] = taps[i];
+        sum += 2.0 * taps[i];
+    }
+
+    // Together with the 0.5 center tap, the filter has unity gain at DC.
+    std::vector<float> result(taps.size());
+    for (size_t i = 0; i < taps.size(); ++i)
+    {
+        result[i] = static_cast<float>(0.5 * taps[i] / sum);
+    }
+    return result;
+}
+
+size_t DesignHalfbandIir(float* coefs, size_t max_count, float attenuation_db, float transition)
+{
+    assert(coefs != nullptr);
+    assert(transition > 0.f && transition < 0.5f);
+
+    double k = std::tan((1.0 - transition * 2.0) * std::numbers::pi / 4.0);
+    k *= k;
+    const double kksqrt = std::pow(1.0 - k * k, 0.25);
+    const double e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+    const double e2 = e * e;
+    const double e4 = e2 * e2;
+    const double q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+
+    const double attenuation = std::pow(10.0, -attenuation_db / 10.0);
+    const double a = attenuation / (1.0 - attenuation);
+    int order = static_cast<int>(std::ceil(std::log(a * a / 16.0) / std::log(q)));
+    order = std::max(order | 1, 3);
+
+    const size_t count = std::min(static_cast<size_t>(order - 1) / 2, max_count);
+    order = static_cast<int>(count) * 2 + 1;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const int c = static_cast<int>(i) + 1;
+        const double num = AccumulateNumerator(q, order, c) * std::pow(q, 0.25);
+        const double den = AccumulateDenominator(q, order, c) + 0.5;
+        const double ww = num / den;
+        const double wwsq = ww * ww;
+        const double x = std::sqrt((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+        coefs[i] = static_cast<float>((1.0 - x) / (1.0 + x));
+    }
+    return count;
+}
+
+void HalfbandFirDecimator::Init(size_t tap_count, float kaiser_beta)
+{
+    taps_ = DesignHalfbandFir(tap_count, kaiser_beta);
+    const size_t half_length = taps_.size() / 2;
+    even_.Init(2 * half_length - 1, kChunkSize);
+    odd_.Init(half_length, kChunkSize);
+}
+
+void HalfbandFirDecimator::Reset()
+{
+    even_.Reset();
+    odd_.Reset();
+}
+
+float HalfbandFirDecimator::GetLatency() const
+{
+    return static_cast<float>(taps_.size() - 1) / 2.f;
+}
+
+void HalfbandFirDecimator::ProcessBlock(const float* in, float* out, size_t size)
+{
+    assert(!taps_.empty());
+    assert(in != nullptr);
+    assert(out != nullptr);
+
+    const size_t half_length = taps_.size() / 2;
+    float even[kChunkSize];
+    float odd[kChunkSize];
+
+    while (size > 0)
+    {
+        const size_t count = std::min(size, kChunkSize);
+        for (size_t i = 0; i < count; ++i)
+        {
+            even[i] = in[2 * i];
+            odd[i] = in[2 * i + 1];
+        }
+
+        // y[m] = sum_i h[2i] * x[2m - 2i] + 0.5 * x[2m - (2K - 1)]: the non-zero taps only see the even samples
+        // and the center tap only sees the odd ones.
+        const float* x_even = even_.Append(even, count);
+        const float* x_odd = odd_.Append(odd, count) - half_length;
+        FoldedConvolution(x_even, taps_.data(), half_length, out, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[i] += 0.5f * x_odd[i];
+        }
+
+        in += 2 * count;
+        out += count;
+        size -= count;
+    }
+}
+
+void HalfbandFirInterpolator::Init(size_t tap_count, float kaiser_beta)
+{
+    taps_ = DesignHalfbandFir(tap_count, kaiser_beta);
+    // Zero stuffing halves the signal energy, the taps get a gain of 2 to compensate.
+    for (auto& tap : taps_)
+    {
+        tap *= 2.f;
+    }
+    history_.Init(taps_.size() - 1, kChunkSize);
+}
+
+void HalfbandFirInterpolator::Reset()
+{
+    history_.Reset();
+}
+
+float HalfbandFirInterpolator::GetLatency() const
+{
+    return static_cast<float>(taps_.size() - 1) / 2.f;
+}
+
+void HalfbandFirInterpolator::ProcessBlock(const float* in, float* out, size_t size)
+{
+    assert(!taps_.empty());
+    assert(in != nullptr);
+    assert(out != nullptr);
+
+    const size_t half_length = taps_.size() / 2;
+    float filtered[kChunkSize];
+
+    while (size > 0)
+    {
+        const size_t count = std::min(size, kChunkSize);
+        const float* x = history_.Append(in, count);
+
+        // The even outputs go through the non-zero taps, the odd outputs only through the center tap.
+        FoldedConvolution(x, taps_.data(), half_length, filtered, count);
+        const float* delayed = x - (half_length - 1);
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[2 * i] = filtered[i];
+            out[2 * i + 1] = delayed[i];
+        }
+
+        in += count;
+        out += 2 * count;
+        size -= count;
+    }
+}
+
+void HalfbandIirPaths::Init(const float* c, size_t n)
+{
+    assert(n > 0 && n <= kMaxHalfbandIirCoefs);
+    count = n;
+    std::copy(c, c + n, coefs.begin());
+    Reset();
+}
+
+void HalfbandIirPaths::Reset()
+{
+    x1.fill(0.f);
+}
+
+void HalfbandIirDecimator::Init(float attenuation_db, float transition)
+{
+    float coefs[kMaxHalfbandIirCoefs];
+    const size_t count = DesignHalfbandIir(coefs, kMaxHalfbandIirCoefs, attenuation_db, transition);
+    paths_.Init(coefs, count);
+}
+
+void HalfbandIirDecimator::Reset()
+{
+    paths_.Reset();
+}
+
+size_t HalfbandIirDecimator::GetCoefficientCount() const
+{
+    return paths_.count;
+}
+
+void HalfbandIirDecimator::ProcessBlock(const float* in, float* out, size_t size)
+{
+    assert(in != nullptr);
+    assert(out != nullptr);
+    assert(paths_.count > 0);
+
+    static constexpr auto kKernels = MakeIirKernels<true>(std::make_index_sequence<kMaxHalfbandIirCoefs>());
+    kKernels[paths_.count - 1](paths_, in, out, size);
+}
+
+void HalfbandIirInterpolator::Init(float attenuation_db, float transition)
+{
+    float coefs[kMaxHalfbandIirCoefs];
+    const size_t count = DesignHalfbandIir(coefs, kMaxHalfbandIirCoefs, attenuation_db, transition);
+    paths_.Init(coefs, count);
+}
+
+void HalfbandIirInterpolator::Reset()
+{
+    paths_.Reset();
+}
+
+size_t HalfbandIirInterpolator::GetCoefficientCount() const
+{
+    return paths_.count;
+}
+
+void HalfbandIirInterpolator::ProcessBlock(const float* in, float* out, size_t size)
+{
+    assert(in != nullptr);
+    assert(out != nullptr);
+    assert(paths_.count > 0);
+
+    static constexpr auto kKernels = MakeIirKernels<false>(std::make_index_sequence<kMaxHalfbandIirCoefs>());
+    kKernels[paths_.count - 1](paths_, in, out, size);
+}
+} // namespace sfdsp
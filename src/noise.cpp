@@ -0,0 +1,139 @@
+#include "noise.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+/// @brief Scales a signed 32 bit integer to [-1, 1).
+constexpr float kIntToFloat = 1.f / 2147483648.f;
+
+/// @brief splitmix32 style hash, spreads one seed over the lanes.
+uint32_t HashSeed(uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35u;
+    x ^= x >> 16;
+    return x;
+}
+
+/// @brief Paul Kellet's refined pink noise filter, from the music-dsp mailing list.
+float KelletFilter(std::array<float, 7>& state, float white)
+{
+    state[0] = 0.99886f * state[0] + white * 0.0555179f;
+    state[1] = 0.99332f * state[1] + white * 0.0750759f;
+    state[2] = 0.96900f * state[2] + white * 0.1538520f;
+    state[3] = 0.86650f * state[3] + white * 0.3104856f;
+    state[4] = 0.55000f * state[4] + white * 0.5329522f;
+    state[5] = -0.7616f * state[5] - white * 0.0168980f;
+    const float pink = state[0] + state[1] + state[2] + state[3] + state[4] + state[5] + state[6] + white * 0.5362f;
+    state[6] = white * 0.115926f;
+
+    // The filter has a gain of about 9 at its peak, bring uniform white noise back to roughly [-1, 1].
+    constexpr float kOutputGain = 0.11f;
+    return pink * kOutputGain;
+}
+} // namespace
+
+namespace sfdsp
+{
+
+NoiseGenerator::NoiseGenerator()
+{
+    Seed(kDefaultSeed);
+}
+
+NoiseGenerator::NoiseGenerator(uint32_t seed)
+{
+    Seed(seed);
+}
+
+void NoiseGenerator::Seed(uint32_t seed)
+{
+    for (size_t lane = 0; lane < kLaneCount; ++lane)
+    {
+        const uint32_t state = HashSeed(seed + static_cast<uint32_t>(lane + 1) * 0x9E3779B9u);
+        // Zero is the only state xorshift never leaves.
+        state_[lane] = (state == 0) ? 0x9E3779B9u : state;
+    }
+    pending_index_ = kLaneCount;
+}
+
+void NoiseGenerator::Step(float* out)
+{
+    // Plain loops over the lanes, compilers turn them into vector shifts, xors and conversions.
+    for (size_t lane = 0; lane < kLaneCount; ++lane)
+    {
+        uint32_t x = state_[lane];
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        state_[lane] = x;
+    }
+    for (size_t lane = 0; lane < kLaneCount; ++lane)
+    {
+        out[lane] = static_cast<float>(static_cast<int32_t>(state_[lane])) * kIntToFloat;
+    }
+}
+
+float NoiseGenerator::Tick()
+{
+    if (pending_index_ == kLaneCount)
+    {
+        Step(pending_.data());
+        pending_index_ = 0;
+    }
+    return pending_[pending_index_++];
+}
+
+void NoiseGenerator::Fill(float* out, size_t size)
+{
+    assert(out != nullptr);
+
+    // Finish the samples left by `Tick` first, to keep the sequence identical.
+    const size_t pending = std::min(size, kLaneCount - pending_index_);
+    std::copy(pending_.begin() + pending_index_, pending_.begin() + pending_index_ + pending, out);
+    pending_index_ += pending;
+
+    size_t i = pending;
+    for (; i + kLaneCount <= size; i += kLaneCount)
+    {
+        Step(out + i);
+    }
+    for (; i < size; ++i)
+    {
+        out[i] = Tick();
+    }
+}
+
+PinkNoise::PinkNoise(uint32_t seed) : white_(seed)
+{
+}
+
+void PinkNoise::Seed(uint32_t seed)
+{
+    white_.Seed(seed);
+    state_.fill(0.f);
+}
+
+float PinkNoise::Tick()
+{
+    return KelletFilter(state_, white_.Tick());
+}
+
+void PinkNoise::Fill(float* out, size_t size)
+{
+    white_.Fill(out, size);
+
+    // Local copy of the state, so that it stays in registers while writing to `out`.
+    auto state = state_;
+    for (size_t i = 0; i < size; ++i)
+    {
+        out[i] = KelletFilter(state, out[i]);
+    }
+    state_ = state;
+}
+
+} // namespace sfdsp
@@ -0,0 +1,293 @@
+#include "oscillator_bank.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+#include "simd.h"
+
+namespace
+{
+/// @brief Returns the per-sample step that reaches `target` from `value` after `1 / scale` samples.
+sfdsp::simd::float_v RampStep(sfdsp::simd::float_v value, sfdsp::simd::float_v target, sfdsp::simd::float_v scale)
+{
+    using namespace sfdsp::simd;
+    return Mul(Sub(target, value), scale);
+}
+
+/// @brief Wraps a phase that moved by less than one period back into [0, 1], cheaper than `Floor` without SSE4.1.
+sfdsp::simd::float_v Wrap(sfdsp::simd::float_v phase)
+{
+    using namespace sfdsp::simd;
+    const float_v one = Broadcast(1.f);
+    phase = Select(CmpGt(phase, one), Sub(phase, one), phase);
+    return Select(CmpLt(phase, Zero()), Add(phase, one), phase);
+}
+
+/// @brief The target amplitude, or 0 for partials at or above the Nyquist frequency.
+sfdsp::simd::float_v AudibleAmplitude(sfdsp::simd::float_v target_amplitude, sfdsp::simd::float_v target_increment)
+{
+    using namespace sfdsp::simd;
+    return Select(CmpLt(Abs(target_increment), Broadcast(0.5f)), target_amplitude, Zero());
+}
+} // namespace
+
+namespace sfdsp
+{
+
+void OscillatorBank::Init(float samplerate, size_t partial_count, Mode mode, SineAccuracy accuracy)
+{
+    samplerate_ = samplerate;
+    partial_count_ = partial_count;
+    mode_ = mode;
+    accuracy_ = accuracy;
+
+    constexpr size_t kPassWidth = kGroupsPerPass * simd::kFloatWidth;
+    const size_t padded_count = (partial_count + kPassWidth - 1) / kPassWidth * kPassWidth;
+    increment_.assign(padded_count, 0.f);
+    target_increment_.assign(padded_count, 0.f);
+    amplitude_.assign(padded_count, 0.f);
+    target_amplitude_.assign(padded_count, 0.f);
+    phase_.assign(padded_count, 0.f);
+    re_.assign(padded_count, 1.f);
+    im_.assign(padded_count, 0.f);
+    cos_.assign(padded_count, 1.f);
+    sin_.assign(padded_count, 0.f);
+    target_cos_.assign(padded_count, 1.f);
+    target_sin_.assign(padded_count, 0.f);
+    rotations_dirty_ = false;
+
+    lane_sums_.assign(kRenormalizeInterval * simd::kFloatWidth, 0.f);
+    chunk_phases_.assign(kRenormalizeInterval * kPassWidth, 0.f);
+}
+
+size_t OscillatorBank::GetPartialCount() const
+{
+    return partial_count_;
+}
+
+void OscillatorBank::SetFrequency(size_t partial, float frequency)
+{
+    assert(partial < partial_count_);
+    target_increment_[partial] = frequency / samplerate_;
+    rotations_dirty_ = true;
+}
+
+void OscillatorBank::SetAmplitude(size_t partial, float amplitude)
+{
+    assert(partial < partial_count_);
+    target_amplitude_[partial] = amplitude;
+}
+
+void OscillatorBank::SetPartial(size_t partial, float frequency, float amplitude)
+{
+    assert(partial < partial_count_);
+    const float increment = frequency / samplerate_;
+    increment_[partial] = target_increment_[partial] = increment;
+    amplitude_[partial] = (std::fabs(increment) < 0.5f) ? amplitude : 0.f;
+    target_amplitude_[partial] = amplitude;
+    // Any error of the rotation accumulates as a phase drift, use the most accurate kernel.
+    Cosine(&increment, &target_cos_[partial], 1, SineAccuracy::High);
+    Sine(&increment, &target_sin_[partial], 1, SineAccuracy::High);
+    cos_[partial] = target_cos_[partial];
+    sin_[partial] = target_sin_[partial];
+}
+
+void OscillatorBank::SetPhase(size_t partial, float phase)
+{
+    assert(partial < partial_count_);
+    phase_[partial] = phase - std::floor(phase);
+    Cosine(&phase, &re_[partial], 1, SineAccuracy::High);
+    Sine(&phase, &im_[partial], 1, SineAccuracy::High);
+}
+
+void OscillatorBank::Reset()
+{
+    std::fill(phase_.begin(), phase_.end(), 0.f);
+    std::fill(re_.begin(), re_.end(), 1.f);
+    std::fill(im_.begin(), im_.end(), 0.f);
+}
+
+void OscillatorBank::ProcessBlock(float* out, size_t size)
+{
+    assert(out != nullptr);
+    if (mode_ == Mode::Rotator && rotations_dirty_)
+    {
+        UpdateRotations();
+    }
+
+    for (size_t offset = 0; offset < size; offset += kRenormalizeInterval)
+    {
+        const size_t count = std::min(kRenormalizeInterval, size - offset);
+
+        // The ramps restart from the current values at every chunk and reach the targets at the end of the block.
+        const float ramp_scale = 1.f / static_cast<float>(size - offset);
+        std::fill(lane_sums_.begin(), lane_sums_.begin() + count * simd::kFloatWidth, 0.f);
+        if (mode_ == Mode::Rotator)
+        {
+            RenderRotator(count, ramp_scale);
+        }
+        else
+        {
+            RenderPolynomial(count, ramp_scale);
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[offset + i] = simd::ReduceAdd(simd::Load(&lane_sums_[i * simd::kFloatWidth]));
+        }
+    }
+
+    if (mode_ == Mode::Rotator && size > 0)
+    {
+        // The rotations reached their targets, drop the rounding errors accumulated by the ramps.
+        cos_ = target_cos_;
+        sin_ = target_sin_;
+    }
+}
+
+void OscillatorBank::RenderPolynomial(size_t size, float ramp_scale)
+{
+    // The phase accumulation is a dependency chain through the add and the wrap, interleave a few groups of partials
+    // to keep the vector units busy.
+    constexpr size_t kInterleave = kGroupsPerPass;
+    constexpr size_t kStride = kInterleave * simd::kFloatWidth;
+
+    const simd::float_v scale = simd::Broadcast(ramp_scale);
+    for (size_t p = 0; p < phase_.size(); p += kStride)
+    {
+        simd::float_v phase[kInterleave];
+        simd::float_v increment[kInterleave];
+        simd::float_v increment_step[kInterleave];
+        simd::float_v amplitude[kInterleave];
+        simd::float_v amplitude_step[kInterleave];
+        for (size_t k = 0; k < kInterleave; ++k)
+        {
+            const size_t index = p + k * simd::kFloatWidth;
+            const simd::float_v target_increment = simd::Load(&target_increment_[index]);
+            phase[k] = simd::Load(&phase_[index]);
+            increment[k] = simd::Load(&increment_[index]);
+            increment_step[k] = RampStep(increment[k], target_increment, scale);
+            amplitude[k] = simd::Load(&amplitude_[index]);
+            amplitude_step[k] = RampStep(
+                amplitude[k], AudibleAmplitude(simd::Load(&target_amplitude_[index]), target_increment), scale);
+        }
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            for (size_t k = 0; k < kInterleave; ++k)
+            {
+                increment[k] = simd::Add(increment[k], increment_step[k]);
+                simd::Store(&chunk_phases_[i * kStride + k * simd::kFloatWidth], phase[k]);
+                phase[k] = Wrap(simd::Add(phase[k], increment[k]));
+            }
+        }
+
+        Sine(chunk_phases_.data(), chunk_phases_.data(), size * kStride, accuracy_);
+        for (size_t i = 0; i < size; ++i)
+        {
+            float* sum = &lane_sums_[i * simd::kFloatWidth];
+            simd::float_v acc = simd::Load(sum);
+            for (size_t k = 0; k < kInterleave; ++k)
+            {
+                amplitude[k] = simd::Add(amplitude[k], amplitude_step[k]);
+                acc = simd::MulAdd(simd::Load(&chunk_phases_[i * kStride + k * simd::kFloatWidth]), amplitude[k], acc);
+            }
+            simd::Store(sum, acc);
+        }
+
+        for (size_t k = 0; k < kInterleave; ++k)
+        {
+            const size_t index = p + k * simd::kFloatWidth;
+            simd::Store(&phase_[index], phase[k]);
+            simd::Store(&increment_[index], increment[k]);
+            simd::Store(&amplitude_[index], amplitude[k]);
+        }
+    }
+}
+
+void OscillatorBank::RenderRotator(size_t size, float ramp_scale)
+{
+    // Two groups of partials per pass, more would not fit in the vector registers.
+    constexpr size_t kInterleave = 2;
+    static_assert(kGroupsPerPass % kInterleave == 0);
+
+    const simd::float_v scale = simd::Broadcast(ramp_scale);
+    for (size_t p = 0; p < re_.size(); p += kInterleave * simd::kFloatWidth)
+    {
+        simd::float_v re[kInterleave];
+        simd::float_v im[kInterleave];
+        simd::float_v c[kInterleave];
+        simd::float_v s[kInterleave];
+        simd::float_v step_c[kInterleave];
+        simd::float_v step_s[kInterleave];
+        simd::float_v amplitude[kInterleave];
+        simd::float_v amplitude_step[kInterleave];
+        simd::float_v increment_step[kInterleave];
+        for (size_t k = 0; k < kInterleave; ++k)
+        {
+            const size_t index = p + k * simd::kFloatWidth;
+            const simd::float_v target_increment = simd::Load(&target_increment_[index]);
+            re[k] = simd::Load(&re_[index]);
+            im[k] = simd::Load(&im_[index]);
+            c[k] = simd::Load(&cos_[index]);
+            s[k] = simd::Load(&sin_[index]);
+            amplitude[k] = simd::Load(&amplitude_[index]);
+            amplitude_step[k] = RampStep(
+                amplitude[k], AudibleAmplitude(simd::Load(&target_amplitude_[index]), target_increment), scale);
+            increment_step[k] = RampStep(simd::Load(&increment_[index]), target_increment, scale);
+
+            // A linear frequency ramp rotates the rotation itself by a constant angle every sample. The angle is at
+            // most pi / size, a short series is exact to float precision.
+            const simd::float_v angle = simd::Mul(increment_step[k], simd::Broadcast(2.f * std::numbers::pi_v<float>));
+            const simd::float_v angle2 = simd::Mul(angle, angle);
+            step_c[k] = simd::MulAdd(angle2, simd::MulAdd(angle2, simd::Broadcast(1.f / 24.f), simd::Broadcast(-0.5f)),
+                                     simd::Broadcast(1.f));
+            step_s[k] = simd::Mul(angle, simd::MulAdd(angle2, simd::Broadcast(-1.f / 6.f), simd::Broadcast(1.f)));
+        }
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            float* sum = &lane_sums_[i * simd::kFloatWidth];
+            simd::float_v acc = simd::Load(sum);
+            for (size_t k = 0; k < kInterleave; ++k)
+            {
+                const simd::float_v next_c = simd::Sub(simd::Mul(c[k], step_c[k]), simd::Mul(s[k], step_s[k]));
+                s[k] = simd::MulAdd(c[k], step_s[k], simd::Mul(s[k], step_c[k]));
+                c[k] = next_c;
+                amplitude[k] = simd::Add(amplitude[k], amplitude_step[k]);
+                acc = simd::MulAdd(amplitude[k], im[k], acc);
+
+                const simd::float_v next_re = simd::Sub(simd::Mul(re[k], c[k]), simd::Mul(im[k], s[k]));
+                im[k] = simd::MulAdd(re[k], s[k], simd::Mul(im[k], c[k]));
+                re[k] = next_re;
+            }
+            simd::Store(sum, acc);
+        }
+
+        for (size_t k = 0; k < kInterleave; ++k)
+        {
+            // One Newton step towards |re + j im| = 1, the magnitude only drifts by rounding errors between two calls.
+            const size_t index = p + k * simd::kFloatWidth;
+            const simd::float_v magnitude = simd::MulAdd(re[k], re[k], simd::Mul(im[k], im[k]));
+            const simd::float_v gain = simd::Sub(simd::Broadcast(1.5f), simd::Mul(simd::Broadcast(0.5f), magnitude));
+            simd::Store(&re_[index], simd::Mul(re[k], gain));
+            simd::Store(&im_[index], simd::Mul(im[k], gain));
+            simd::Store(&cos_[index], c[k]);
+            simd::Store(&sin_[index], s[k]);
+            simd::Store(&increment_[index], simd::MulAdd(increment_step[k], simd::Broadcast(static_cast<float>(size)),
+                                                         simd::Load(&increment_[index])));
+            simd::Store(&amplitude_[index], amplitude[k]);
+        }
+    }
+}
+
+void OscillatorBank::UpdateRotations()
+{
+    Cosine(target_increment_.data(), target_cos_.data(), target_increment_.size(), SineAccuracy::High);
+    Sine(target_increment_.data(), target_sin_.data(), target_increment_.size(), SineAccuracy::High);
+    rotations_dirty_ = false;
+}
+
+} // namespace sfdsp
@@ -0,0 +1,110 @@
+#include "parallel_filter.h"
+
+#include <cmath>
+#include <complex>
+
+namespace
+{
+using complex = std::complex<double>;
+
+// Evaluate a second order polynomial c0 + c1 w + c2 w^2.
+complex Polynomial(double c0, double c1, double c2, complex w)
+{
+    return c0 + w * (c1 + w * c2);
+}
+} // namespace
+
+namespace sfdsp
+{
+
+bool CascadeToParallel(const BiquadCoefficients* cascade, size_t count, float gain, BiquadCoefficients* parallel,
+                       float& direct_gain)
+{
+    assert(cascade != nullptr);
+    assert(parallel != nullptr);
+
+    // Work with w = z^-1. Each denominator factors as 1 + a1 w + a2 w^2 = (1 - p1 w)(1 - p2 w) where p1 and p2 are
+    // the poles of the section: p1 + p2 = -a1 and p1 * p2 = a2.
+    constexpr size_t kMaxSections = 64;
+    assert(count <= kMaxSections);
+    if (count > kMaxSections)
+    {
+        return false;
+    }
+
+    complex poles[2 * kMaxSections];
+    double leading_b = gain;
+    double leading_a = 1.0;
+    for (size_t k = 0; k < count; ++k)
+    {
+        const double a1 = cascade[k].a1;
+        const double a2 = cascade[k].a2;
+        if (a2 == 0.0)
+        {
+            return false;
+        }
+
+        const complex root = std::sqrt(complex(a1 * a1 - 4.0 * a2, 0.0));
+        poles[2 * k] = (-a1 + root) * 0.5;
+        poles[2 * k + 1] = (-a1 - root) * 0.5;
+
+        leading_b *= cascade[k].b2;
+        leading_a *= a2;
+    }
+
+    const size_t pole_count = 2 * count;
+    for (size_t i = 0; i < pole_count; ++i)
+    {
+        for (size_t j = i + 1; j < pole_count; ++j)
+        {
+            if (std::abs(poles[i] - poles[j]) < 1e-9)
+            {
+                return false;
+            }
+        }
+    }
+
+    // The numerator and denominator have the same order, the quotient is the ratio of the highest order coefficients.
+    direct_gain = static_cast<float>(leading_b / leading_a);
+
+    // Residue of the pole p_i: r_i = B(1/p_i) / prod_{j != i}(1 - p_j / p_i)
+    complex residues[2 * kMaxSections];
+    for (size_t i = 0; i < pole_count; ++i)
+    {
+        const complex w = 1.0 / poles[i];
+        complex num = gain;
+        for (size_t k = 0; k < count; ++k)
+        {
+            num *= Polynomial(cascade[k].b0, cascade[k].b1, cascade[k].b2, w);
+        }
+
+        complex den = 1.0;
+        for (size_t j = 0; j < pole_count; ++j)
+        {
+            if (j != i)
+            {
+                den *= 1.0 - poles[j] * w;
+            }
+        }
+        residues[i] = num / den;
+    }
+
+    // Recombine the pole pairs of each section:
+    // r1 / (1 - p1 w) + r2 / (1 - p2 w) = (r1 + r2 - (r1 p2 + r2 p1) w) / (1 + a1 w + a2 w^2)
+    for (size_t k = 0; k < count; ++k)
+    {
+        const complex p1 = poles[2 * k];
+        const complex p2 = poles[2 * k + 1];
+        const complex r1 = residues[2 * k];
+        const complex r2 = residues[2 * k + 1];
+
+        parallel[k].b0 = static_cast<float>((r1 + r2).real());
+        parallel[k].b1 = static_cast<float>(-(r1 * p2 + r2 * p1).real());
+        parallel[k].b2 = 0.f;
+        parallel[k].a1 = cascade[k].a1;
+        parallel[k].a2 = cascade[k].a2;
+    }
+
+    return true;
+}
+} // namespace sfdsp
@@ -13,11 +13,19 @@
 #include "phaseshapers.h"
 
 #include <algorithm>
+#include <array>
+#include <cassert>
 #include <cmath>
+#include <complex>
 #include <cstdint>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "basic_oscillators.h"
+#include "fft.h"
+#include "simd.h"
 
 #define G_B(x) (2 * (x)-1)
 #define MODM(x, m) (x - m * std::floor(x / m))
@@ -75,6 +83,12 @@ inline float g_vtri(float x, float phaseIncrement, float w = 0.5f, float a1 = 1.
 
 inline float g_ripple(float x, float m = 1.f)
 {
+    // Without ripples the modulo divides by 0, the limit is the plain ramp.
+    if (m <= 0.f)
+    {
+        return G_B(x);
+    }
+
     // Orignal equation was 'x+MODM(x,m)', but I found that subtracting the modulo resulted in the same output but
     // without clipping.
     return G_B(x - MODM(x, m));
@@ -114,6 +128,524 @@ float polyBLEP(float x, float phase, float T, float h = -1.f)
     return s;
 }
 
+namespace
+{
+using Waveform = sfdsp::Phaseshaper::Waveform;
+using sfdsp::simd::float_v;
+
+// -- Vector versions of the helpers above, evaluated in the same order so that the block kernels match `Process`.
+
+float_v Mod1(float_v x)
+{
+    using namespace sfdsp::simd;
+    return Sub(x, Floor(x));
+}
+
+float_v ModM(float_v x, float_v m)
+{
+    using namespace sfdsp::simd;
+    return Sub(x, Mul(m, Floor(Div(x, m))));
+}
+
+float_v Bipolar(float_v x)
+{
+    using namespace sfdsp::simd;
+    return Sub(Mul(Broadcast(2.f), x), Broadcast(1.f));
+}
+
+/// @brief `MOD1(|2x - 1|)`, the unscaled `g_tri`.
+float_v Tri(float_v x, float_v a1)
+{
+    using namespace sfdsp::simd;
+    return Mod1(Mul(a1, Abs(Bipolar(x))));
+}
+
+/// @brief Correction added by `polyBLEP` for a phase in [0, 1). Lanes away from the discontinuity get 0.
+float_v PolyBlepCorrection(float_v p, float_v inc, float h)
+{
+    using namespace sfdsp::simd;
+    const mask_v upper = CmpGt(p, Sub(Broadcast(1.f), inc));
+    const mask_v lower = CmpLt(p, inc);
+    if (!Any(upper) && !Any(lower))
+    {
+        return Zero();
+    }
+
+    const float_v half = Broadcast(0.5f);
+    const float_v t1 = Div(Sub(p, Broadcast(1.f)), inc);
+    const float_v c1 = Add(Add(Mul(Mul(half, t1), t1), t1), half);
+    const float_v t2 = Div(p, inc);
+    const float_v c2 = Sub(Add(Mul(Mul(Broadcast(-0.5f), t2), t2), t2), half);
+    return Mul(Select(upper, c1, Select(lower, c2, Zero())), Broadcast(h));
+}
+
+/// @brief Applies `shape(x, i)` to the phases `simd::kFloatWidth` at a time, `i` being the index of the first phase.
+/// The last partial vector goes through a zero padded buffer.
+template <class Shape>
+void ShapeLoop(const float* p, float* out, size_t size, Shape&& shape)
+{
+    using namespace sfdsp::simd;
+    size_t i = 0;
+    for (; i + kFloatWidth <= size; i += kFloatWidth)
+    {
+        Store(out + i, shape(Load(p + i), i));
+    }
+    if (i < size)
+    {
+        float tail[kFloatWidth] = {};
+        std::copy(p + i, p + size, tail);
+        Store(tail, shape(Load(tail), i));
+        std::copy(tail, tail + (size - i), out + i);
+    }
+}
+
+// -- Sources of the kernel parameters
+
+/// @brief Kernel parameter with the same value for every phase.
+struct BlockParam
+{
+    float value;
+
+    float_v Get(size_t) const
+    {
+        return sfdsp::simd::Broadcast(value);
+    }
+
+    float At(size_t) const
+    {
+        return value;
+    }
+};
+
+/// @brief Kernel parameter with one value per interleaved voice. The voices must fill whole vectors.
+struct LaneParam
+{
+    const float* values;
+    size_t lanes;
+
+    float_v Get(size_t i) const
+    {
+        return sfdsp::simd::Load(values + i % lanes);
+    }
+
+    float At(size_t i) const
+    {
+        return values[i % lanes];
+    }
+};
+
+/// @brief Kernel parameter with one value per phase. `values` must be readable up to the next multiple of the vector
+/// width.
+struct SampleParam
+{
+    const float* values;
+
+    float_v Get(size_t i) const
+    {
+        return sfdsp::simd::Load(values + i);
+    }
+
+    float At(size_t i) const
+    {
+        return values[i];
+    }
+};
+
+// -- Block kernels, shared by Phaseshaper and PhaseshaperUnison
+//
+// `p` holds the phases, either of one voice or of interleaved voices. `mod` is the modulation amount, already
+// clamped, and `inc` the phase increment, from one of the parameter sources above. Only the waveforms with a polyBLEP
+// correction need the increment.
+// The waveforms built on a sine write the sine phase to `out` first and run the block `Sine` over it, which uses
+// the same polynomial as the scalar `Sine`.
+
+template <class Mod>
+void VarSlopeBlock(const float* p, float* out, size_t size, Mod mod, float gain)
+{
+    using namespace sfdsp::simd;
+    const float_v one = Broadcast(1.f);
+
+    ShapeLoop(p, out, size, [&](float_v x, size_t i) {
+        // Width can vary from 0.1 to 0.5
+        const float_v width = Add(Broadcast(0.1f), Mul(mod.Get(i), Broadcast(0.5f)));
+        const float_v one_minus_width = Sub(one, width);
+
+        // g_pulse: 0 before the width, 1 after.
+        const float_v pulse = Add(Sub(x, Mod1(Sub(Add(x, one), width))), one_minus_width);
+        const float_v rise = Div(Mul(Mul(Broadcast(0.5f), x), Sub(one, pulse)), width);
+        const float_v fall = Div(Mul(pulse, Sub(x, width)), one_minus_width);
+        return Add(rise, fall);
+    });
+
+    sfdsp::Sine(out, out, size, sfdsp::SineAccuracy::Medium);
+
+    const float_v gain_v = Broadcast(gain);
+    ShapeLoop(out, out, size, [&](float_v x, size_t) { return Mul(x, gain_v); });
+}
+
+template <class Mod, class Increment>
+void WaveSliceBlock(const float* p, float* out, size_t size, Mod mod, Increment inc, float gain)
+{
+    using namespace sfdsp::simd;
+
+    ShapeLoop(p, out, size, [&](float_v x, size_t i) {
+        // a1 vary from 0.25  to 0.40
+        const float_v a1 = Add(Broadcast(0.25f), Mul(mod.Get(i), Broadcast(0.15f)));
+        return Mul(a1, x);
+    });
+
+    sfdsp::Sine(out, out, size, sfdsp::SineAccuracy::Medium);
+
+    const float_v gain_v = Broadcast(gain);
+    auto blep = [&](float_v phase, float_v sine, size_t i) {
+        return Mul(Add(Bipolar(sine), PolyBlepCorrection(phase, inc.Get(i), -2.f)), gain_v);
+    };
+
+    // The sines are already in `out`, the phases are needed for the BLEP.
+    size_t i = 0;
+    for (; i + kFloatWidth <= size; i += kFloatWidth)
+    {
+        Store(out + i, blep(Load(p + i), Load(out + i), i));
+    }
+    if (i < size)
+    {
+        float phases[kFloatWidth] = {};
+        float sines[kFloatWidth] = {};
+        std::copy(p + i, p + size, phases);
+        std::copy(out + i, out + size, sines);
+        Store(sines, blep(Load(phases), Load(sines), i));
+        std::copy(sines, sines + (size - i), out + i);
+    }
+}
+
+template <class Mod>
+void SupersawBlock(const float* p, float* out, size_t size, Mod mod, float gain)
+{
+    using namespace sfdsp::simd;
+
+    const float_v m2 = Broadcast(0.88f);
+    const float_v a1 = Broadcast(1.5f);
+
+    // Original equation was sin(supersawPhase) but since sfdsp::Sine expects a value between 0 and 1
+    // we need to remove the implied 2pi factor.
+    const float_v one_over_2pi = Broadcast(1.f / TWO_PI);
+
+    ShapeLoop(p, out, size, [&](float_v x, size_t i) {
+        // m1 vary from 0.25 to 0.75
+        const float_v m1 = Add(Broadcast(0.25f), Mul(mod.Get(i), Broadcast(0.50f)));
+        const float_v xs = Mul(a1, x);
+        const float_v supersawPhase = Add(ModM(xs, m1), ModM(xs, m2));
+        return Mul(supersawPhase, one_over_2pi);
+    });
+
+    sfdsp::Sine(out, out, size, sfdsp::SineAccuracy::Medium);
+
+    const float_v gain_v = Broadcast(gain);
+    ShapeLoop(out, out, size, [&](float_v x, size_t) { return Mul(Bipolar(x), gain_v); });
+}
+
+template <class Mod>
+void RippleBlock(const float* p, float* out, size_t size, Mod mod, float gain)
+{
+    using namespace sfdsp::simd;
+    const float_v gain_v = Broadcast(gain);
+
+    ShapeLoop(p, out, size, [&](float_v x, size_t i) {
+        // ripples amount goes from no ripple at 0 to some ripples at 1.
+        const float_v ripple_amount = Mul(mod.Get(i), Broadcast(0.1f));
+
+        // Without ripples the modulo divides by 0, the limit is the plain ramp.
+        const float_v rippled = Sub(x, ModM(x, ripple_amount));
+        return Mul(Bipolar(Select(CmpGt(ripple_amount, Zero()), rippled, x)), gain_v);
+    });
+}
+
+template <class Mod>
+void SoftSyncBlock(const float* p, float* out, size_t size, Mod mod, float gain)
+{
+    using namespace sfdsp::simd;
+    const float_v two = Broadcast(2.f);
+    const float_v gain_v = Broadcast(gain);
+
+    ShapeLoop(p, out, size, [&](float_v x, size_t i) {
+        // a1 vary from 1 to 1.5
+        const float_v a1 = Add(Broadcast(1.f), Mul(mod.Get(i), Broadcast(0.5f)));
+        const float_v softPhase = Tri(x, a1);
+        // s_tri
+        const float_v rising = Mul(two, softPhase);
+        const float_v tri = Select(CmpLt(softPhase, Broadcast(0.5f)), rising, Sub(two, rising));
+        return Mul(Bipolar(tri), gain_v);
+    });
+}
+
+template <class Mod>
+void TriModBlock(const float* p, float* out, size_t size, Mod mod, float gain)
+{
+    using namespace sfdsp::simd;
+    const float_v one = Broadcast(1.f);
+    const float_v half = Broadcast(0.5f);
+    const float_v gain_v = Broadcast(gain);
+
+    ShapeLoop(p, out, size, [&](float_v x, size_t i) {
+        // atm vary from 0.5 to 1.5
+        const float_v atm = Add(half, mod.Get(i));
+        const float_v trimodPhase = Mul(atm, Bipolar(Tri(x, one)));
+        // ceil(y) is -floor(-y)
+        const float_v ceil = Sub(Zero(), Floor(Sub(half, trimodPhase)));
+        return Mul(Mul(Broadcast(2.f), Sub(trimodPhase, ceil)), gain_v);
+    });
+}
+
+/// @brief Renders one waveform for a block of phases.
+template <class Mod, class Increment>
+void ShapeBlock(Waveform wave, const float* p, float* out, size_t size, Mod mod, Increment inc, float gain)
+{
+    switch (wave)
+    {
+    case Waveform::VARIABLE_SLOPE:
+        VarSlopeBlock(p, out, size, mod, gain);
+        break;
+    case Waveform::SOFTSYNC:
+        SoftSyncBlock(p, out, size, mod, gain);
+        break;
+    case Waveform::WAVESLICE:
+        WaveSliceBlock(p, out, size, mod, inc, gain);
+        break;
+    case Waveform::SUPERSAW:
+        SupersawBlock(p, out, size, mod, gain);
+        break;
+    case Waveform::TRIANGLE_MOD:
+        TriModBlock(p, out, size, mod, gain);
+        break;
+    case Waveform::RIPPLE:
+        RippleBlock(p, out, size, mod, gain);
+        break;
+    default:
+        std::memset(out, 0, size * sizeof(float));
+        break;
+    }
+}
+
+// -- Wavetables
+//
+// Each waveform is rendered once at `kTableModSlices` evenly spaced mod values, then band-limited with an FFT into
+// `kTableLevels` mipmap levels, one per octave. Level `k` keeps `kTableMaxHarmonics >> k` harmonics in a table of
+// 4 samples per harmonic, so that linear interpolation stays clean. The tables of a waveform are built on first use
+// and shared by every Phaseshaper.
+
+constexpr size_t kTableModSlices = 9;
+constexpr size_t kTableLevels = 10;
+constexpr size_t kTableMaxHarmonics = 512;
+
+// Size of the naive rendering. The harmonics above half of it alias back, about 80 dB below the fundamental.
+constexpr size_t kTableRenderSize = 16384;
+
+constexpr size_t TableSize(size_t level)
+{
+    return std::max<size_t>(4 * (kTableMaxHarmonics >> level), 64);
+}
+
+constexpr size_t TableOffset(size_t level)
+{
+    size_t offset = 0;
+    for (size_t i = 0; i < level; ++i)
+    {
+        offset += TableSize(i);
+    }
+    return offset;
+}
+
+// Samples for all the levels of one mod slice.
+constexpr size_t kTableSliceSize = TableOffset(kTableLevels);
+
+/// @brief Level with the most harmonics that stay below Nyquist for a phase increment.
+size_t TableLevel(float increment)
+{
+    const float inc = std::abs(increment);
+    size_t level = 0;
+    while (level + 1 < kTableLevels && static_cast<float>(kTableMaxHarmonics >> level) * inc > 0.5f)
+    {
+        ++level;
+    }
+    return level;
+}
+
+/// @brief The two tables to read for a modulation amount and a phase increment.
+struct TableView
+{
+    const float* first;
+    const float* second;
+    int32_t mask;
+    float size;
+    // Crossfade between the two tables.
+    float frac;
+
+    /// @brief Linear interpolation in both tables, for a phase in [0, 1].
+    float Read(float phase) const
+    {
+        const float position = phase * size;
+        const int32_t index = static_cast<int32_t>(position);
+        const float t = position - static_cast<float>(index);
+        const int32_t i0 = index & mask;
+        const int32_t i1 = (index + 1) & mask;
+        const float a = first[i0] + t * (first[i1] - first[i0]);
+        const float b = second[i0] + t * (second[i1] - second[i0]);
+        return a + frac * (b - a);
+    }
+};
+
+/// @brief Band-limited tables of one waveform, for every mod slice and mipmap level.
+class WaveTables
+{
+  public:
+    explicit WaveTables(Waveform wave);
+
+    /// @brief Returns the tables of the two mod slices nearest to `mod`, at the level for `increment`.
+    TableView View(float mod, float increment) const
+    {
+        const size_t level = TableLevel(increment);
+        const size_t size = TableSize(level);
+        const float position = mod * static_cast<float>(kTableModSlices - 1);
+        const size_t slice = std::min(static_cast<size_t>(position), kTableModSlices - 2);
+
+        const float* table = data_.data() + slice * kTableSliceSize + TableOffset(level);
+        return {table, table + kTableSliceSize, static_cast<int32_t>(size - 1), static_cast<float>(size),
+                position - static_cast<float>(slice)};
+    }
+
+  private:
+    std::vector<float> data_;
+};
+
+WaveTables::WaveTables(Waveform wave) : data_(kTableModSlices * kTableSliceSize)
+{
+    std::vector<float> phases(kTableRenderSize);
+    for (size_t i = 0; i < kTableRenderSize; ++i)
+    {
+        phases[i] = static_cast<float>(i) / static_cast<float>(kTableRenderSize);
+    }
+
+    sfdsp::FFT render_fft(kTableRenderSize);
+    std::vector<sfdsp::FFT> level_ffts;
+    for (size_t level = 0; level < kTableLevels; ++level)
+    {
+        level_ffts.emplace_back(TableSize(level));
+    }
+
+    std::vector<float> naive(kTableRenderSize);
+    std::vector<std::complex<float>> spectrum(kTableRenderSize / 2 + 1);
+    std::vector<std::complex<float>> bins;
+    for (size_t slice = 0; slice < kTableModSlices; ++slice)
+    {
+        // Without an increment, the polyBLEP corrections are off and the rendering is the naive waveform.
+        const float mod = static_cast<float>(slice) / static_cast<float>(kTableModSlices - 1);
+        ShapeBlock(wave, phases.data(), naive.data(), kTableRenderSize, BlockParam{mod}, BlockParam{0.f}, 1.f);
+        render_fft.Forward(naive.data(), spectrum.data());
+
+        for (size_t level = 0; level < kTableLevels; ++level)
+        {
+            const size_t size = TableSize(level);
+            const size_t harmonics = kTableMaxHarmonics >> level;
+            const float scale = static_cast<float>(size) / static_cast<float>(kTableRenderSize);
+            bins.assign(size / 2 + 1, 0.f);
+            for (size_t k = 0; k <= harmonics; ++k)
+            {
+                bins[k] = spectrum[k] * scale;
+            }
+            level_ffts[level].Inverse(bins.data(), data_.data() + slice * kTableSliceSize + TableOffset(level));
+        }
+    }
+}
+
+/// @brief Returns the tables of a waveform, building them on first use.
+const WaveTables& GetWaveTables(Waveform wave)
+{
+    constexpr size_t kWaveCount = static_cast<size_t>(Waveform::NUM_WAVES);
+    static std::array<std::unique_ptr<WaveTables>, kWaveCount> tables;
+    static std::array<std::once_flag, kWaveCount> flags;
+
+    const size_t index = static_cast<size_t>(wave);
+    std::call_once(flags[index], [wave, index]() { tables[index] = std::make_unique<WaveTables>(wave); });
+    return *tables[index];
+}
+
+/// @brief Renders one waveform for a block of phases from the wavetables.
+template <class Mod, class Increment>
+void TableBlock(Waveform wave, const float* p, float* out, size_t size, Mod mod, Increment inc, float gain)
+{
+    if (wave >= Waveform::NUM_WAVES)
+    {
+        std::memset(out, 0, size * sizeof(float));
+        return;
+    }
+
+    const WaveTables& tables = GetWaveTables(wave);
+
+    // The view only changes with the parameters, read runs of equal parameters in a tight loop.
+    size_t i = 0;
+    while (i < size)
+    {
+        const float run_mod = mod.At(i);
+        const float run_increment = inc.At(i);
+        size_t end = i + 1;
+        while (end < size && mod.At(end) == run_mod && inc.At(end) == run_increment)
+        {
+            ++end;
+        }
+
+        const TableView view = tables.View(run_mod, run_increment);
+        for (; i < end; ++i)
+        {
+            out[i] = view.Read(p[i]) * gain;
+        }
+    }
+}
+
+/// @brief Renders `waveform`, crossfading between the two nearest waveforms. `scratch` holds `size` samples.
+/// @details With `wavetable`, the waveforms are read from the wavetables instead of computed.
+template <class Mod, class Increment>
+void MorphBlock(float waveform, const float* p, float* out, float* scratch, size_t size, Mod mod, Increment inc,
+                bool wavetable = false)
+{
+    const float wave1 = std::floor(waveform);
+    const float wave2 = std::ceil(waveform);
+
+    const float gain1 = 1.f - (waveform - wave1);
+    const float gain2 = 1.f - gain1;
+
+    auto render = [&](float wave, float* buffer, float gain) {
+        if (wavetable)
+        {
+            TableBlock(static_cast<Waveform>(wave), p, buffer, size, mod, inc, gain);
+        }
+        else
+        {
+            ShapeBlock(static_cast<Waveform>(wave), p, buffer, size, mod, inc, gain);
+        }
+    };
+
+    render(wave1, out, gain1);
+    if (wave1 != wave2)
+    {
+        render(wave2, scratch, gain2);
+        for (size_t i = 0; i < size; ++i)
+        {
+            out[i] += scratch[i];
+        }
+    }
+}
+
+/// @brief Position of a voice in the stack, between -1 and 1.
+float VoiceOffset(size_t voice, size_t voice_count)
+{
+    if (voice_count < 2)
+    {
+        return 0.f;
+    }
+    return 2.f * static_cast<float>(voice) / static_cast<float>(voice_count - 1) - 1.f;
+}
+} // namespace
+
 namespace sfdsp
 {
 
@@ -126,6 +658,22 @@ void Phaseshaper::Init(float sampleRate)
     period_ = samplerate_ / freq_;
 }
 
+void Phaseshaper::PrepareWavetables(Waveform wave)
+{
+    if (wave < Waveform::NUM_WAVES)
+    {
+        GetWaveTables(wave);
+    }
+}
+
+void Phaseshaper::PrepareWavetables()
+{
+    for (uint8_t wave = 0; wave < static_cast<uint8_t>(Waveform::NUM_WAVES); ++wave)
+    {
+        PrepareWavetables(static_cast<Waveform>(wave));
+    }
+}
+
 void Phaseshaper::SetMod(float mod)
 {
     mod = std::clamp(mod, 0.f, 1.f);
@@ -147,8 +695,7 @@ float Phaseshaper::Process()
     float w1 = 1.f - (waveform_ - wave1);
     float w2 = 1.f - w1;
 
-    phase_ += phaseIncrement_;
-    phase_ = MOD1(phase_);
+    phase_ = wrap_phase(phase_ + phaseIncrement_);
 
     return out1 * w1 + out2 * w2;
 }
@@ -157,62 +704,55 @@ void Phaseshaper::ProcessBlock(float* out, size_t size)
 {
     constexpr size_t kBlockSize = 64;
     float phase_buffer[kBlockSize];
-    float w1_buffer[kBlockSize];
     float w2_buffer[kBlockSize];
 
-    const float wave1 = std::floor(waveform_);
-    const float wave2 = std::ceil(waveform_);
+    const BlockParam mod{mod_};
+    const BlockParam increment{phaseIncrement_};
 
-    const float gain1 = 1.f - (waveform_ - wave1);
-    const float gain2 = 1.f - gain1;
-
-    const size_t num_blocks = size / kBlockSize;
-    size_t write_ptr = 0;
-    for (size_t i = 0; i < num_blocks; ++i)
+    for (size_t offset = 0; offset < size; offset += kBlockSize)
     {
-        for (size_t j = 0; j < kBlockSize; ++j)
+        const size_t count = std::min(kBlockSize, size - offset);
+        for (size_t j = 0; j < count; ++j)
         {
             phase_buffer[j] = phase_;
-            phase_ = MOD1(phase_ + phaseIncrement_);
+            phase_ = wrap_phase(phase_ + phaseIncrement_);
         }
 
-        ProcessWaveBlock(phase_buffer, w1_buffer, kBlockSize, static_cast<Waveform>(wave1), gain1);
-        if (wave1 != wave2)
-        {
-            ProcessWaveBlock(phase_buffer, w2_buffer, kBlockSize, static_cast<Waveform>(wave2), gain2);
-        }
+        MorphBlock(waveform_, phase_buffer, out + offset, w2_buffer, count, mod, increment, wavetable_mode_);
+    }
+}
 
-        for (size_t j = 0; j < kBlockSize; ++j)
-        {
-            out[write_ptr] = w1_buffer[j] + w2_buffer[j];
-            ++write_ptr;
-        }
+void Phaseshaper::ProcessBlock(float* out, size_t size, const float* freq, const float* mod)
+{
+    if (freq == nullptr && mod == nullptr)
+    {
+        ProcessBlock(out, size);
+        return;
     }
 
-    const size_t remaining = size - write_ptr;
-    if (remaining > 0)
+    // The kernels read the parameters a whole vector at a time, the buffers are a multiple of the vector width.
+    constexpr size_t kBlockSize = 64;
+    static_assert(kBlockSize % simd::kFloatWidth == 0);
+    float phase_buffer[kBlockSize];
+    float w2_buffer[kBlockSize];
+    float increment_buffer[kBlockSize] = {};
+    float mod_buffer[kBlockSize] = {};
+
+    for (size_t offset = 0; offset < size; offset += kBlockSize)
     {
-        for (size_t j = 0; j < remaining; ++j)
+        const size_t count = std::min(kBlockSize, size - offset);
+        for (size_t j = 0; j < count; ++j)
         {
-            phase_buffer[j] = phase_;
-            phase_ = MOD1(phase_ + phaseIncrement_);
-        }
+            // Same computations as SetFreq and SetMod, so that the block matches calling them before every Process.
+            increment_buffer[j] = (freq != nullptr) ? freq[offset + j] / samplerate_ : phaseIncrement_;
+            mod_buffer[j] = (mod != nullptr) ? std::clamp(mod[offset + j], 0.f, 1.f) : mod_;
 
-        ProcessWaveBlock(phase_buffer, w1_buffer, remaining, static_cast<Waveform>(wave1), gain1);
-        if (wave1 != wave2)
-        {
-            ProcessWaveBlock(phase_buffer, w2_buffer, remaining, static_cast<Waveform>(wave2), gain2);
-        }
-        else
-        {
-            std::memset(w2_buffer, 0, remaining * sizeof(float));
+            phase_buffer[j] = phase_;
+            phase_ = wrap_phase(phase_ + increment_buffer[j]);
         }
 
-        for (size_t j = 0; j < remaining; ++j)
-        {
-            out[write_ptr] = w1_buffer[j] + w2_buffer[j];
-            ++write_ptr;
-        }
+        MorphBlock(waveform_, phase_buffer, out + offset, w2_buffer, count, SampleParam{mod_buffer},
+                   SampleParam{increment_buffer}, wavetable_mode_);
     }
 }
 
@@ -227,21 +767,6 @@ float Phaseshaper::ProcessWaveSlice() const
     return blep;
 }
 
-void Phaseshaper::ProcessWaveSliceBlock(const float* p, float* out, size_t size, float gain) const
-{
-    // a1 vary from 0.25  to 0.40
-    float a1 = 0.25f + (mod_ * 0.15f);
-
-    for (size_t i = 0; i < size; ++i)
-    {
-        float slicePhase = g_lin(p[i], a1);
-        float trivial = G_B(sfdsp::Sine(slicePhase));
-
-        float blep = polyBLEP(trivial, p[i], phaseIncrement_, -2);
-        out[i] = blep * gain;
-    }
-}
-
 float Phaseshaper::ProcessHardSync() const
 {
     // a1 vary from 2 to 3
@@ -268,18 +793,6 @@ float Phaseshaper::ProcessSoftSync() const
     return G_B(s_tri(softPhase));
 }
 
-void Phaseshaper::ProcessSoftSyncBlock(const float* p, float* out, size_t size, float gain) const
-{
-    // a1 vary from 1 to 1.5
-    float a1 = 1.f + (mod_ * 0.5f);
-
-    for (size_t i = 0; i < size; ++i)
-    {
-        float softPhase = g_tri(p[i], a1);
-        out[i] = G_B(s_tri(softPhase)) * gain;
-    }
-}
-
 float Phaseshaper::ProcessTriMod() const
 {
     // atm vary from 0.5 to 1.5
@@ -288,18 +801,6 @@ float Phaseshaper::ProcessTriMod() const
     return 2 * (trimodPhase - std::ceil(trimodPhase - 0.5f));
 }
 
-void Phaseshaper::ProcessTriModBlock(const float* p, float* out, size_t size, float gain) const
-{
-    // atm vary from 0.5 to 1.5
-    float mod = 0.5f + mod_;
-
-    for (size_t i = 0; i < size; ++i)
-    {
-        float trimodPhase = mod * G_B(g_tri(p[i]));
-        out[i] = 2 * (trimodPhase - std::ceil(trimodPhase - 0.5f)) * gain;
-    }
-}
-
 float Phaseshaper::ProcessSupersaw() const
 {
     // m1 vary from 0.25 to 0.75
@@ -316,26 +817,6 @@ float Phaseshaper::ProcessSupersaw() const
     return G_B(sfdsp::Sine(supersawPhase * one_over_2pi));
 }
 
-void Phaseshaper::ProcessSupersawBlock(const float* p, float* out, size_t size, float gain) const
-{
-    // m1 vary from 0.25 to 0.75
-    const float m1 = 0.25f + (mod_ * 0.50f);
-    const float m2 = 0.88f;
-    const float a1 = 1.5f;
-
-    for (size_t i = 0; i < size; ++i)
-    {
-        float xs = g_lin(p[i], a1);
-
-        float supersawPhase = MODM(xs, m1) + MODM(xs, m2);
-
-        // Original equation was sin(supersawPhase) but since sfdsp::Sine expects a value between 0 and 1
-        // we need to remove the implied 2pi factor.
-        constexpr float one_over_2pi = 1.f / TWO_PI;
-        out[i] = G_B(sfdsp::Sine(supersawPhase * one_over_2pi)) * gain;
-    }
-}
-
 float Phaseshaper::ProcessVarSlope(float phase) const
 {
     // Width can vary from 0.1 to 0.5
@@ -348,19 +829,6 @@ float Phaseshaper::ProcessVarSlope(float phase) const
     return out;
 }
 
-void Phaseshaper::ProcessVarSlopeBlock(const float* p, float* out, size_t size, float gain) const
-{
-    // Width can vary from 0.1 to 0.5
-    const float width = 0.1f + (mod_ * 0.5f);
-
-    for (size_t i = 0; i < size; ++i)
-    {
-        const float pulse = g_pulse(p[i], width);
-        out[i] = 0.5f * p[i] * (1.0f - pulse) / width + pulse * (p[i] - width) / (1.f - width);
-        out[i] = sfdsp::Sine(out[i]) * gain;
-    }
-}
-
 float Phaseshaper::ProcessVarTri() const
 {
     // a1 can vary from 1.25 to 1.75
@@ -390,19 +858,13 @@ float Phaseshaper::ProcessRipple() const
     return g_ripple(phase_, ripple_amount);
 }
 
-void Phaseshaper::ProcessRippleBlock(const float* p, float* out, size_t size, float gain) const
+float Phaseshaper::ProcessWave(Waveform wave)
 {
-    // ripples amount goes from no ripple at 0 to some ripples at 1.
-    float ripple_amount = mod_ * 0.1f;
-
-    for (size_t i = 0; i < size; ++i)
+    if (wavetable_mode_)
     {
-        out[i] = g_ripple(p[i], ripple_amount) * gain;
+        return (wave < Waveform::NUM_WAVES) ? GetWaveTables(wave).View(mod_, phaseIncrement_).Read(phase_) : 0.f;
     }
-}
 
-float Phaseshaper::ProcessWave(Waveform wave)
-{
     float out = 0.f;
     switch (wave)
     {
@@ -436,31 +898,123 @@ float Phaseshaper::ProcessWave(Waveform wave)
     return out;
 }
 
-void Phaseshaper::ProcessWaveBlock(const float* p, float* out, size_t size, Waveform wave, float gain)
+void PhaseshaperUnison::Init(float sampleRate, size_t voice_count)
 {
-    switch (wave)
+    samplerate_ = sampleRate;
+    freq_ = 220.f;
+    SetVoiceCount(voice_count);
+}
+
+void PhaseshaperUnison::SetVoiceCount(size_t voice_count)
+{
+    voice_count_ = std::clamp(voice_count, static_cast<size_t>(1), kMaxVoices);
+    lane_count_ = simd::PaddedSize(voice_count_);
+
+    // Spread the starting phases with the golden ratio so that the voices do not start in phase. The first voice
+    // starts at 0, like Phaseshaper.
+    constexpr float kGoldenRatio = 0.618033988749895f;
+    phases_.fill(0.f);
+    for (size_t v = 0; v < voice_count_; ++v)
     {
-    case Waveform::VARIABLE_SLOPE:
-        ProcessVarSlopeBlock(p, out, size, gain);
-        break;
-    case Waveform::SOFTSYNC:
-        ProcessSoftSyncBlock(p, out, size, gain);
-        break;
-    case Waveform::WAVESLICE:
-        ProcessWaveSliceBlock(p, out, size, gain);
-        break;
-    case Waveform::SUPERSAW:
-        ProcessSupersawBlock(p, out, size, gain);
-        break;
-    case Waveform::TRIANGLE_MOD:
-        ProcessTriModBlock(p, out, size, gain);
-        break;
-    case Waveform::RIPPLE:
-        ProcessRippleBlock(p, out, size, gain);
-        break;
-    default:
-        std::memset(out, 0, size * sizeof(float));
-        break;
+        phases_[v] = MOD1(static_cast<float>(v) * kGoldenRatio);
+    }
+
+    UpdateIncrements();
+    UpdateGains();
+}
+
+void PhaseshaperUnison::SetFreq(float freq)
+{
+    freq_ = freq;
+    UpdateIncrements();
+}
+
+void PhaseshaperUnison::SetDetune(float cents)
+{
+    detune_ = cents;
+    UpdateIncrements();
+}
+
+void PhaseshaperUnison::SetSpread(float spread)
+{
+    spread_ = std::clamp(spread, 0.f, 1.f);
+    UpdateGains();
+}
+
+void PhaseshaperUnison::SetMod(float mod)
+{
+    mod_ = std::clamp(mod, 0.f, 1.f);
+}
+
+void PhaseshaperUnison::UpdateIncrements()
+{
+    increments_.fill(0.f);
+    for (size_t v = 0; v < voice_count_; ++v)
+    {
+        const float cents = detune_ * VoiceOffset(v, voice_count_);
+        increments_[v] = freq_ * std::exp2(cents / 1200.f) / samplerate_;
+    }
+}
+
+void PhaseshaperUnison::UpdateGains()
+{
+    left_gains_.fill(0.f);
+    right_gains_.fill(0.f);
+    const float gain = 1.f / std::sqrt(static_cast<float>(voice_count_));
+    for (size_t v = 0; v < voice_count_; ++v)
+    {
+        // Equal power panning, -3 dB in the center.
+        const float angle = (spread_ * VoiceOffset(v, voice_count_) + 1.f) * PI_F * 0.25f;
+        left_gains_[v] = std::cos(angle) * gain;
+        right_gains_[v] = std::sin(angle) * gain;
+    }
+}
+
+void PhaseshaperUnison::ProcessBlock(float* left, float* right, size_t size)
+{
+    // Interleaved buffers hold `kBufferSize / lane_count_` frames of every voice, at least 16. The three buffers take
+    // 3 kB of stack.
+    constexpr size_t kBufferSize = 256;
+    static_assert(kBufferSize % kMaxVoices == 0);
+    float phase_buffer[kBufferSize];
+    float w1_buffer[kBufferSize];
+    float w2_buffer[kBufferSize];
+
+    const size_t lanes = lane_count_;
+    const size_t max_frames = kBufferSize / lanes;
+    for (size_t offset = 0; offset < size; offset += max_frames)
+    {
+        const size_t frames = std::min(max_frames, size - offset);
+
+        for (size_t v = 0; v < lanes; v += simd::kFloatWidth)
+        {
+            const simd::float_v increment = simd::Load(increments_.data() + v);
+            simd::float_v phase = simd::Load(phases_.data() + v);
+            for (size_t f = 0; f < frames; ++f)
+            {
+                simd::Store(phase_buffer + f * lanes + v, phase);
+                phase = simd::Add(phase, increment);
+                phase = simd::Sub(phase, simd::Floor(phase));
+            }
+            simd::Store(phases_.data() + v, phase);
+        }
+
+        MorphBlock(waveform_, phase_buffer, w1_buffer, w2_buffer, frames * lanes, BlockParam{mod_},
+                   LaneParam{increments_.data(), lanes});
+
+        for (size_t f = 0; f < frames; ++f)
+        {
+            simd::float_v sum_left = simd::Zero();
+            simd::float_v sum_right = simd::Zero();
+            for (size_t v = 0; v < lanes; v += simd::kFloatWidth)
+            {
+                const simd::float_v x = simd::Load(w1_buffer + f * lanes + v);
+                sum_left = simd::MulAdd(x, simd::Load(left_gains_.data() + v), sum_left);
+                sum_right = simd::MulAdd(x, simd::Load(right_gains_.data() + v), sum_right);
+            }
+            left[offset + f] = simd::ReduceAdd(sum_left);
+            right[offset + f] = simd::ReduceAdd(sum_right);
+        }
     }
 }
 
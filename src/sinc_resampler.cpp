@@ -1,26 +1,174 @@
 #include "sinc_resampler.h"
 
 #include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <vector>
 
-#include "sinc_table.h"
+#include "simd.h"
+#include "sinc_tables.h"
+
+namespace
+{
+/// @brief Maximum number of input samples appended to the history at once.
+constexpr size_t kBlockSize = 256;
+
+/// @brief Linearly interpolated lookup of the windowed sinc, `x` in table samples.
+float SincTableLookup(const sfdsp::SincTable& table, double x)
+{
+    if (x >= static_cast<double>(table.size))
+    {
+        return 0.f;
+    }
+    const auto index = static_cast<size_t>(x);
+    const auto fraction = static_cast<float>(x - static_cast<double>(index));
+    return table.values[index] + fraction * (table.values[index + 1] - table.values[index]);
+}
+
+/// @brief Weighted sum of `count` interleaved frames, out[c] = scale * sum_j weights[j] * x[j * channels + c].
+/// @details The weights are shared by every channel. The channels are processed `simd::kFloatWidth` at a time, the
+/// last vector overlapping the previous one when the channel count is not a multiple of the width.
+void MixFrames(const float* x, size_t channels, const float* weights, size_t count, float scale, float* out)
+{
+    using namespace sfdsp;
+
+    if (channels >= simd::kFloatWidth)
+    {
+        for (size_t c = 0; c < channels; c += simd::kFloatWidth)
+        {
+            c = std::min(c, channels - simd::kFloatWidth);
+            simd::float_v acc = simd::Zero();
+            for (size_t j = 0; j < count; ++j)
+            {
+                acc = simd::MulAdd(simd::Load(x + j * channels + c), simd::Broadcast(weights[j]), acc);
+            }
+            simd::Store(out + c, simd::Mul(acc, simd::Broadcast(scale)));
+        }
+        return;
+    }
+
+    // Fewer channels than vector lanes. Four partial sums per channel to hide the latency of the additions.
+    for (size_t c = 0; c < channels; ++c)
+    {
+        float acc[4] = {0.f, 0.f, 0.f, 0.f};
+        size_t j = 0;
+        for (; j + 4 <= count; j += 4)
+        {
+            acc[0] += x[j * channels + c] * weights[j];
+            acc[1] += x[(j + 1) * channels + c] * weights[j + 1];
+            acc[2] += x[(j + 2) * channels + c] * weights[j + 2];
+            acc[3] += x[(j + 3) * channels + c] * weights[j + 3];
+        }
+        for (; j < count; ++j)
+        {
+            acc[0] += x[j * channels + c] * weights[j];
+        }
+        out[c] = ((acc[0] + acc[1]) + (acc[2] + acc[3])) * scale;
+    }
+}
+
+/// @brief Reduce output_rate / input_rate to up / down, with at most `max_up` phases.
+void ReduceRatio(size_t input_rate, size_t output_rate, size_t max_up, size_t& up, size_t& down)
+{
+    const size_t gcd = std::gcd(input_rate, output_rate);
+    up = output_rate / gcd;
+    down = input_rate / gcd;
+    if (up <= max_up)
+    {
+        return;
+    }
+
+    // Last continued fraction convergent of down / up whose denominator fits.
+    size_t num = down;
+    size_t den = up;
+    size_t p0 = 0;
+    size_t q0 = 1;
+    size_t p1 = 1;
+    size_t q1 = 0;
+    while (den != 0)
+    {
+        const size_t a = num / den;
+        const size_t p2 = a * p1 + p0;
+        const size_t q2 = a * q1 + q0;
+        if (q2 > max_up)
+        {
+            break;
+        }
+        p0 = p1;
+        q0 = q1;
+        p1 = p2;
+        q1 = q2;
+        const size_t r = num - a * den;
+        num = den;
+        den = r;
+    }
+    down = p1;
+    up = q1;
+}
+
+/// @brief The unstretched filter at every phase of the sinc table, rows padded at the front. The taps go from
+/// index - Z to index + Z + 1. The last row is the first one shifted by a sample, so the taps at any fractional phase
+/// interpolate two contiguous rows.
+std::vector<float> MakeUnitFilterBank(const sfdsp::SincTable& table)
+{
+    const size_t half_length = table.zero_count + 1;
+    const size_t stride = sfdsp::simd::PaddedSize(2 * half_length);
+    const size_t padding = stride - 2 * half_length;
+    std::vector<float> rows((table.samples_per_crossing + 1) * stride, 0.f);
+    for (size_t phase = 0; phase <= table.samples_per_crossing; ++phase)
+    {
+        for (size_t k = 0; k < 2 * half_length; ++k)
+        {
+            const auto offset = static_cast<ptrdiff_t>(k) - static_cast<ptrdiff_t>(half_length - 1);
+            const auto x = offset * static_cast<ptrdiff_t>(table.samples_per_crossing) - static_cast<ptrdiff_t>(phase);
+            rows[phase * stride + padding + k] = SincTableLookup(table, static_cast<double>(std::abs(x)));
+        }
+    }
+    return rows;
+}
+
+/// @brief Returns the unstretched filter bank of a sinc table, built on first use and shared by every resampler
+/// using the same table.
+const std::vector<float>& UnitFilterBank(const sfdsp::SincTable& table)
+{
+    // Only called from Init, which already allocates, so a lock is fine. The map never moves its values.
+    static std::mutex mutex;
+    static std::map<const sfdsp::SincTable*, std::vector<float>> banks;
+    std::lock_guard lock(mutex);
+    auto it = banks.find(&table);
+    if (it == banks.end())
+    {
+        it = banks.emplace(&table, MakeUnitFilterBank(table)).first;
+    }
+    return it->second;
+}
+} // namespace
 
 namespace sfdsp
 {
 
 void sinc_resample(const float* in, size_t input_size, float ratio, float* out, size_t& out_size)
 {
-    constexpr size_t filter_length = sizeof(sinc_table) / sizeof(sinc_table[0]);
-    float time_step = 1.0f / ratio;
+    // The last table entry is only read as the upper point of the linear interpolation.
+    const SincTable& table = GetSincTable<SincQuality::Best>();
+    const float* sinc_table = table.values;
+    const size_t filter_length = table.size - 1;
+    const double time_step = 1.0 / ratio;
     float filter_scale = (ratio < 1.0f) ? ratio : 1.0f;
-    float filter_step = SAMPLES_PER_CROSSING * filter_scale;
+    float filter_step = static_cast<float>(table.samples_per_crossing) * filter_scale;
 
+    // The time is accumulated in double, in float it drifts by several samples over long signals.
     size_t out_idx = 0;
-    float t = 0.0;
+    double t = 0.0;
     while (t < input_size)
     {
 
         int32_t idx_integer = static_cast<int32_t>(t);
-        float fractional_part = t - idx_integer;
+        auto fractional_part = static_cast<float>(t - idx_integer);
 
         // Left wing
         float left = 0.0;
@@ -69,4 +217,350 @@ void sinc_resample(const float* in, size_t input_size, float ratio, float* out,
     out_size = out_idx;
 }
 
-} // namespace sfdsp
\ No newline at end of file
+void sinc_resample(const float* in, size_t input_size, size_t channels, float ratio, float* out, size_t& out_size)
+{
+    assert(channels > 0);
+
+    const SincTable& table = GetSincTable<SincQuality::Best>();
+    const size_t filter_length = table.size - 1;
+    const double time_step = 1.0 / ratio;
+    const float filter_scale = (ratio < 1.0f) ? ratio : 1.0f;
+    const float filter_step = static_cast<float>(table.samples_per_crossing) * filter_scale;
+
+    // The weights of one output sample are computed once and applied to every channel.
+    std::vector<float> weights(2 * (static_cast<size_t>(filter_length / filter_step) + 2));
+
+    size_t out_idx = 0;
+    double t = 0.0;
+    while (t < input_size && out_idx < out_size)
+    {
+        const auto idx_integer = static_cast<int32_t>(t);
+        const auto fractional_part = static_cast<float>(t - idx_integer);
+        size_t weight_count = 0;
+
+        // Left wing, from the oldest frame to the one at idx_integer.
+        float filter_offset = filter_step * fractional_part;
+        int32_t left_coeff_count = static_cast<int32_t>((filter_length - filter_offset) / filter_step);
+        left_coeff_count = std::min(idx_integer, left_coeff_count);
+        for (int32_t i = left_coeff_count; i >= 0; --i)
+        {
+            weights[weight_count++] = SincTableLookup(table, filter_offset + filter_step * i);
+        }
+
+        // Right wing
+        filter_offset = filter_step * (1 - fractional_part);
+        int32_t right_coeff_count = static_cast<int32_t>((filter_length - filter_offset) / filter_step);
+        right_coeff_count = std::min(static_cast<int32_t>(input_size) - idx_integer - 1, right_coeff_count);
+        for (int32_t i = 0; i < right_coeff_count; ++i)
+        {
+            weights[weight_count++] = SincTableLookup(table, filter_offset + filter_step * i);
+        }
+
+        const float* first_frame = in + static_cast<size_t>(idx_integer - left_coeff_count) * channels;
+        MixFrames(first_frame, channels, weights.data(), weight_count, filter_scale, out + out_idx * channels);
+        ++out_idx;
+
+        t += time_step;
+    }
+
+    out_size = out_idx;
+}
+
+void SincResampler::Init(size_t input_rate, size_t output_rate, size_t channels)
+{
+    Init(input_rate, output_rate, channels, GetSincTable<SincQuality::Best>());
+}
+
+void SincResampler::Init(size_t input_rate, size_t output_rate, size_t channels, SincQuality quality)
+{
+    Init(input_rate, output_rate, channels, GetSincTable(quality));
+}
+
+void SincResampler::Init(size_t input_rate, size_t output_rate, size_t channels, const SincTable& table)
+{
+    assert(input_rate > 0 && output_rate > 0);
+    assert(channels > 0);
+
+    channels_ = channels;
+
+    ReduceRatio(input_rate, output_rate, kMaxPhaseCount, up_, down_);
+
+    // Same filter as sinc_resample: the sinc is stretched when downsampling so that its cutoff follows the output
+    // Nyquist frequency.
+    const double ratio = GetRatio();
+    const double filter_scale = std::min(ratio, 1.0);
+    const double filter_step = static_cast<double>(table.samples_per_crossing) * filter_scale;
+    half_length_ = static_cast<size_t>(std::ceil(static_cast<double>(table.zero_count) / filter_scale));
+
+    // Row p holds the taps for an output at fractional input position p / L, applied to the input samples from
+    // i - (H - 1) to i + H. The padding goes in front so that it reads older history instead of samples that have
+    // not arrived yet.
+    const size_t tap_count = 2 * half_length_;
+    stride_ = simd::PaddedSize(tap_count);
+    const size_t padding = stride_ - tap_count;
+    bank_.assign(up_ * stride_, 0.f);
+    for (size_t phase = 0; phase < up_; ++phase)
+    {
+        const double fraction = static_cast<double>(phase) / static_cast<double>(up_);
+        float* row = bank_.data() + phase * stride_ + padding;
+        for (size_t j = 0; j < tap_count; ++j)
+        {
+            const double offset = static_cast<double>(j) - static_cast<double>(half_length_ - 1);
+            const double distance = std::abs(offset - fraction);
+            row[j] = SincTableLookup(table, distance * filter_step) * static_cast<float>(filter_scale);
+        }
+    }
+
+    // One history per channel so that every channel is read with the same contiguous dot product as a mono signal.
+    histories_.resize(channels_);
+    for (auto& history : histories_)
+    {
+        history.Init(stride_, kBlockSize);
+    }
+    blocks_.resize(channels_);
+    Reset();
+}
+
+void SincResampler::Reset()
+{
+    for (auto& history : histories_)
+    {
+        history.Reset();
+    }
+    input_count_ = 0;
+    next_index_ = 0;
+    next_phase_ = 0;
+}
+
+double SincResampler::GetRatio() const
+{
+    return static_cast<double>(up_) / static_cast<double>(down_);
+}
+
+size_t SincResampler::GetChannelCount() const
+{
+    return channels_;
+}
+
+size_t SincResampler::GetLatency() const
+{
+    return half_length_;
+}
+
+size_t SincResampler::GetMaxOutputSize(size_t input_size) const
+{
+    return (input_size * up_ + down_ - 1) / down_ + 1;
+}
+
+size_t SincResampler::Process(const float* in, size_t input_size, float* out)
+{
+    assert(!bank_.empty());
+    assert(in != nullptr);
+    assert(out != nullptr);
+
+    const size_t index_step = down_ / up_;
+    const size_t phase_step = down_ % up_;
+
+    size_t written = 0;
+    float planar[kBlockSize];
+    while (input_size > 0)
+    {
+        const size_t count = std::min(input_size, kBlockSize);
+        for (size_t c = 0; c < channels_; ++c)
+        {
+            const float* channel_in = in;
+            if (channels_ > 1)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    planar[i] = in[i * channels_ + c];
+                }
+                channel_in = planar;
+            }
+            blocks_[c] = histories_[c].Append(channel_in, count);
+        }
+        const size_t block_start = input_count_;
+        input_count_ += count;
+
+        // The output at input position i + p / L needs the input samples up to i + H.
+        while (next_index_ + half_length_ < input_count_)
+        {
+            // First frame of the padded row, relative to the block.
+            const auto offset = static_cast<ptrdiff_t>(next_index_ + half_length_ + 1) -
+                                static_cast<ptrdiff_t>(block_start) - static_cast<ptrdiff_t>(stride_);
+            const float* row = bank_.data() + next_phase_ * stride_;
+            for (size_t c = 0; c < channels_; ++c)
+            {
+                out[written * channels_ + c] = simd::Dot(row, blocks_[c] + offset, stride_);
+            }
+            ++written;
+
+            next_index_ += index_step;
+            next_phase_ += phase_step;
+            if (next_phase_ >= up_)
+            {
+                next_phase_ -= up_;
+                ++next_index_;
+            }
+        }
+
+        in += count * channels_;
+        input_size -= count;
+    }
+
+    return written;
+}
+
+void VarispeedResampler::Init(float ratio)
+{
+    Init(ratio, GetSincTable<SincQuality::Best>());
+}
+
+void VarispeedResampler::Init(float ratio, SincQuality quality)
+{
+    Init(ratio, GetSincTable(quality));
+}
+
+void VarispeedResampler::Init(float ratio, const SincTable& table)
+{
+    table_ = &table;
+    unit_filters_ = UnitFilterBank(table).data();
+
+    // Longest filter, at the smallest ratio.
+    max_half_length_ = static_cast<size_t>(std::ceil(static_cast<float>(table_->zero_count) / kMinRatio)) + 1;
+    weights_.assign(simd::PaddedSize(2 * max_half_length_), 0.f);
+    history_.Init(weights_.size() + simd::kFloatWidth, kBlockSize);
+
+    target_ratio_ = std::clamp(ratio, kMinRatio, kMaxRatio);
+    Reset();
+}
+
+void VarispeedResampler::Reset()
+{
+    history_.Reset();
+    block_ = nullptr;
+    block_start_ = 0;
+    input_count_ = 0;
+    position_ = 0.0;
+    ratio_ = target_ratio_;
+}
+
+void VarispeedResampler::SetRatio(float ratio)
+{
+    target_ratio_ = std::clamp(ratio, kMinRatio, kMaxRatio);
+}
+
+float VarispeedResampler::GetRatio() const
+{
+    return ratio_;
+}
+
+size_t VarispeedResampler::Process(const float* in, size_t input_size, size_t& input_used, float* out,
+                                   size_t output_size)
+{
+    return ProcessImpl<true>(in, input_size, input_used, out, output_size, nullptr);
+}
+
+size_t VarispeedResampler::Process(const float* in, size_t input_size, size_t& input_used, float* out,
+                                   size_t output_size, const float* ratios)
+{
+    assert(ratios != nullptr);
+    return ProcessImpl<false>(in, input_size, input_used, out, output_size, ratios);
+}
+
+template <bool Smooth>
+size_t VarispeedResampler::ProcessImpl(const float* in, size_t input_size, size_t& input_used, float* out,
+                                       size_t output_size, const float* ratios)
+{
+    assert(!weights_.empty());
+    assert(in != nullptr || input_size == 0);
+    assert(out != nullptr);
+
+    constexpr float kGlide = 1.f / kGlideTime;
+    const float* table = table_->values;
+    const auto table_size = static_cast<float>(table_->size);
+    const auto last_table_index = static_cast<int>(table_->size) - 1;
+    const auto samples_per_crossing = static_cast<float>(table_->samples_per_crossing);
+
+    input_used = 0;
+    size_t written = 0;
+    while (written < output_size)
+    {
+        float ratio = 0.f;
+        if constexpr (Smooth)
+        {
+            ratio = ratio_ + (target_ratio_ - ratio_) * kGlide;
+        }
+        else
+        {
+            ratio = std::clamp(ratios[written], kMinRatio, kMaxRatio);
+        }
+
+        // Same filter as sinc_resample, stretched when downsampling so that the cutoff follows the output Nyquist
+        // frequency. The taps from index - (H - 1) to index + H cover the whole table.
+        const float filter_scale = std::min(ratio, 1.f);
+        const float filter_step = samples_per_crossing * filter_scale;
+        const auto half_length = static_cast<size_t>(table_size / filter_step) + 1;
+        assert(half_length <= max_half_length_);
+
+        const auto index = static_cast<size_t>(position_);
+        if (index + half_length >= input_count_)
+        {
+            if (input_used == input_size)
+            {
+                break;
+            }
+            const size_t count = std::min(kBlockSize, input_size - input_used);
+            block_start_ = input_count_;
+            block_ = history_.Append(in + input_used, count);
+            input_count_ += count;
+            input_used += count;
+            continue;
+        }
+
+        // The window is padded at the front, its last sample is index + H.
+        const size_t tap_count = simd::PaddedSize(2 * half_length);
+        const auto first = static_cast<ptrdiff_t>(index + half_length + 1) - static_cast<ptrdiff_t>(tap_count);
+        const float* x = block_ + (first - static_cast<ptrdiff_t>(block_start_));
+
+        if (filter_scale == 1.f)
+        {
+            // Unstretched filter: interpolating the dot products with the two nearest precomputed phases is the same
+            // as interpolating the taps, and much cheaper than looking them up one by one.
+            const double phase = (position_ - static_cast<double>(index)) * table_->samples_per_crossing;
+            const auto row = static_cast<size_t>(phase);
+            const auto fraction = static_cast<float>(phase - static_cast<double>(row));
+            assert(half_length == table_->zero_count + 1);
+            const float* taps = unit_filters_ + row * tap_count;
+            const float y0 = simd::Dot(taps, x, tap_count);
+            const float y1 = simd::Dot(taps + tap_count, x, tap_count);
+            out[written++] = y0 + fraction * (y1 - y0);
+        }
+        else
+        {
+            // Stretched filter: the taps fall anywhere in the table. The table ends with a zero so the lookup is
+            // clamped instead of branching on the distance.
+            const size_t padding = tap_count - 2 * half_length;
+            const auto offset = static_cast<float>(static_cast<double>(first) - position_);
+            std::fill_n(weights_.begin(), padding, 0.f);
+            for (size_t j = padding; j < tap_count; ++j)
+            {
+                const float distance = std::min(std::abs(offset + static_cast<float>(j)) * filter_step, table_size);
+                const int table_index = std::min(static_cast<int>(distance), last_table_index);
+                const float fraction = distance - static_cast<float>(table_index);
+                weights_[j] = table[table_index] + fraction * (table[table_index + 1] - table[table_index]);
+            }
+            out[written++] = simd::Dot(weights_.data(), x, tap_count) * filter_scale;
+        }
+
+        position_ += 1.0 / static_cast<double>(ratio);
+        if constexpr (Smooth)
+        {
+            ratio_ = ratio;
+        }
+    }
+
+    return written;
+}
+
+} // namespace sfdsp
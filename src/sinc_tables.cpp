@@ -0,0 +1,43 @@
+#include "sinc_tables.h"
+
+#include "sinc_table.h"
+
+namespace sfdsp
+{
+template <>
+const SincTable& GetSincTable<SincQuality::Fast>()
+{
+    static constexpr auto kValues = MakeSincTable<8, 128>(6.0);
+    static constexpr SincTable kTable{kValues.data(), 8, 128, kValues.size() - 1};
+    return kTable;
+}
+
+template <>
+const SincTable& GetSincTable<SincQuality::Balanced>()
+{
+    static constexpr auto kValues = MakeSincTable<16, 256>(8.0);
+    static constexpr SincTable kTable{kValues.data(), 16, 256, kValues.size() - 1};
+    return kTable;
+}
+
+template <>
+const SincTable& GetSincTable<SincQuality::Best>()
+{
+    static constexpr SincTable kTable{sinc_table, SINC_ZERO_COUNT, SAMPLES_PER_CROSSING, sinc_table_size};
+    return kTable;
+}
+
+const SincTable& GetSincTable(SincQuality quality)
+{
+    switch (quality)
+    {
+    case SincQuality::Fast:
+        return GetSincTable<SincQuality::Fast>();
+    case SincQuality::Balanced:
+        return GetSincTable<SincQuality::Balanced>();
+    case SincQuality::Best:
+    default:
+        return GetSincTable<SincQuality::Best>();
+    }
+}
+} // namespace sfdsp
@@ -0,0 +1,218 @@
+#include "state_variable_filter.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "dsp_utils.h"
+#include "tan_table.h"
+
+namespace
+{
+constexpr float kMaxNormalizedCutoff = 0.49f;
+
+/// @brief Returns tan(pi * f) using the lookup table and linear interpolation.
+/// @param f Normalized frequency (f / samplerate), between 0 and kMaxNormalizedCutoff.
+inline float TanLookup(float f)
+{
+    const float idx = f * (2.f * sfdsp::TAN_LUT_SIZE);
+    const auto idx0 = static_cast<size_t>(idx);
+    const float frac = idx - static_cast<float>(idx0);
+    return sfdsp::tan_lut[idx0] + frac * (sfdsp::tan_lut[idx0 + 1] - sfdsp::tan_lut[idx0]);
+}
+
+inline float NormalizeCutoff(float freq, float inv_samplerate)
+{
+    return std::clamp(freq * inv_samplerate, 0.f, kMaxNormalizedCutoff);
+}
+} // namespace
+
+namespace sfdsp
+{
+
+void StateVariableFilter::Init(float samplerate)
+{
+    samplerate_ = samplerate;
+    inv_samplerate_ = 1.f / samplerate_;
+    Reset();
+    UpdateCoefficients();
+}
+
+void StateVariableFilter::SetCutoff(float freq)
+{
+    cutoff_ = freq;
+    UpdateCoefficients();
+}
+
+float StateVariableFilter::GetCutoff() const
+{
+    return cutoff_;
+}
+
+void StateVariableFilter::SetQ(float q)
+{
+    assert(q > 0.f);
+    k_ = 1.f / q;
+    UpdateCoefficients();
+}
+
+void StateVariableFilter::Reset()
+{
+    ic1eq_ = 0.f;
+    ic2eq_ = 0.f;
+}
+
+void StateVariableFilter::UpdateCoefficients()
+{
+    // Exact prewarping for the control rate API.
+    g_ = std::tan(PI_F * NormalizeCutoff(cutoff_, inv_samplerate_));
+    a1_ = 1.f / (1.f + g_ * (g_ + k_));
+    a2_ = g_ * a1_;
+    a3_ = g_ * a2_;
+}
+
+void StateVariableFilter::Tick(float in, float& lp, float& bp, float& hp)
+{
+    const float v3 = in - ic2eq_;
+    const float v1 = a1_ * ic1eq_ + a2_ * v3;
+    const float v2 = ic2eq_ + a2_ * ic1eq_ + a3_ * v3;
+    ic1eq_ = 2.f * v1 - ic1eq_;
+    ic2eq_ = 2.f * v2 - ic2eq_;
+
+    lp = v2;
+    bp = v1;
+    hp = in - k_ * v1 - v2;
+}
+
+float StateVariableFilter::Tick(float in)
+{
+    float lp, bp, hp;
+    Tick(in, lp, bp, hp);
+    return lp;
+}
+
+void StateVariableFilter::ProcessBlock(const float* in, float* lp, float* bp, float* hp, size_t size)
+{
+    assert(in != nullptr);
+
+    constexpr size_t kChunkSize = 64;
+    float lp_buffer[kChunkSize];
+    float bp_buffer[kChunkSize];
+
+    const float a1 = a1_;
+    const float a2 = a2_;
+    const float a3 = a3_;
+    const float k = k_;
+    float ic1eq = ic1eq_;
+    float ic2eq = ic2eq_;
+
+    for (size_t offset = 0; offset < size; offset += kChunkSize)
+    {
+        const size_t count = std::min(kChunkSize, size - offset);
+        const float* x = in + offset;
+
+        // The recursion is inherently serial, only the lowpass and bandpass states are computed here.
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float v3 = x[i] - ic2eq;
+            const float v1 = a1 * ic1eq + a2 * v3;
+            const float v2 = ic2eq + a2 * ic1eq + a3 * v3;
+            ic1eq = 2.f * v1 - ic1eq;
+            ic2eq = 2.f * v2 - ic2eq;
+            lp_buffer[i] = v2;
+            bp_buffer[i] = v1;
+        }
+
+        // The highpass output is a linear combination of the others and can be computed in a vectorizable loop.
+        if (hp != nullptr)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                hp[offset + i] = x[i] - k * bp_buffer[i] - lp_buffer[i];
+            }
+        }
+        if (lp != nullptr)
+        {
+            std::copy(lp_buffer, lp_buffer + count, lp + offset);
+        }
+        if (bp != nullptr)
+        {
+            std::copy(bp_buffer, bp_buffer + count, bp + offset);
+        }
+    }
+
+    ic1eq_ = ic1eq;
+    ic2eq_ = ic2eq;
+}
+
+void StateVariableFilter::ProcessBlock(const float* in, const float* cutoff, float* lp, float* bp, float* hp,
+                                       size_t size)
+{
+    assert(in != nullptr);
+    assert(cutoff != nullptr);
+
+    if (size == 0)
+    {
+        return;
+    }
+
+    constexpr size_t kChunkSize = 64;
+    float a1_buffer[kChunkSize];
+    float a2_buffer[kChunkSize];
+    float a3_buffer[kChunkSize];
+    float lp_buffer[kChunkSize];
+    float bp_buffer[kChunkSize];
+
+    const float k = k_;
+    float ic1eq = ic1eq_;
+    float ic2eq = ic2eq_;
+
+    for (size_t offset = 0; offset < size; offset += kChunkSize)
+    {
+        const size_t count = std::min(kChunkSize, size - offset);
+        const float* x = in + offset;
+
+        // Compute all the coefficients for the chunk first so that the recursion below stays tight.
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float g = TanLookup(NormalizeCutoff(cutoff[offset + i], inv_samplerate_));
+            a1_buffer[i] = 1.f / (1.f + g * (g + k));
+            a2_buffer[i] = g * a1_buffer[i];
+            a3_buffer[i] = g * a2_buffer[i];
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float v3 = x[i] - ic2eq;
+            const float v1 = a1_buffer[i] * ic1eq + a2_buffer[i] * v3;
+            const float v2 = ic2eq + a2_buffer[i] * ic1eq + a3_buffer[i] * v3;
+            ic1eq = 2.f * v1 - ic1eq;
+            ic2eq = 2.f * v2 - ic2eq;
+            lp_buffer[i] = v2;
+            bp_buffer[i] = v1;
+        }
+
+        if (hp != nullptr)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                hp[offset + i] = x[i] - k * bp_buffer[i] - lp_buffer[i];
+            }
+        }
+        if (lp != nullptr)
+        {
+            std::copy(lp_buffer, lp_buffer + count, lp + offset);
+        }
+        if (bp != nullptr)
+        {
+            std::copy(bp_buffer, bp_buffer + count, bp + offset);
+        }
+    }
+
+    ic1eq_ = ic1eq;
+    ic2eq_ = ic2eq;
+
+    cutoff_ = cutoff[size - 1];
+    UpdateCoefficients();
+}
+} // namespace sfdsp
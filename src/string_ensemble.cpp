@@ -11,6 +11,7 @@ void StringEnsemble::Init(float samplerate, const std::array<float, kStringCount
         sfdsp::BowedStringConfig config = sfdsp::kDefaultStringConfig;
         config.samplerate = samplerate;
         config.open_string_tuning = frequencies[i];
+        config.noise_seed = sfdsp::NoiseGenerator::kDefaultSeed + static_cast<uint32_t>(i);
 
         strings_[i].Init(config);
     }
@@ -54,6 +55,20 @@ void StringEnsemble::ProcessBlock(float* out, size_t size)
 {
     assert(out != nullptr);
 
+    if (IsSilent())
+    {
+        // The strings still need to be ticked to keep their parameter smoothing running.
+        transmission_filter_.Reset();
+        for (size_t i = 0; i < size; ++i)
+        {
+            for (auto& string : strings_)
+            {
+                string.Tick(0.f);
+            }
+        }
+        return;
+    }
+
     for (size_t i = 0; i < size; ++i)
     {
         std::array<float, kStringCount> string_outs = {0.f};
@@ -83,6 +98,18 @@ void StringEnsemble::ProcessBlock(float* out, size_t size)
     // }
 }
 
+bool StringEnsemble::IsSilent() const
+{
+    for (const auto& string : strings_)
+    {
+        if (!string.IsSilent())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 const BowedString& StringEnsemble::operator[](uint8_t string_number) const
 {
     assert(string_number < kStringCount);
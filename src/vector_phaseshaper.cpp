@@ -1,21 +1,42 @@
 #include "vector_phaseshaper.h"
 
+#include <algorithm>
 #include <cassert>
 
 #include "basic_oscillators.h"
 #include "dsp_utils.h"
+#include "simd.h"
 
 namespace
 {
-float phase_distort(float x, float d, float v)
+constexpr size_t kChunkSize = 64;
+static_assert(kChunkSize % sfdsp::simd::kFloatWidth == 0);
+
+/// @brief Piecewise linear phase distortion through (d, v), with the slopes of both segments precomputed. The
+/// segments are selected per lane instead of branching.
+struct PhaseDistortion
 {
-    if (x < d)
+    PhaseDistortion(float d, float v)
+        : d(sfdsp::simd::Broadcast(d)),
+          v(sfdsp::simd::Broadcast(v)),
+          rise(sfdsp::simd::Broadcast(v / d)),
+          fall(sfdsp::simd::Broadcast((1.f - v) / (1.f - d)))
     {
-        return (v * x / d);
     }
 
-    return (1 - v) * ((x - d) / (1 - d)) + v;
-}
+    // Half a period is added to the phase to get -cos(x).
+    sfdsp::simd::float_v operator()(sfdsp::simd::float_v x) const
+    {
+        using namespace sfdsp::simd;
+        const float_v half = Broadcast(0.5f);
+        return Select(CmpLt(x, d), MulAdd(x, rise, half), Add(MulAdd(Sub(x, d), fall, v), half));
+    }
+
+    sfdsp::simd::float_v d;
+    sfdsp::simd::float_v v;
+    sfdsp::simd::float_v rise;
+    sfdsp::simd::float_v fall;
+};
 
 } // namespace
 
@@ -50,40 +71,114 @@ VectorPhaseshaper::FormantMode VectorPhaseshaper::GetFormantMode() const
     return formantMode_;
 }
 
-void VectorPhaseshaper::ProcessBlock(float* out, size_t size)
+void VectorPhaseshaper::SetAntiAliasing(AntiAliasing mode)
 {
-    if (formantMode_ == FormantMode::FREE || v_ <= 1.f)
+    if (mode != antiAliasing_)
     {
-        for (size_t i = 0; i < size; ++i)
-        {
-            phase_ += phaseIncrement_;
-            phase_ = fast_mod1(phase_);
+        oversampler_.Reset();
+    }
+    antiAliasing_ = mode;
+}
 
-            float vps = phase_distort(phase_, d_, v_);
-            out[i] = -1 * Cosine(vps);
-        }
+VectorPhaseshaper::AntiAliasing VectorPhaseshaper::GetAntiAliasing() const
+{
+    return antiAliasing_;
+}
+
+float VectorPhaseshaper::GetLatency() const
+{
+    if (antiAliasing_ == AntiAliasing::NONE)
+    {
+        return 0.f;
     }
-    else
+
+    // Only the decimation filters delay the signal. On top of that, the phase at the end of a base rate sample is
+    // reached by the last of its oversampled samples, while the decimated output lines up with the first one.
+    constexpr float kFactor = static_cast<float>(decltype(oversampler_)::kFactor);
+    return oversampler_.GetDownsampleLatency() + (kFactor - 1.f) / kFactor;
+}
+
+void VectorPhaseshaper::ProcessBlock(float* out, size_t size)
+{
+    assert(out != nullptr);
+    if (antiAliasing_ == AntiAliasing::NONE)
     {
-        assert(formantMode_ == FormantMode::RATIO);
-        const float gain = formantMode_ == FormantMode::FREE ? 0.f : fast_mod1(2.f * v_ - 1.f);
+        Render(out, size, phaseIncrement_);
+        return;
+    }
 
-        float v1 = formantMode_ == FormantMode::FREE ? v_ : ((2.f * v_) - gain) * 0.5f;
+    constexpr size_t kFactor = decltype(oversampler_)::kFactor;
+    constexpr size_t kMaxBlockSize = decltype(oversampler_)::kMaxBlockSize;
+    float oversampled[kMaxBlockSize * kFactor];
+    for (size_t start = 0; start < size; start += kMaxBlockSize)
+    {
+        const size_t count = std::min(kMaxBlockSize, size - start);
+        Render(oversampled, count * kFactor, phaseIncrement_ / kFactor);
+        oversampler_.Downsample(oversampled, out + start, count);
+    }
+}
 
-        for (size_t i = 0; i < size; ++i)
+void VectorPhaseshaper::Render(float* out, size_t size, float increment)
+{
+    using namespace simd;
+
+    // In RATIO mode, the two formants on the harmonics around v are crossfaded.
+    const bool ratio = formantMode_ == FormantMode::RATIO && v_ > 1.f;
+    const float gain = ratio ? fast_mod1(2.f * v_ - 1.f) : 0.f;
+    const float v1 = ratio ? ((2.f * v_) - gain) * 0.5f : v_;
+    const PhaseDistortion first(d_, v1);
+    const PhaseDistortion second(d_, v1 + 0.5f);
+
+    // The phases are accumulated serially, then distorted a vector at a time and the cosines evaluated on the whole
+    // chunk with the vectorized kernel. The padding at the end of a partial chunk is distorted and discarded.
+    // In RATIO mode, both formants are evaluated from the same phases, the second one right after the padded first
+    // one, so that a single `Cosine` call covers both.
+    float phases[kChunkSize] = {};
+    float distorted[2 * kChunkSize];
+    for (size_t start = 0; start < size; start += kChunkSize)
+    {
+        const size_t count = std::min(kChunkSize, size - start);
+        float phase = phase_;
+        for (size_t i = 0; i < count; ++i)
         {
-            phase_ += phaseIncrement_;
-            phase_ = fast_mod1(phase_);
-
-            float vps = phase_distort(phase_, d_, v1);
-            out[i] = -1 * Cosine(vps) * (1.f - gain);
+            phase = wrap_phase(phase + increment);
+            phases[i] = phase;
+        }
+        phase_ = phase;
 
-            if (formantMode_ == FormantMode::RATIO)
+        float* chunk = out + start;
+        if (!ratio)
+        {
+            for (size_t i = 0; i < count; i += kFloatWidth)
             {
-                float vps2 = phase_distort(phase_, d_, v1 + 0.5f);
-                out[i] += -1 * Cosine(vps2) * gain;
+                Store(distorted + i, first(Load(phases + i)));
             }
+            Cosine(distorted, chunk, count);
+            continue;
+        }
+
+        const size_t padded = PaddedSize(count);
+        float* upper = distorted + padded;
+        for (size_t i = 0; i < count; i += kFloatWidth)
+        {
+            const float_v x = Load(phases + i);
+            Store(distorted + i, first(x));
+            Store(upper + i, second(x));
+        }
+        Cosine(distorted, distorted, 2 * padded);
+
+        const float_v first_gain = Broadcast(1.f - gain);
+        const float_v second_gain = Broadcast(gain);
+        size_t i = 0;
+        for (; i + kFloatWidth <= count; i += kFloatWidth)
+        {
+            const float_v mix = Mul(Load(distorted + i), first_gain);
+            Store(chunk + i, MulAdd(Load(upper + i), second_gain, mix));
+        }
+        for (; i < count; ++i)
+        {
+            chunk[i] = distorted[i] * (1.f - gain) + upper[i] * gain;
         }
     }
 }
-} // namespace sfdsp
\ No newline at end of file
+} // namespace sfdsp
@@ -5,13 +5,21 @@
 
 #include "basic_oscillators.h"
 #include "dsp_utils.h"
+#include "fft.h"
 #include "phaseshapers.h"
-#include "sin_table.h"
 #include "test_utils.h"
+#include "vector_phaseshaper.h"
 
+#include <algorithm>
+#include <bit>
 #include <chrono>
 #include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
 #include <memory>
+#include <numbers>
+#include <vector>
 
 TEST(BasicOscillatorsTest, Sine)
 {
@@ -101,6 +109,292 @@ TEST(BasicOscillatorsTest, CosineBlock)
     }
 }
 
+TEST(BasicOscillatorsTest, SineAccuracy)
+{
+    struct Expected
+    {
+        sfdsp::SineAccuracy accuracy;
+        double max_error;
+        double max_thdn_db;
+    };
+    const Expected tiers[] = {{sfdsp::SineAccuracy::Low, 1.1e-4, -80.0},
+                              {sfdsp::SineAccuracy::Medium, 1.2e-6, -120.0},
+                              {sfdsp::SineAccuracy::High, 2e-7, -125.0}};
+
+    // Any phase is accepted, including negative ones.
+    std::vector<float> phases;
+    for (float p = -2.f; p < 3.f; p += 1.f / 4096.f)
+    {
+        phases.push_back(p);
+    }
+
+    for (const auto& tier : tiers)
+    {
+        std::vector<float> sines(phases.size());
+        std::vector<float> cosines(phases.size());
+        sfdsp::Sine(phases.data(), sines.data(), phases.size(), tier.accuracy);
+        sfdsp::Cosine(phases.data(), cosines.data(), phases.size(), tier.accuracy);
+
+        double max_error = 0.0;
+        int64_t max_ulp = 0;
+        for (size_t i = 0; i < phases.size(); ++i)
+        {
+            const double angle = 2.0 * std::numbers::pi * static_cast<double>(phases[i]);
+            max_error = std::max(max_error, std::abs(sines[i] - std::sin(angle)));
+            max_error = std::max(max_error, std::abs(cosines[i] - std::cos(angle)));
+
+            const auto expected = static_cast<float>(std::sin(angle));
+            if (std::abs(expected) > 1e-3f)
+            {
+                const auto ulp = std::abs(static_cast<int64_t>(std::bit_cast<int32_t>(sines[i])) -
+                                          static_cast<int64_t>(std::bit_cast<int32_t>(expected)));
+                max_ulp = std::max(max_ulp, ulp);
+            }
+        }
+
+        // THD+N of a 997 Hz sine at 48 kHz, the residual against the exact sine relative to the sine.
+        constexpr size_t kSize = 48000;
+        std::vector<float> osc_phases(kSize);
+        for (size_t i = 0; i < kSize; ++i)
+        {
+            osc_phases[i] = static_cast<float>(std::fmod(997.0 * static_cast<double>(i) / 48000.0, 1.0));
+        }
+        std::vector<float> osc(kSize);
+        sfdsp::Sine(osc_phases.data(), osc.data(), kSize, tier.accuracy);
+        double residual = 0.0;
+        for (size_t i = 0; i < kSize; ++i)
+        {
+            const double e = osc[i] - std::sin(2.0 * std::numbers::pi * static_cast<double>(osc_phases[i]));
+            residual += e * e;
+        }
+        const double thdn_db = 10.0 * std::log10(2.0 * residual / kSize);
+
+        printf("Accuracy %d: max error %.3g, max ULP %lld (|sin| > 1e-3), THD+N %.1f dB\n",
+               static_cast<int>(tier.accuracy), max_error, static_cast<long long>(max_ulp), thdn_db);
+        EXPECT_LT(max_error, tier.max_error);
+        EXPECT_LT(thdn_db, tier.max_thdn_db);
+    }
+
+    // The scalar functions use the medium tier.
+    for (float p : {-1.3f, -0.25f, 0.f, 0.1f, 0.5f, 0.75f, 2.9f})
+    {
+        float block = 0.f;
+        sfdsp::Sine(&p, &block, 1, sfdsp::SineAccuracy::Medium);
+        EXPECT_EQ(sfdsp::Sine(p), block);
+        sfdsp::Cosine(&p, &block, 1, sfdsp::SineAccuracy::Medium);
+        EXPECT_EQ(sfdsp::Cosine(p), block);
+    }
+}
+
+TEST(BasicOscillatorsTest, VectorPhaseshaperBlock)
+{
+    constexpr float kSamplerate = 48000.f;
+    constexpr float kFreq = 220.f;
+    constexpr size_t kSize = 1000;
+
+    auto distort = [](float x, float d, float v) {
+        return (x < d) ? v * x / d : (1 - v) * ((x - d) / (1 - d)) + v;
+    };
+
+    for (float v : {0.8f, 2.3f})
+    {
+        sfdsp::VectorPhaseshaper vps;
+        vps.Init(kSamplerate);
+        vps.SetFreq(kFreq);
+        vps.SetMod(0.3f, v);
+        vps.SetFormantMode(sfdsp::VectorPhaseshaper::FormantMode::RATIO);
+
+        std::vector<float> out(kSize);
+        vps.ProcessBlock(out.data(), 100);
+        vps.ProcessBlock(out.data() + 100, kSize - 100);
+
+        const float gain = (v > 1.f) ? sfdsp::fast_mod1(2.f * v - 1.f) : 0.f;
+        const float v1 = (v > 1.f) ? ((2.f * v) - gain) * 0.5f : v;
+        float phase = 0.f;
+        for (size_t i = 0; i < kSize; ++i)
+        {
+            phase = sfdsp::fast_mod1(phase + kFreq / kSamplerate);
+            float expected = -std::cos(TWO_PI * distort(phase, 0.3f, v1)) * (1.f - gain);
+            expected += -std::cos(TWO_PI * distort(phase, 0.3f, v1 + 0.5f)) * gain;
+            ASSERT_NEAR(out[i], expected, 1e-5f) << v << ", " << i;
+        }
+    }
+}
+
+TEST(BasicOscillatorsTest, PolyBlepBlock)
+{
+    constexpr float kSamplerate = 48000.f;
+    constexpr size_t kSize = 1000;
+
+    for (auto type : {sfdsp::OscillatorType::PolyBlepSaw, sfdsp::OscillatorType::PolyBlepSquare,
+                      sfdsp::OscillatorType::PolyBlampTri})
+    {
+        for (float freq : {440.f, 5000.f, 12345.f})
+        {
+            sfdsp::BasicOscillator tick_osc;
+            tick_osc.Init(kSamplerate, freq, type);
+            tick_osc.SetDuty(0.3f);
+            sfdsp::BasicOscillator block_osc;
+            block_osc.Init(kSamplerate, freq, type);
+            block_osc.SetDuty(0.3f);
+
+            // Odd block sizes to exercise the tail of the vector loop.
+            std::vector<float> out(kSize);
+            block_osc.ProcessBlock(out.data(), 101);
+            block_osc.ProcessBlock(out.data() + 101, kSize - 101);
+
+            // The block accumulates the phase differently, the rounding difference is amplified by the slope of the
+            // correction next to the discontinuities, about 2 / phase_increment.
+            for (size_t i = 0; i < kSize; ++i)
+            {
+                ASSERT_NEAR(out[i], tick_osc.Tick(), 5e-3f) << freq << ", " << i;
+            }
+        }
+    }
+}
+
+TEST(BasicOscillatorsTest, PolyBlepAliasing)
+{
+    // One second at an integer frequency, the harmonics fall exactly on DFT bins. Everything else is aliasing.
+    constexpr size_t kSamplerate = 48000;
+    constexpr size_t kFreq = 3001;
+
+    auto alias_db = [&](sfdsp::OscillatorType type) {
+        sfdsp::BasicOscillator osc;
+        osc.Init(kSamplerate, kFreq, type);
+        std::vector<float> out(kSamplerate);
+        osc.ProcessBlock(out.data(), out.size());
+
+        double total = 0.0;
+        double mean = 0.0;
+        for (float x : out)
+        {
+            total += static_cast<double>(x) * x;
+            mean += x;
+        }
+        mean /= kSamplerate;
+
+        double harmonics = mean * mean * kSamplerate;
+        for (size_t bin = kFreq; bin < kSamplerate / 2; bin += kFreq)
+        {
+            double re = 0.0;
+            double im = 0.0;
+            for (size_t n = 0; n < kSamplerate; ++n)
+            {
+                const double angle = 2.0 * std::numbers::pi * static_cast<double>((bin * n) % kSamplerate) / kSamplerate;
+                re += out[n] * std::cos(angle);
+                im -= out[n] * std::sin(angle);
+            }
+            harmonics += 2.0 * (re * re + im * im) / kSamplerate;
+        }
+        return 10.0 * std::log10((total - harmonics) / total);
+    };
+
+    const std::pair<sfdsp::OscillatorType, sfdsp::OscillatorType> pairs[] = {
+        {sfdsp::OscillatorType::Saw, sfdsp::OscillatorType::PolyBlepSaw},
+        {sfdsp::OscillatorType::Square, sfdsp::OscillatorType::PolyBlepSquare},
+        {sfdsp::OscillatorType::Tri, sfdsp::OscillatorType::PolyBlampTri}};
+    for (const auto& [naive_type, blep_type] : pairs)
+    {
+        const double naive = alias_db(naive_type);
+        const double blep = alias_db(blep_type);
+        printf("Aliasing: naive %.1f dB, band-limited %.1f dB\n", naive, blep);
+        EXPECT_LT(blep, naive - 10.0);
+    }
+}
+
+TEST(BasicOscillatorsTest, VectorPhaseshaperAliasing)
+{
+    // One second at an integer frequency and a power of two samplerate, the harmonics fall exactly on FFT bins.
+    // Everything else is aliasing. Only the aliasing below 0.4 * samplerate is counted, the decimation filters let
+    // through what folds into their transition band.
+    constexpr size_t kSamplerate = 65536;
+    constexpr size_t kFreq = 1501;
+    constexpr size_t kPassband = kSamplerate * 2 / 5;
+
+    using FormantMode = sfdsp::VectorPhaseshaper::FormantMode;
+    using AntiAliasing = sfdsp::VectorPhaseshaper::AntiAliasing;
+    auto alias_db = [&](FormantMode formant_mode, AntiAliasing anti_aliasing) {
+        sfdsp::VectorPhaseshaper vps;
+        vps.Init(kSamplerate);
+        vps.SetFreq(kFreq);
+        vps.SetMod(0.3f, 3.3f);
+        vps.SetFormantMode(formant_mode);
+        vps.SetAntiAliasing(anti_aliasing);
+
+        // Let the decimation filters settle before the measured second.
+        std::vector<float> out(kSamplerate);
+        vps.ProcessBlock(out.data(), 1000);
+        vps.ProcessBlock(out.data(), out.size());
+
+        sfdsp::FFT fft(kSamplerate);
+        std::vector<std::complex<float>> spectrum(kSamplerate / 2 + 1);
+        fft.Forward(out.data(), spectrum.data());
+        double total = 0.0;
+        double aliasing = 0.0;
+        for (size_t bin = 0; bin < spectrum.size(); ++bin)
+        {
+            const double power = std::norm(spectrum[bin]);
+            total += power;
+            if (bin % kFreq != 0 && bin < kPassband)
+            {
+                aliasing += power;
+            }
+        }
+        return 10.0 * std::log10(aliasing / total);
+    };
+
+    for (auto formant_mode : {FormantMode::FREE, FormantMode::RATIO})
+    {
+        const double direct = alias_db(formant_mode, AntiAliasing::NONE);
+        const double oversampled = alias_db(formant_mode, AntiAliasing::OVERSAMPLE_4X);
+        printf("Aliasing: direct %.1f dB, oversampled %.1f dB\n", direct, oversampled);
+        EXPECT_LT(oversampled, direct - 20.0);
+    }
+}
+
+TEST(BasicOscillatorsTest, VectorPhaseshaperLatency)
+{
+    // With d = v = 0.5 the output is a pure cosine, the delay of the oversampled mode is its phase lag. The increment
+    // of 1/32 cycle, and 1/128 when oversampled, is exact in float so that both phases accumulate without drift. The
+    // delay must stay below half a period to be measured unambiguously.
+    constexpr size_t kSamplerate = 48000;
+    constexpr float kFreq = 1500.f;
+    constexpr size_t kSettle = 480;
+    constexpr size_t kSize = 4800;
+
+    using AntiAliasing = sfdsp::VectorPhaseshaper::AntiAliasing;
+    auto render_phase = [&](AntiAliasing anti_aliasing, float& latency) {
+        sfdsp::VectorPhaseshaper vps;
+        vps.Init(kSamplerate);
+        vps.SetFreq(kFreq);
+        vps.SetMod(0.5f, 0.5f);
+        vps.SetAntiAliasing(anti_aliasing);
+        latency = vps.GetLatency();
+
+        std::vector<float> out(kSettle + kSize);
+        vps.ProcessBlock(out.data(), out.size());
+        double re = 0.0;
+        double im = 0.0;
+        for (size_t n = kSettle; n < out.size(); ++n)
+        {
+            const double angle = 2.0 * std::numbers::pi * kFreq * static_cast<double>(n) / kSamplerate;
+            re += out[n] * std::cos(angle);
+            im += out[n] * std::sin(angle);
+        }
+        return std::atan2(im, re);
+    };
+
+    float direct_latency = 0.f;
+    float oversampled_latency = 0.f;
+    const double direct = render_phase(AntiAliasing::NONE, direct_latency);
+    const double oversampled = render_phase(AntiAliasing::OVERSAMPLE_4X, oversampled_latency);
+    const double lag = std::remainder(oversampled - direct, 2.0 * std::numbers::pi);
+    const double delay = lag * kSamplerate / (2.0 * std::numbers::pi * kFreq);
+    EXPECT_EQ(direct_latency, 0.f);
+    EXPECT_NEAR(delay, oversampled_latency, 0.01);
+}
+
 TEST(BasicOscillatorsTest, PerfTest)
 {
     constexpr size_t kSamplerate = 48000;
@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "biquad_bank.h"
+#include "filter.h"
+
+namespace
+{
+// Stable lowpass/resonant sections with a different pole radius and angle for every channel.
+void DesignSection(size_t channel, float& b0, float& b1, float& b2, float& a1, float& a2)
+{
+    const float r = 0.5f + 0.45f * static_cast<float>(channel % 7) / 7.f;
+    const float theta = 0.1f + 0.2f * static_cast<float>(channel % 5);
+    a1 = -2.f * r * std::cos(theta);
+    a2 = r * r;
+    b0 = 0.25f;
+    b1 = 0.5f - 0.01f * static_cast<float>(channel);
+    b2 = 0.25f;
+}
+
+template <size_t N>
+void CompareWithBiquad()
+{
+    sfdsp::BiquadBank<N> bank;
+    std::array<sfdsp::Biquad, N> reference;
+
+    for (size_t c = 0; c < N; ++c)
+    {
+        float b0, b1, b2, a1, a2;
+        DesignSection(c, b0, b1, b2, a1, a2);
+        bank.SetCoefficients(c, b0, b1, b2, a1, a2);
+        reference[c].SetCoefficients(b0, b1, b2, a1, a2);
+    }
+
+    constexpr size_t kFrames = 512;
+    std::vector<float> buffer(kFrames * N);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    for (auto& s : buffer)
+    {
+        s = dist(gen);
+    }
+
+    std::vector<float> expected(buffer.size());
+    for (size_t i = 0; i < kFrames; ++i)
+    {
+        for (size_t c = 0; c < N; ++c)
+        {
+            expected[i * N + c] = reference[c].Tick(buffer[i * N + c]);
+        }
+    }
+
+    // Process in place, using both the block and the single frame API.
+    bank.ProcessBlock(buffer.data(), buffer.data(), kFrames / 2);
+    for (size_t i = kFrames / 2; i < kFrames; ++i)
+    {
+        bank.Tick(buffer.data() + i * N, buffer.data() + i * N);
+    }
+
+    for (size_t i = 0; i < buffer.size(); ++i)
+    {
+        ASSERT_NEAR(buffer[i], expected[i], 1e-4f) << "Sample " << i / N << ", channel " << i % N;
+    }
+}
+} // namespace
+
+TEST(BiquadBankTest, SingleChannel)
+{
+    CompareWithBiquad<1>();
+}
+
+TEST(BiquadBankTest, PartialVector)
+{
+    CompareWithBiquad<13>();
+}
+
+TEST(BiquadBankTest, ManyChannels)
+{
+    CompareWithBiquad<128>();
+}
+
+TEST(BiquadBankTest, Reset)
+{
+    sfdsp::BiquadBank<4> bank;
+    for (size_t c = 0; c < 4; ++c)
+    {
+        bank.SetCoefficients(c, 1.f, 0.f, 0.f, -0.9f, 0.f);
+    }
+
+    std::array<float, 4> frame = {1.f, 1.f, 1.f, 1.f};
+    bank.Tick(frame.data(), frame.data());
+    bank.Reset();
+
+    frame.fill(0.f);
+    bank.Tick(frame.data(), frame.data());
+    for (auto s : frame)
+    {
+        ASSERT_EQ(s, 0.f);
+    }
+}
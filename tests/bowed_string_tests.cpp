@@ -0,0 +1,133 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include "bowed_string.h"
+#include "denormal.h"
+#include "string_ensemble.h"
+
+namespace
+{
+constexpr size_t kSamplerate = 48000;
+
+void Bow(sfdsp::BowedString& string, float force)
+{
+    string.SetParameter(sfdsp::BowedString::ParamId::Velocity, 0.5f);
+    string.SetParameter(sfdsp::BowedString::ParamId::Force, force);
+}
+} // namespace
+
+TEST(BowedStringTest, GoesSilentAfterNoteOff)
+{
+    sfdsp::BowedString string;
+    string.Init();
+    ASSERT_TRUE(string.IsSilent());
+
+    Bow(string, 0.5f);
+    ASSERT_FALSE(string.IsSilent());
+
+    float peak = 0.f;
+    for (size_t i = 0; i < kSamplerate / 2; ++i)
+    {
+        peak = std::max(peak, std::abs(string.Tick(0.f)));
+    }
+    EXPECT_GT(peak, 0.01f);
+    EXPECT_FALSE(string.IsSilent());
+
+    Bow(string, 0.f);
+    size_t samples = 0;
+    while (!string.IsSilent() && samples < kSamplerate * 10)
+    {
+        string.Tick(0.f);
+        ++samples;
+    }
+    ASSERT_TRUE(string.IsSilent());
+
+    // Once silent, the string only outputs zeros until it is excited again.
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(string.NextOut(), 0.f);
+        ASSERT_EQ(string.Tick(0.f), 0.f);
+    }
+
+    Bow(string, 0.5f);
+    EXPECT_FALSE(string.IsSilent());
+    peak = 0.f;
+    for (size_t i = 0; i < kSamplerate / 2; ++i)
+    {
+        peak = std::max(peak, std::abs(string.Tick(0.f)));
+    }
+    EXPECT_GT(peak, 0.01f);
+}
+
+TEST(BowedStringTest, WakesUpOnInput)
+{
+    sfdsp::BowedString string;
+    string.Init();
+    ASSERT_TRUE(string.IsSilent());
+
+    // Energy coming from the bridge, e.g. from another string of an ensemble.
+    float peak = std::abs(string.Tick(0.5f));
+    EXPECT_FALSE(string.IsSilent());
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        peak = std::max(peak, std::abs(string.Tick(0.f)));
+    }
+    EXPECT_GT(peak, 0.01f);
+}
+
+TEST(BowedStringTest, EnsembleShortCircuit)
+{
+    sfdsp::StringEnsemble ensemble;
+    ensemble.Init(static_cast<float>(kSamplerate));
+    ensemble.SetBridgeTransmission(0.5f);
+    ASSERT_TRUE(ensemble.IsSilent());
+
+    std::array<float, 64> out;
+    out.fill(0.f);
+    ensemble.ProcessBlock(out.data(), out.size());
+    EXPECT_TRUE(std::all_of(out.begin(), out.end(), [](float s) { return s == 0.f; }));
+
+    Bow(ensemble[1], 0.5f);
+    ASSERT_FALSE(ensemble.IsSilent());
+
+    float peak = 0.f;
+    for (size_t i = 0; i < kSamplerate / 2; i += out.size())
+    {
+        out.fill(0.f);
+        ensemble.ProcessBlock(out.data(), out.size());
+        for (float s : out)
+        {
+            peak = std::max(peak, std::abs(s));
+        }
+    }
+    EXPECT_GT(peak, 0.01f);
+
+    Bow(ensemble[1], 0.f);
+    size_t blocks = 0;
+    while (!ensemble.IsSilent() && blocks < 10000)
+    {
+        out.fill(0.f);
+        ensemble.ProcessBlock(out.data(), out.size());
+        ++blocks;
+    }
+    EXPECT_TRUE(ensemble.IsSilent());
+}
+
+#if defined(LIBDSP_DENORMAL_X86) || defined(LIBDSP_DENORMAL_AARCH64)
+TEST(DenormalTest, ScopedFlushDenormals)
+{
+    volatile float tiny = std::numeric_limits<float>::min();
+    volatile float scale = 0.5f;
+
+    EXPECT_NE(tiny * scale, 0.f);
+    {
+        sfdsp::ScopedFlushDenormals flush_denormals;
+        EXPECT_EQ(tiny * scale, 0.f);
+    }
+    EXPECT_NE(tiny * scale, 0.f);
+}
+#endif
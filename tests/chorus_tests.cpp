@@ -0,0 +1,37 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+#include "chorus.h"
+
+TEST(ChorusTest, ProcessBlock)
+{
+    constexpr uint32_t kSamplerate = 48000;
+    constexpr size_t kSize = 2000;
+
+    std::vector<float> input(kSize);
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        input[i] = std::sin(0.05f * static_cast<float>(i));
+    }
+
+    sfdsp::Chorus tick_chorus(4096);
+    tick_chorus.Init(kSamplerate, 10.f, 100.f, 5.f);
+    std::vector<float> expected(kSize);
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        expected[i] = tick_chorus.Tick(input[i]);
+    }
+
+    sfdsp::Chorus block_chorus(4096);
+    block_chorus.Init(kSamplerate, 10.f, 100.f, 5.f);
+    std::vector<float> output(input);
+    block_chorus.ProcessBlock(output.data(), output.data(), 100);
+    block_chorus.ProcessBlock(output.data() + 100, output.data() + 100, kSize - 100);
+
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        ASSERT_NEAR(output[i], expected[i], 1e-5f) << i;
+    }
+}
@@ -0,0 +1,398 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+
+#include "filter.h"
+#include "parallel_filter.h"
+#include "state_variable_filter.h"
+#include "termination.h"
+
+namespace
+{
+constexpr size_t kSize = 256;
+
+std::array<float, kSize> MakeNoise()
+{
+    std::array<float, kSize> noise;
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    for (auto& s : noise)
+    {
+        s = dist(gen);
+    }
+    return noise;
+}
+
+// The static filters must produce exactly the same output as their virtual counterparts, both with `Tick()` and
+// `ProcessBlock()`.
+template <typename VirtualFilter, typename StaticFilter>
+void CompareFilters(VirtualFilter& reference, StaticFilter& tick_filter, StaticFilter& block_filter)
+{
+    const auto input = MakeNoise();
+
+    std::array<float, kSize> expected;
+    reference.ProcessBlock(const_cast<float*>(input.data()), expected.data(), kSize);
+
+    std::array<float, kSize> block_out;
+    block_filter.ProcessBlock(input.data(), block_out.data(), kSize / 2);
+    block_filter.ProcessBlock(input.data() + kSize / 2, block_out.data() + kSize / 2, kSize / 2);
+
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        ASSERT_EQ(tick_filter.Tick(input[i]), expected[i]) << "Sample " << i;
+        ASSERT_EQ(block_out[i], expected[i]) << "Sample " << i;
+    }
+}
+
+// Magnitude response of a biquad at the normalized frequency f (f / samplerate).
+float Magnitude(const sfdsp::BiquadCoefficients& c, float f)
+{
+    const std::complex<float> z1 = std::polar(1.f, -TWO_PI * f);
+    const std::complex<float> z2 = z1 * z1;
+    return std::abs((c.b0 + c.b1 * z1 + c.b2 * z2) / (1.f + c.a1 * z1 + c.a2 * z2));
+}
+} // namespace
+
+TEST(StaticFilterTest, OnePole)
+{
+    sfdsp::OnePoleFilter reference;
+    sfdsp::StaticOnePoleFilter tick_filter, block_filter;
+    reference.SetLowpass(0.1f);
+    reference.SetGain(0.9f);
+    tick_filter.SetLowpass(0.1f);
+    tick_filter.SetGain(0.9f);
+    block_filter = tick_filter;
+
+    CompareFilters(reference, tick_filter, block_filter);
+}
+
+TEST(StaticFilterTest, OneZero)
+{
+    sfdsp::OneZeroFilter reference;
+    sfdsp::StaticOneZeroFilter tick_filter, block_filter;
+    reference.SetB({0.5f, 0.5f, 0.f});
+    tick_filter.SetB({0.5f, 0.5f, 0.f});
+    block_filter = tick_filter;
+
+    CompareFilters(reference, tick_filter, block_filter);
+}
+
+TEST(StaticFilterTest, TwoPole)
+{
+    sfdsp::TwoPoleFilter reference;
+    sfdsp::StaticTwoPoleFilter tick_filter, block_filter;
+    reference.SetB({0.3f, 0.f, 0.f});
+    reference.SetA({1.f, -1.2f, 0.5f});
+    tick_filter.SetB({0.3f, 0.f, 0.f});
+    tick_filter.SetA({1.f, -1.2f, 0.5f});
+    block_filter = tick_filter;
+
+    CompareFilters(reference, tick_filter, block_filter);
+}
+
+TEST(StaticFilterTest, TwoZero)
+{
+    sfdsp::TwoZeroFilter reference;
+    sfdsp::StaticTwoZeroFilter tick_filter, block_filter;
+    reference.SetB({0.25f, 0.5f, 0.25f});
+    reference.SetGain(2.f);
+    tick_filter.SetB({0.25f, 0.5f, 0.25f});
+    tick_filter.SetGain(2.f);
+    block_filter = tick_filter;
+
+    CompareFilters(reference, tick_filter, block_filter);
+}
+
+TEST(StaticFilterTest, Biquad)
+{
+    sfdsp::Biquad reference;
+    sfdsp::StaticBiquad tick_filter, block_filter;
+    reference.SetCoefficients(1.0f, -1.6683f, 0.8852f, -1.7674f, 0.8735f);
+    reference.SetGain(0.5f);
+    tick_filter.SetCoefficients(1.0f, -1.6683f, 0.8852f, -1.7674f, 0.8735f);
+    tick_filter.SetGain(0.5f);
+    block_filter = tick_filter;
+
+    CompareFilters(reference, tick_filter, block_filter);
+}
+
+TEST(StaticFilterTest, Termination)
+{
+    sfdsp::OnePoleFilter virtual_filter;
+    virtual_filter.SetPole(0.6f);
+    sfdsp::Termination<> virtual_termination(-0.9f);
+    virtual_termination.SetFilter(&virtual_filter);
+
+    sfdsp::StaticOnePoleFilter static_filter;
+    static_filter.SetPole(0.6f);
+    sfdsp::Termination<sfdsp::StaticOnePoleFilter> static_termination(-0.9f);
+    static_termination.SetFilter(&static_filter);
+
+    const auto input = MakeNoise();
+    for (auto s : input)
+    {
+        ASSERT_EQ(virtual_termination.Tick(s), static_termination.Tick(s));
+    }
+}
+
+TEST(BiquadDesignTest, Responses)
+{
+    constexpr float kCutoff = 1000.f / 48000.f;
+    constexpr float kQ = 0.7071f;
+
+    auto lp = sfdsp::DesignBiquad(sfdsp::BiquadType::Lowpass, kCutoff, kQ);
+    ASSERT_NEAR(Magnitude(lp, 0.f), 1.f, 1e-4f);
+    ASSERT_NEAR(Magnitude(lp, kCutoff), std::sqrt(0.5f), 1e-3f);
+    ASSERT_NEAR(Magnitude(lp, 0.5f), 0.f, 1e-4f);
+
+    auto hp = sfdsp::DesignBiquad(sfdsp::BiquadType::Highpass, kCutoff, kQ);
+    ASSERT_NEAR(Magnitude(hp, 0.f), 0.f, 1e-4f);
+    ASSERT_NEAR(Magnitude(hp, 0.5f), 1.f, 1e-4f);
+
+    auto bp = sfdsp::DesignBiquad(sfdsp::BiquadType::Bandpass, kCutoff, 2.f);
+    ASSERT_NEAR(Magnitude(bp, kCutoff), 1.f, 1e-3f);
+    ASSERT_NEAR(Magnitude(bp, 0.f), 0.f, 1e-4f);
+
+    auto notch = sfdsp::DesignBiquad(sfdsp::BiquadType::Notch, kCutoff, 2.f);
+    ASSERT_NEAR(Magnitude(notch, kCutoff), 0.f, 1e-3f);
+    ASSERT_NEAR(Magnitude(notch, 0.f), 1.f, 1e-4f);
+
+    auto ap = sfdsp::DesignBiquad(sfdsp::BiquadType::Allpass, kCutoff, kQ);
+    ASSERT_NEAR(Magnitude(ap, 0.1f), 1.f, 1e-4f);
+
+    constexpr float kGainDb = 6.f;
+    const float gain = std::pow(10.f, kGainDb / 20.f);
+    auto peak = sfdsp::DesignBiquad(sfdsp::BiquadType::Peak, kCutoff, 1.f, kGainDb);
+    ASSERT_NEAR(Magnitude(peak, kCutoff), gain, 1e-3f);
+    ASSERT_NEAR(Magnitude(peak, 0.f), 1.f, 1e-4f);
+
+    auto low_shelf = sfdsp::DesignBiquad(sfdsp::BiquadType::LowShelf, kCutoff, kQ, kGainDb);
+    ASSERT_NEAR(Magnitude(low_shelf, 0.f), gain, 1e-3f);
+    ASSERT_NEAR(Magnitude(low_shelf, 0.5f), 1.f, 1e-3f);
+
+    auto high_shelf = sfdsp::DesignBiquad(sfdsp::BiquadType::HighShelf, kCutoff, kQ, kGainDb);
+    ASSERT_NEAR(Magnitude(high_shelf, 0.f), 1.f, 1e-3f);
+    ASSERT_NEAR(Magnitude(high_shelf, 0.5f), gain, 1e-3f);
+}
+
+TEST(InterpolatedBiquadTest, MatchesBiquadWithoutModulation)
+{
+    const auto coeffs = sfdsp::DesignBiquad(sfdsp::BiquadType::Lowpass, 0.05f, 2.f);
+    sfdsp::InterpolatedBiquad filter;
+    filter.SetCoefficients(coeffs);
+    sfdsp::StaticBiquad reference;
+    reference.SetCoefficients(coeffs);
+
+    const auto input = MakeNoise();
+    std::array<float, kSize> out;
+    filter.ProcessBlock(input.data(), out.data(), kSize);
+
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        ASSERT_NEAR(out[i], reference.Tick(input[i]), 1e-5f);
+    }
+}
+
+TEST(InterpolatedBiquadTest, AudioRateSweep)
+{
+    // Sweep a resonant lowpass from 20 Hz to 20 kHz and back, updating the target every 16 samples.
+    constexpr float kSamplerate = 48000.f;
+    constexpr size_t kBlockSize = 16;
+    constexpr size_t kBlockCount = 2000;
+
+    sfdsp::InterpolatedBiquad filter;
+    filter.SetCoefficients(sfdsp::DesignBiquad(sfdsp::BiquadType::Lowpass, 20.f / kSamplerate, 10.f));
+
+    const auto input = MakeNoise();
+    std::array<float, kBlockSize> out;
+    for (size_t b = 0; b < kBlockCount; ++b)
+    {
+        const float t = static_cast<float>(b) / kBlockCount;
+        const float sweep = 1.f - std::abs(2.f * t - 1.f);
+        const float cutoff = 20.f * std::pow(1000.f, sweep) / kSamplerate;
+        const auto target = sfdsp::DesignBiquad(sfdsp::BiquadType::Lowpass, cutoff, 10.f);
+        filter.SetTarget(target);
+        filter.ProcessBlock(input.data() + (b * kBlockSize) % kSize, out.data(), kBlockSize);
+
+        const auto current = filter.GetCoefficients();
+        ASSERT_EQ(current.a1, target.a1);
+        ASSERT_EQ(current.a2, target.a2);
+        for (auto s : out)
+        {
+            ASSERT_TRUE(std::isfinite(s));
+            ASSERT_LT(std::abs(s), 100.f);
+        }
+    }
+}
+
+namespace
+{
+// Steady state amplitude of the filter output for a sine input at `freq`.
+float SineResponse(sfdsp::StateVariableFilter& svf, float freq, float samplerate, int output)
+{
+    svf.Reset();
+    constexpr size_t kLength = 48000;
+    float peak = 0.f;
+    for (size_t i = 0; i < kLength; ++i)
+    {
+        const float x = std::sin(TWO_PI * freq * static_cast<float>(i) / samplerate);
+        float out[3];
+        svf.Tick(x, out[0], out[1], out[2]);
+        if (i > kLength / 2)
+        {
+            peak = std::max(peak, std::abs(out[output]));
+        }
+    }
+    return peak;
+}
+} // namespace
+
+TEST(StateVariableFilterTest, Responses)
+{
+    constexpr float kSamplerate = 48000.f;
+    sfdsp::StateVariableFilter svf;
+    svf.Init(kSamplerate);
+    svf.SetCutoff(1000.f);
+    svf.SetQ(0.7071f);
+
+    constexpr int kLowpass = 0;
+    constexpr int kBandpass = 1;
+    constexpr int kHighpass = 2;
+
+    ASSERT_NEAR(SineResponse(svf, 50.f, kSamplerate, kLowpass), 1.f, 1e-2f);
+    ASSERT_NEAR(SineResponse(svf, 1000.f, kSamplerate, kLowpass), std::sqrt(0.5f), 1e-2f);
+    ASSERT_LT(SineResponse(svf, 10000.f, kSamplerate, kLowpass), 0.02f);
+
+    ASSERT_NEAR(SineResponse(svf, 15000.f, kSamplerate, kHighpass), 1.f, 1e-2f);
+    ASSERT_LT(SineResponse(svf, 50.f, kSamplerate, kHighpass), 0.01f);
+
+    // Bandpass peak gain is 1/k = Q
+    ASSERT_NEAR(SineResponse(svf, 1000.f, kSamplerate, kBandpass), 0.7071f, 1e-2f);
+}
+
+TEST(StateVariableFilterTest, BlockMatchesTick)
+{
+    sfdsp::StateVariableFilter tick_svf, block_svf, modulated_svf;
+    for (auto* svf : {&tick_svf, &block_svf, &modulated_svf})
+    {
+        svf->Init(48000.f);
+        svf->SetCutoff(2000.f);
+        svf->SetQ(4.f);
+    }
+
+    const auto input = MakeNoise();
+    std::array<float, kSize> lp, bp, hp;
+    block_svf.ProcessBlock(input.data(), lp.data(), bp.data(), hp.data(), kSize);
+
+    // A constant cutoff buffer should give (almost) the same result, the only difference being the table lookup.
+    std::array<float, kSize> cutoff;
+    cutoff.fill(2000.f);
+    std::array<float, kSize> mod_hp;
+    modulated_svf.ProcessBlock(input.data(), cutoff.data(), nullptr, nullptr, mod_hp.data(), kSize);
+
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        float tick_lp, tick_bp, tick_hp;
+        tick_svf.Tick(input[i], tick_lp, tick_bp, tick_hp);
+        ASSERT_FLOAT_EQ(lp[i], tick_lp);
+        ASSERT_FLOAT_EQ(bp[i], tick_bp);
+        ASSERT_NEAR(hp[i], tick_hp, 1e-6f);
+        ASSERT_NEAR(mod_hp[i], tick_hp, 1e-3f);
+    }
+
+    // The modes should always sum back to the input: x = hp + k * bp + lp
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        ASSERT_NEAR(hp[i] + 0.25f * bp[i] + lp[i], input[i], 1e-5f);
+    }
+}
+
+TEST(StateVariableFilterTest, AudioRateModulation)
+{
+    constexpr float kSamplerate = 48000.f;
+    sfdsp::StateVariableFilter svf;
+    svf.Init(kSamplerate);
+    svf.SetQ(20.f);
+
+    // Cutoff modulated by a 2 kHz sine between 20 Hz and 23.5 kHz, the filter must stay bounded.
+    constexpr size_t kLength = 48000;
+    std::vector<float> cutoff(kLength);
+    std::vector<float> buffer(kLength);
+    const auto noise = MakeNoise();
+    for (size_t i = 0; i < kLength; ++i)
+    {
+        const float lfo = 0.5f + 0.5f * std::sin(TWO_PI * 2000.f * static_cast<float>(i) / kSamplerate);
+        cutoff[i] = 20.f + lfo * 23500.f;
+        buffer[i] = noise[i % kSize];
+    }
+
+    svf.ProcessBlock(buffer.data(), cutoff.data(), buffer.data(), nullptr, nullptr, kLength);
+    for (auto s : buffer)
+    {
+        ASSERT_TRUE(std::isfinite(s));
+        ASSERT_LT(std::abs(s), 100.f);
+    }
+    ASSERT_EQ(svf.GetCutoff(), cutoff.back());
+}
+
+TEST(ParallelFilterTest, StringBodyFilter)
+{
+    // Body filter from StringEnsemble
+    const std::array<sfdsp::BiquadCoefficients, 6> cascade = {{
+        {1.0f, 1.5667f, 0.3133f, -0.5509f, -0.3925f},
+        {1.0f, -1.9537f, 0.9542f, -1.6357f, 0.8697f},
+        {1.0f, -1.6683f, 0.8852f, -1.7674f, 0.8735f},
+        {1.0f, -1.8585f, 0.9653f, -1.8498f, 0.9516f},
+        {1.0f, -1.9299f, 0.9621f, -1.9354f, 0.9590f},
+        {1.0f, -1.9800f, 0.9888f, -1.9867f, 0.9923f},
+    }};
+    constexpr float kGain = 0.1248f;
+
+    std::array<sfdsp::StaticBiquad, 6> serial;
+    for (size_t i = 0; i < serial.size(); ++i)
+    {
+        serial[i].SetCoefficients(cascade[i]);
+    }
+    serial[5].SetGain(kGain);
+
+    sfdsp::ParallelFilter<6> parallel;
+    ASSERT_TRUE(parallel.SetCascade(cascade, kGain));
+
+    constexpr size_t kLength = 4096;
+    std::vector<float> expected(kLength, 0.f);
+    expected[0] = 1.f;
+    for (auto& f : serial)
+    {
+        f.ProcessBlock(expected.data(), expected.data(), kLength);
+    }
+
+    std::vector<float> out(kLength, 0.f);
+    out[0] = 1.f;
+    parallel.ProcessBlock(out.data(), out.data(), kLength);
+
+    float peak = 0.f;
+    for (auto s : expected)
+    {
+        peak = std::max(peak, std::abs(s));
+    }
+
+    for (size_t i = 0; i < kLength; ++i)
+    {
+        ASSERT_NEAR(out[i], expected[i], 1e-4f * peak) << "Sample " << i;
+    }
+}
+
+TEST(ParallelFilterTest, RejectsFirstOrderSections)
+{
+    const std::array<sfdsp::BiquadCoefficients, 2> cascade = {{
+        {1.0f, 0.5f, 0.f, -0.5f, 0.f},
+        {1.0f, 0.f, 0.f, -1.f, 0.5f},
+    }};
+    sfdsp::ParallelFilter<2> parallel;
+    ASSERT_FALSE(parallel.SetCascade(cascade));
+}
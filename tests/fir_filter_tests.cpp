@@ -0,0 +1,250 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <vector>
+
+#include "fft.h"
+#include "fir_filter.h"
+#include "test_utils.h"
+
+namespace
+{
+float Magnitude(const std::vector<float>& taps, float f)
+{
+    std::complex<double> h = 0.0;
+    for (size_t k = 0; k < taps.size(); ++k)
+    {
+        h += static_cast<double>(taps[k]) * std::polar(1.0, -2.0 * std::numbers::pi * f * static_cast<double>(k));
+    }
+    return static_cast<float>(std::abs(h));
+}
+} // namespace
+
+TEST(FFTTest, MatchesDft)
+{
+    constexpr size_t kFftSize = 64;
+    const auto input = MakeNoise(kFftSize);
+
+    sfdsp::FFT fft(kFftSize);
+    std::vector<std::complex<float>> spectrum(kFftSize / 2 + 1);
+    fft.Forward(input.data(), spectrum.data());
+
+    for (size_t k = 0; k <= kFftSize / 2; ++k)
+    {
+        std::complex<double> expected = 0.0;
+        for (size_t n = 0; n < kFftSize; ++n)
+        {
+            expected += static_cast<double>(input[n]) *
+                        std::polar(1.0, -2.0 * std::numbers::pi * static_cast<double>(k * n) / kFftSize);
+        }
+        ASSERT_NEAR(spectrum[k].real(), expected.real(), 1e-4);
+        ASSERT_NEAR(spectrum[k].imag(), expected.imag(), 1e-4);
+    }
+}
+
+TEST(FFTTest, RoundTrip)
+{
+    for (size_t size : {4, 8, 256, 4096})
+    {
+        const auto input = MakeNoise(size);
+
+        sfdsp::FFT fft(size);
+        std::vector<std::complex<float>> spectrum(size / 2 + 1);
+        std::vector<float> output(size);
+        fft.Forward(input.data(), spectrum.data());
+        fft.Inverse(spectrum.data(), output.data());
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            ASSERT_NEAR(output[i], input[i], 1e-5) << "size " << size;
+        }
+    }
+}
+
+TEST(FirFilterTest, DirectForm)
+{
+    const auto taps = MakeNoise(37, 42);
+    const auto input = MakeNoise(1000);
+    const auto expected = Convolve(input, taps);
+
+    sfdsp::FirFilter block_filter;
+    block_filter.SetTaps(taps.data(), taps.size());
+    ASSERT_FALSE(block_filter.UsesFft());
+
+    sfdsp::FirFilter tick_filter;
+    tick_filter.SetTaps(taps.data(), taps.size());
+
+    // Odd block sizes to exercise the history wrap around.
+    std::vector<float> output(input.size());
+    size_t offset = 0;
+    size_t block = 1;
+    while (offset < input.size())
+    {
+        const size_t size = std::min(block, input.size() - offset);
+        block_filter.ProcessBlock(input.data() + offset, output.data() + offset, size);
+        offset += size;
+        block = (block * 7) % 97 + 1;
+    }
+
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        ASSERT_NEAR(output[i], expected[i], 1e-5);
+        ASSERT_NEAR(tick_filter.Tick(input[i]), expected[i], 1e-5);
+    }
+}
+
+TEST(FirFilterTest, FftBlockConvolution)
+{
+    const auto taps = MakeNoise(300, 42);
+    const auto input = MakeNoise(5000);
+    const auto expected = Convolve(input, taps);
+
+    sfdsp::FirFilter filter;
+    filter.SetTaps(taps.data(), taps.size());
+    ASSERT_TRUE(filter.UsesFft());
+
+    // Blocks shorter and longer than a partition, that start anywhere in a partition, and single samples.
+    std::vector<float> output(input.size());
+    size_t offset = 0;
+    size_t block = 3;
+    while (offset < input.size())
+    {
+        const size_t size = std::min(block, input.size() - offset);
+        if (size == 1)
+        {
+            output[offset] = filter.Tick(input[offset]);
+        }
+        else
+        {
+            filter.ProcessBlock(input.data() + offset, output.data() + offset, size);
+        }
+        offset += size;
+        block = (block * 13) % 701 + 1;
+    }
+
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        ASSERT_NEAR(output[i], expected[i], 1e-4);
+    }
+
+    filter.Reset();
+    std::vector<float> in_place = input;
+    filter.ProcessBlock(in_place.data(), in_place.data(), in_place.size());
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        ASSERT_NEAR(in_place[i], expected[i], 1e-4);
+    }
+}
+
+TEST(FirFilterTest, FftSmallBlocks)
+{
+    // A long filter driven with realtime block sizes runs the partitioned convolution, not the direct form.
+    const auto taps = MakeNoise(2048, 42);
+    const auto input = MakeNoise(10000);
+    const auto expected = Convolve(input, taps);
+
+    sfdsp::FirFilter filter;
+    filter.SetTaps(taps.data(), taps.size());
+    ASSERT_TRUE(filter.UsesFft());
+
+    constexpr size_t kBlockSize = 64;
+    std::vector<float> output(input.size());
+    for (size_t offset = 0; offset < input.size(); offset += kBlockSize)
+    {
+        const size_t size = std::min(kBlockSize, input.size() - offset);
+        filter.ProcessBlock(input.data() + offset, output.data() + offset, size);
+    }
+
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        ASSERT_NEAR(output[i], expected[i], 1e-3) << i;
+    }
+}
+
+TEST(FirFilterTest, DesignLowpass)
+{
+    for (auto window : {sfdsp::WindowType::Hann, sfdsp::WindowType::Blackman, sfdsp::WindowType::Kaiser})
+    {
+        std::vector<float> taps(101);
+        sfdsp::DesignLowpassFir(taps.data(), taps.size(), 0.1f, window);
+
+        for (size_t i = 0; i < taps.size() / 2; ++i)
+        {
+            ASSERT_FLOAT_EQ(taps[i], taps[taps.size() - 1 - i]);
+        }
+
+        EXPECT_NEAR(Magnitude(taps, 0.f), 1.f, 1e-5);
+        EXPECT_NEAR(Magnitude(taps, 0.05f), 1.f, 1e-2);
+        EXPECT_NEAR(Magnitude(taps, 0.1f), 0.5f, 0.05f);
+        EXPECT_LT(Magnitude(taps, 0.2f), 1e-3f);
+        EXPECT_LT(Magnitude(taps, 0.4f), 1e-3f);
+    }
+}
+
+TEST(FirFilterTest, Decimator)
+{
+    constexpr size_t kFactor = 3;
+    std::vector<float> taps(48);
+    sfdsp::DesignLowpassFir(taps.data(), taps.size(), 0.5f / kFactor);
+
+    const auto input = MakeNoise(1000);
+    const auto filtered = Convolve(input, taps);
+
+    sfdsp::FirDecimator decimator;
+    decimator.Init(kFactor, taps.data(), taps.size());
+
+    std::vector<float> output(input.size() / kFactor + 16);
+    size_t in_offset = 0;
+    size_t out_count = 0;
+    size_t block = 5;
+    while (in_offset < input.size())
+    {
+        const size_t size = std::min(block, input.size() - in_offset);
+        out_count += decimator.ProcessBlock(input.data() + in_offset, output.data() + out_count, size);
+        in_offset += size;
+        block = (block * 7) % 130 + 1;
+    }
+
+    ASSERT_EQ(out_count, (input.size() + kFactor - 1) / kFactor);
+    for (size_t i = 0; i < out_count; ++i)
+    {
+        ASSERT_NEAR(output[i], filtered[i * kFactor], 1e-5);
+    }
+}
+
+TEST(FirFilterTest, Interpolator)
+{
+    constexpr size_t kFactor = 4;
+    std::vector<float> taps(61);
+    sfdsp::DesignLowpassFir(taps.data(), taps.size(), 0.5f / kFactor, sfdsp::WindowType::Kaiser,
+                            static_cast<float>(kFactor));
+
+    const auto input = MakeNoise(500);
+    std::vector<float> upsampled(input.size() * kFactor, 0.f);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        upsampled[i * kFactor] = input[i];
+    }
+    const auto expected = Convolve(upsampled, taps);
+
+    sfdsp::FirInterpolator interpolator;
+    interpolator.Init(kFactor, taps.data(), taps.size());
+
+    std::vector<float> output(input.size() * kFactor);
+    size_t offset = 0;
+    size_t block = 2;
+    while (offset < input.size())
+    {
+        const size_t size = std::min(block, input.size() - offset);
+        interpolator.ProcessBlock(input.data() + offset, output.data() + offset * kFactor, size);
+        offset += size;
+        block = (block * 5) % 83 + 1;
+    }
+
+    for (size_t i = 0; i < output.size(); ++i)
+    {
+        ASSERT_NEAR(output[i], expected[i], 1e-5);
+    }
+}
@@ -0,0 +1,162 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "halfband.h"
+#include "test_utils.h"
+
+namespace
+{
+// The full half-band filter, zero taps and center tap included.
+std::vector<float> FullTaps(size_t tap_count)
+{
+    const auto half = sfdsp::DesignHalfbandFir(tap_count);
+    std::vector<float> taps(tap_count, 0.f);
+    for (size_t i = 0; i < half.size(); ++i)
+    {
+        taps[2 * i] = half[i];
+    }
+    taps[(tap_count - 1) / 2] = 0.5f;
+    return taps;
+}
+
+// Processes `input` in blocks of varying size.
+template <typename ProcessFn>
+void ProcessInBlocks(size_t size, ProcessFn&& process)
+{
+    size_t offset = 0;
+    size_t block = 3;
+    while (offset < size)
+    {
+        const size_t count = std::min(block, size - offset);
+        process(offset, count);
+        offset += count;
+        block = (block * 7) % 150 + 1;
+    }
+}
+} // namespace
+
+TEST(HalfbandTest, DesignFir)
+{
+    const auto taps = FullTaps(31);
+    float sum = 0.f;
+    for (size_t i = 0; i < taps.size(); ++i)
+    {
+        EXPECT_FLOAT_EQ(taps[i], taps[taps.size() - 1 - i]);
+        sum += taps[i];
+    }
+    EXPECT_NEAR(sum, 1.f, 1e-6f);
+}
+
+TEST(HalfbandTest, FirDecimator)
+{
+    constexpr size_t kTaps = 31;
+    const auto input = MakeNoise(2000);
+    const auto expected = Convolve(input, FullTaps(kTaps));
+
+    sfdsp::HalfbandFirDecimator decimator;
+    decimator.Init(kTaps);
+    EXPECT_FLOAT_EQ(decimator.GetLatency(), 7.5f);
+
+    std::vector<float> output(input.size() / 2);
+    ProcessInBlocks(output.size(), [&](size_t offset, size_t count) {
+        decimator.ProcessBlock(input.data() + 2 * offset, output.data() + offset, count);
+    });
+
+    for (size_t i = 0; i < output.size(); ++i)
+    {
+        ASSERT_NEAR(output[i], expected[2 * i], 1e-5f) << i;
+    }
+}
+
+TEST(HalfbandTest, FirInterpolator)
+{
+    constexpr size_t kTaps = 47;
+    const auto input = MakeNoise(1000);
+    std::vector<float> upsampled(input.size() * 2, 0.f);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        upsampled[2 * i] = 2.f * input[i];
+    }
+    const auto expected = Convolve(upsampled, FullTaps(kTaps));
+
+    sfdsp::HalfbandFirInterpolator interpolator;
+    interpolator.Init(kTaps);
+
+    std::vector<float> output(input.size() * 2);
+    ProcessInBlocks(input.size(), [&](size_t offset, size_t count) {
+        interpolator.ProcessBlock(input.data() + offset, output.data() + 2 * offset, count);
+    });
+
+    for (size_t i = 0; i < output.size(); ++i)
+    {
+        ASSERT_NEAR(output[i], expected[i], 1e-5f) << i;
+    }
+}
+
+TEST(HalfbandTest, DesignIir)
+{
+    float coefs[sfdsp::kMaxHalfbandIirCoefs];
+    const size_t count = sfdsp::DesignHalfbandIir(coefs, sfdsp::kMaxHalfbandIirCoefs, 96.f, 0.05f);
+    EXPECT_GT(count, 4u);
+    EXPECT_LT(count, sfdsp::kMaxHalfbandIirCoefs);
+    for (size_t i = 0; i < count; ++i)
+    {
+        EXPECT_GT(coefs[i], 0.f);
+        EXPECT_LT(coefs[i], 1.f);
+        if (i > 0)
+        {
+            EXPECT_GT(coefs[i], coefs[i - 1]);
+        }
+    }
+
+    // Limiting the number of coefficients.
+    EXPECT_EQ(sfdsp::DesignHalfbandIir(coefs, 3, 96.f, 0.05f), 3u);
+}
+
+TEST(HalfbandTest, IirDecimator)
+{
+    // Frequencies relative to the input samplerate. 0.45 is in the stopband and would alias to 0.05.
+    for (float freq : {0.05f, 0.2f, 0.45f, 0.3f})
+    {
+        const auto input = MakeSine(freq, 8192);
+        std::vector<float> output(input.size() / 2);
+
+        sfdsp::HalfbandIirDecimator decimator;
+        decimator.Init(96.f, 0.05f);
+        ProcessInBlocks(output.size(), [&](size_t offset, size_t count) {
+            decimator.ProcessBlock(input.data() + 2 * offset, output.data() + offset, count);
+        });
+
+        const float output_freq = (freq < 0.25f) ? 2.f * freq : 1.f - 2.f * freq;
+        const float amplitude = Amplitude(output, output_freq, output.size() / 2);
+        if (freq < 0.225f)
+        {
+            EXPECT_NEAR(amplitude, 1.f, 1e-3f) << freq;
+        }
+        else
+        {
+            EXPECT_LT(amplitude, 1e-4f) << freq;
+        }
+    }
+}
+
+TEST(HalfbandTest, IirInterpolator)
+{
+    // Frequency relative to the input samplerate. The image sits at 1 - freq.
+    for (float freq : {0.1f, 0.4f})
+    {
+        const auto input = MakeSine(freq, 4096);
+        std::vector<float> output(input.size() * 2);
+
+        sfdsp::HalfbandIirInterpolator interpolator;
+        interpolator.Init(96.f, 0.05f);
+        ProcessInBlocks(input.size(), [&](size_t offset, size_t count) {
+            interpolator.ProcessBlock(input.data() + offset, output.data() + 2 * offset, count);
+        });
+
+        EXPECT_NEAR(Amplitude(output, freq / 2.f, output.size() / 2), 1.f, 1e-3f) << freq;
+        EXPECT_LT(Amplitude(output, (1.f - freq) / 2.f, output.size() / 2), 1e-4f) << freq;
+    }
+}
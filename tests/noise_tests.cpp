@@ -0,0 +1,205 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "fft.h"
+#include "filter.h"
+#include "noise.h"
+
+namespace
+{
+double Mean(const std::vector<float>& x)
+{
+    double sum = 0.0;
+    for (float v : x)
+    {
+        sum += v;
+    }
+    return sum / static_cast<double>(x.size());
+}
+
+/// @brief Normalized autocorrelation at a lag.
+double Autocorrelation(const std::vector<float>& x, size_t lag)
+{
+    double num = 0.0;
+    double den = 0.0;
+    for (size_t i = 0; i + lag < x.size(); ++i)
+    {
+        num += static_cast<double>(x[i]) * x[i + lag];
+        den += static_cast<double>(x[i]) * x[i];
+    }
+    return num / den;
+}
+} // namespace
+
+TEST(NoiseGeneratorTest, Distribution)
+{
+    constexpr size_t kSize = 1 << 18;
+    sfdsp::NoiseGenerator noise;
+    std::vector<float> out(kSize);
+    noise.Fill(out.data(), out.size());
+
+    double variance = 0.0;
+    for (float v : out)
+    {
+        ASSERT_GE(v, -1.f);
+        ASSERT_LT(v, 1.f);
+        variance += static_cast<double>(v) * v;
+    }
+    variance /= kSize;
+
+    // Uniform in [-1, 1): mean 0, variance 1/3.
+    EXPECT_NEAR(Mean(out), 0.0, 0.01);
+    EXPECT_NEAR(variance, 1.0 / 3.0, 0.01);
+
+    // The lanes are independent, including at the lag of one step.
+    for (size_t lag = 1; lag <= 2 * sfdsp::NoiseGenerator::kLaneCount; ++lag)
+    {
+        EXPECT_NEAR(Autocorrelation(out, lag), 0.0, 0.01) << lag;
+    }
+}
+
+TEST(NoiseGeneratorTest, Seed)
+{
+    constexpr size_t kSize = 1000;
+    sfdsp::NoiseGenerator a(42);
+    sfdsp::NoiseGenerator b(42);
+    sfdsp::NoiseGenerator c(43);
+
+    std::vector<float> out_a(kSize);
+    std::vector<float> out_b(kSize);
+    std::vector<float> out_c(kSize);
+    a.Fill(out_a.data(), kSize);
+    b.Fill(out_b.data(), kSize);
+    c.Fill(out_c.data(), kSize);
+    EXPECT_EQ(out_a, out_b);
+    EXPECT_NE(out_a, out_c);
+
+    // Reseeding restarts the sequence.
+    a.Seed(42);
+    a.Fill(out_b.data(), kSize);
+    EXPECT_EQ(out_a, out_b);
+
+    // 0 is a valid seed.
+    sfdsp::NoiseGenerator zero(0);
+    zero.Fill(out_c.data(), kSize);
+    EXPECT_TRUE(std::any_of(out_c.begin(), out_c.end(), [](float v) { return v != 0.f; }));
+}
+
+TEST(NoiseGeneratorTest, TickAndFill)
+{
+    constexpr size_t kSize = 1000;
+    sfdsp::NoiseGenerator reference(7);
+    std::vector<float> expected(kSize);
+    reference.Fill(expected.data(), kSize);
+
+    // Mixing Tick and Fill of odd sizes gives the same sequence.
+    sfdsp::NoiseGenerator noise(7);
+    std::vector<float> out(kSize);
+    size_t i = 0;
+    for (size_t block = 1; i < kSize; block = (block * 3 + 1) % 23)
+    {
+        out[i++] = noise.Tick();
+        const size_t count = std::min(block, kSize - i);
+        noise.Fill(out.data() + i, count);
+        i += count;
+    }
+    EXPECT_EQ(out, expected);
+}
+
+TEST(NoiseGeneratorTest, Threads)
+{
+    // One instance per thread, each must produce the same sequence as when run alone.
+    constexpr size_t kSize = 1 << 16;
+    constexpr size_t kThreadCount = 4;
+    std::vector<std::vector<float>> outputs(kThreadCount, std::vector<float>(kSize));
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kThreadCount; ++t)
+    {
+        threads.emplace_back([&outputs, t]() {
+            sfdsp::NoiseGenerator noise(static_cast<uint32_t>(t));
+            for (size_t i = 0; i < kSize; ++i)
+            {
+                outputs[t][i] = noise.Tick();
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (size_t t = 0; t < kThreadCount; ++t)
+    {
+        sfdsp::NoiseGenerator noise(static_cast<uint32_t>(t));
+        std::vector<float> expected(kSize);
+        noise.Fill(expected.data(), kSize);
+        EXPECT_EQ(outputs[t], expected) << t;
+    }
+}
+
+TEST(NoiseGeneratorTest, PinkSpectrum)
+{
+    constexpr size_t kFftSize = 4096;
+    constexpr size_t kBlockCount = 64;
+    constexpr float kSamplerate = 48000.f;
+
+    sfdsp::PinkNoise pink(1);
+    sfdsp::FFT fft(kFftSize);
+    std::vector<float> block(kFftSize);
+    std::vector<std::complex<float>> spectrum(kFftSize / 2 + 1);
+    std::vector<double> power(kFftSize / 2 + 1, 0.0);
+    for (size_t b = 0; b < kBlockCount; ++b)
+    {
+        pink.Fill(block.data(), kFftSize);
+        for (float v : block)
+        {
+            ASSERT_LT(std::abs(v), 1.5f);
+        }
+        fft.Forward(block.data(), spectrum.data());
+        for (size_t k = 0; k < spectrum.size(); ++k)
+        {
+            power[k] += std::norm(spectrum[k]);
+        }
+    }
+
+    // -3 dB per octave: every octave band holds the same power.
+    auto band_power_db = [&](float low) {
+        const size_t first = static_cast<size_t>(low / kSamplerate * kFftSize);
+        double sum = 0.0;
+        for (size_t k = first; k < 2 * first; ++k)
+        {
+            sum += power[k];
+        }
+        return 10.0 * std::log10(sum);
+    };
+    const double reference = band_power_db(100.f);
+    for (float low : {200.f, 400.f, 800.f, 1600.f, 3200.f, 6400.f})
+    {
+        EXPECT_NEAR(band_power_db(low), reference, 1.0) << low;
+    }
+}
+
+TEST(NoiseGeneratorTest, FilteredNoise)
+{
+    constexpr size_t kSize = 1000;
+    sfdsp::FilteredNoise<sfdsp::StaticOnePoleFilter> a(3);
+    sfdsp::FilteredNoise<sfdsp::StaticOnePoleFilter> b(3);
+    a.GetFilter().SetPole(0.8f);
+    b.GetFilter().SetPole(0.8f);
+
+    std::vector<float> out(kSize);
+    a.Fill(out.data(), kSize);
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        ASSERT_FLOAT_EQ(out[i], b.Tick()) << i;
+    }
+
+    // A one pole lowpass correlates consecutive samples.
+    EXPECT_GT(Autocorrelation(out, 1), 0.5);
+}
@@ -0,0 +1,179 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "oscillator_bank.h"
+
+namespace
+{
+constexpr float kSamplerate = 48000.f;
+
+struct Partial
+{
+    float frequency;
+    float amplitude;
+    float phase;
+};
+
+std::vector<Partial> MakePartials(size_t count)
+{
+    std::vector<Partial> partials(count);
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<float> freq(20.f, 20000.f);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    for (auto& p : partials)
+    {
+        p = {freq(gen), unit(gen) / static_cast<float>(count), unit(gen)};
+    }
+    return partials;
+}
+
+std::vector<float> RenderReference(const std::vector<Partial>& partials, size_t size)
+{
+    std::vector<float> out(size, 0.f);
+    for (const auto& p : partials)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            const double phase = static_cast<double>(p.phase) + static_cast<double>(i) * p.frequency / kSamplerate;
+            out[i] += static_cast<float>(p.amplitude * std::sin(2.0 * std::numbers::pi * phase));
+        }
+    }
+    return out;
+}
+
+std::vector<float> Render(sfdsp::OscillatorBank& bank, size_t size, size_t block_size)
+{
+    std::vector<float> out(size);
+    for (size_t i = 0; i < size; i += block_size)
+    {
+        bank.ProcessBlock(out.data() + i, std::min(block_size, size - i));
+    }
+    return out;
+}
+
+const sfdsp::OscillatorBank::Mode kModes[] = {sfdsp::OscillatorBank::Mode::Polynomial,
+                                              sfdsp::OscillatorBank::Mode::Rotator};
+} // namespace
+
+TEST(OscillatorBankTest, Partials)
+{
+    // Not a multiple of the vector width, to exercise the padding.
+    constexpr size_t kPartialCount = 37;
+    constexpr size_t kSize = 4800;
+    const auto partials = MakePartials(kPartialCount);
+    const auto expected = RenderReference(partials, kSize);
+
+    for (auto mode : kModes)
+    {
+        sfdsp::OscillatorBank bank;
+        bank.Init(kSamplerate, kPartialCount, mode, sfdsp::SineAccuracy::High);
+        ASSERT_EQ(bank.GetPartialCount(), kPartialCount);
+        for (size_t i = 0; i < kPartialCount; ++i)
+        {
+            bank.SetPartial(i, partials[i].frequency, partials[i].amplitude);
+            bank.SetPhase(i, partials[i].phase);
+        }
+
+        // Blocks that are not a multiple of the chunk size.
+        const auto out = Render(bank, kSize, 100);
+        for (size_t i = 0; i < kSize; ++i)
+        {
+            ASSERT_NEAR(out[i], expected[i], 1e-4f) << static_cast<int>(mode) << ", " << i;
+        }
+    }
+}
+
+TEST(OscillatorBankTest, AmplitudeRamp)
+{
+    constexpr size_t kBlockSize = 256;
+    constexpr float kFreq = 1000.f;
+
+    for (auto mode : kModes)
+    {
+        sfdsp::OscillatorBank bank;
+        bank.Init(kSamplerate, 1, mode, sfdsp::SineAccuracy::High);
+        bank.SetPartial(0, kFreq, 0.f);
+        bank.SetAmplitude(0, 1.f);
+
+        const auto out = Render(bank, 2 * kBlockSize, kBlockSize);
+        for (size_t i = 0; i < out.size(); ++i)
+        {
+            // The amplitude reaches the target on the last sample of the first block.
+            const float envelope = std::min(1.f, static_cast<float>(i + 1) / kBlockSize);
+            const float expected = envelope * std::sin(2.f * std::numbers::pi_v<float> * kFreq * i / kSamplerate);
+            ASSERT_NEAR(out[i], expected, 1e-4f) << static_cast<int>(mode) << ", " << i;
+        }
+    }
+}
+
+TEST(OscillatorBankTest, FrequencyRamp)
+{
+    constexpr size_t kBlockSize = 256;
+    constexpr float kStartFreq = 440.f;
+    constexpr float kEndFreq = 660.f;
+
+    for (auto mode : kModes)
+    {
+        sfdsp::OscillatorBank bank;
+        bank.Init(kSamplerate, 1, mode, sfdsp::SineAccuracy::High);
+        bank.SetPartial(0, kStartFreq, 1.f);
+        bank.SetFrequency(0, kEndFreq);
+
+        const auto out = Render(bank, 2 * kBlockSize, kBlockSize);
+
+        // Linear ramp of the phase increment over the first block.
+        double phase = 0.0;
+        double increment = kStartFreq / kSamplerate;
+        const double step = (kEndFreq - kStartFreq) / kSamplerate / kBlockSize;
+        for (size_t i = 0; i < out.size(); ++i)
+        {
+            if (i < kBlockSize)
+            {
+                increment += step;
+            }
+            const double expected = std::sin(2.0 * std::numbers::pi * phase);
+            ASSERT_NEAR(out[i], expected, 1e-3) << static_cast<int>(mode) << ", " << i;
+            phase += increment;
+        }
+    }
+}
+
+TEST(OscillatorBankTest, Nyquist)
+{
+    for (auto mode : kModes)
+    {
+        sfdsp::OscillatorBank bank;
+        bank.Init(kSamplerate, 2, mode);
+        bank.SetPartial(0, 30000.f, 1.f);
+        bank.SetPartial(1, 1000.f, 1.f);
+        bank.SetFrequency(1, 25000.f);
+
+        // The second partial fades out over the first block, then both are silent.
+        const auto out = Render(bank, 512, 256);
+        for (size_t i = 256; i < out.size(); ++i)
+        {
+            ASSERT_NEAR(out[i], 0.f, 1e-6f) << static_cast<int>(mode) << ", " << i;
+        }
+    }
+}
+
+TEST(OscillatorBankTest, RotatorStability)
+{
+    constexpr size_t kSize = static_cast<size_t>(kSamplerate) * 10;
+
+    sfdsp::OscillatorBank bank;
+    bank.Init(kSamplerate, 1, sfdsp::OscillatorBank::Mode::Rotator);
+    bank.SetPartial(0, 1000.3f, 1.f);
+
+    // The magnitude of the rotator must not drift over a long run.
+    const auto out = Render(bank, kSize, 512);
+    const float peak = std::abs(*std::max_element(out.end() - 1000, out.end(), [](float a, float b) {
+        return std::abs(a) < std::abs(b);
+    }));
+    EXPECT_NEAR(peak, 1.f, 1e-3f);
+}
@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+#include "oversampler.h"
+#include "test_utils.h"
+
+namespace
+{
+constexpr size_t kSamplerate = 48000;
+
+template <size_t Factor>
+void CheckPassthrough()
+{
+    sfdsp::Oversampler<Factor> oversampler;
+    const auto input = MakeSine(1000.0 / kSamplerate, kSamplerate / 4);
+    std::vector<float> output(input.size());
+    oversampler.Process(input.data(), output.data(), input.size(), [](float*, size_t) {});
+
+    const float latency = oversampler.GetLatency();
+    EXPECT_GT(latency, 0.f);
+
+    // A 1 kHz sine goes through untouched, delayed by the filters latency.
+    const float phase_shift = static_cast<float>(2.0 * std::numbers::pi * 1000.0 * latency / kSamplerate);
+    const size_t start = input.size() / 2;
+    for (size_t i = start; i < input.size(); ++i)
+    {
+        const float expected = std::sin(static_cast<float>(2.0 * std::numbers::pi * 1000.0 * i / kSamplerate) -
+                                        phase_shift);
+        ASSERT_NEAR(output[i], expected, 2e-3f) << "Factor " << Factor << " at " << i;
+    }
+}
+} // namespace
+
+TEST(OversamplerTest, Passthrough)
+{
+    CheckPassthrough<2>();
+    CheckPassthrough<4>();
+    CheckPassthrough<8>();
+}
+
+TEST(OversamplerTest, UpsampleDownsample)
+{
+    sfdsp::Oversampler<4> oversampler;
+    const auto input = MakeSine(440.0 / kSamplerate, sfdsp::Oversampler<4>::kMaxBlockSize);
+
+    std::vector<float> upsampled(input.size() * 4);
+    std::vector<float> output(input.size());
+    oversampler.Upsample(input.data(), upsampled.data(), input.size());
+    oversampler.Downsample(upsampled.data(), output.data(), input.size());
+
+    // Same result as the Process() helper with an empty processing function.
+    sfdsp::Oversampler<4> reference;
+    std::vector<float> expected(input.size());
+    reference.Process(input.data(), expected.data(), input.size(), [](float*, size_t) {});
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        ASSERT_FLOAT_EQ(output[i], expected[i]);
+    }
+}
+
+TEST(OversamplerTest, ReducesAliasing)
+{
+    // Hard clipping a 5 kHz sine produces odd harmonics. At 48 kHz, 35 kHz and 45 kHz alias back to 13 kHz and
+    // 3 kHz, where there is no harmonic.
+    const auto input = MakeSine(5000.0 / kSamplerate, kSamplerate, 4.f);
+    auto clip = [](float* buffer, size_t size) {
+        for (size_t i = 0; i < size; ++i)
+        {
+            buffer[i] = std::clamp(buffer[i], -1.f, 1.f);
+        }
+    };
+
+    std::vector<float> direct = input;
+    clip(direct.data(), direct.size());
+
+    sfdsp::Oversampler<4> oversampler;
+    std::vector<float> oversampled(input.size());
+    oversampler.Process(input.data(), oversampled.data(), input.size(), clip);
+
+    const float fundamental = Amplitude(oversampled, 5000.0 / kSamplerate);
+    EXPECT_NEAR(fundamental, Amplitude(direct, 5000.0 / kSamplerate), 0.01f);
+
+    for (float alias : {3000.f, 13000.f})
+    {
+        const float direct_alias = Amplitude(direct, alias / kSamplerate);
+        const float oversampled_alias = Amplitude(oversampled, alias / kSamplerate);
+        EXPECT_GT(direct_alias / fundamental, 1e-3f);
+        EXPECT_LT(oversampled_alias, direct_alias * 0.1f) << alias << " Hz";
+    }
+}
@@ -1,9 +1,13 @@
 #include "doctest.h"
 #include "nanobench.h"
 #include <chrono>
+#include <cmath>
 #include <memory>
+#include <utility>
 
 #include "basic_oscillators.h"
+#include "dsp_utils.h"
+#include "noise.h"
 
 using namespace ankerl;
 using namespace std::chrono_literals;
@@ -25,6 +29,12 @@ constexpr const char* OscillatorTypeToString(sfdsp::OscillatorType type)
         return "Saw";
     case sfdsp::OscillatorType::Square:
         return "Square";
+    case sfdsp::OscillatorType::PolyBlepSaw:
+        return "PolyBLEP Saw";
+    case sfdsp::OscillatorType::PolyBlepSquare:
+        return "PolyBLEP Square";
+    case sfdsp::OscillatorType::PolyBlampTri:
+        return "PolyBLAMP Triangle";
     default:
         return "Unknown";
     }
@@ -84,9 +94,99 @@ TEST_CASE("BasicOscillator")
     RenderBlock(sfdsp::OscillatorType::Tri, bench);
     RenderBlock(sfdsp::OscillatorType::Saw, bench);
     RenderBlock(sfdsp::OscillatorType::Square, bench);
+    RenderBlock(sfdsp::OscillatorType::PolyBlampTri, bench);
+    RenderBlock(sfdsp::OscillatorType::PolyBlepSaw, bench);
+    RenderBlock(sfdsp::OscillatorType::PolyBlepSquare, bench);
 
     RenderTick(sfdsp::OscillatorType::Sine, bench);
     RenderTick(sfdsp::OscillatorType::Tri, bench);
     RenderTick(sfdsp::OscillatorType::Saw, bench);
     RenderTick(sfdsp::OscillatorType::Square, bench);
+    RenderTick(sfdsp::OscillatorType::PolyBlampTri, bench);
+    RenderTick(sfdsp::OscillatorType::PolyBlepSaw, bench);
+    RenderTick(sfdsp::OscillatorType::PolyBlepSquare, bench);
+}
+
+TEST_CASE("Sine kernels")
+{
+    nanobench::Bench bench;
+    bench.title("Sine of 48000 phases");
+    bench.relative(true);
+    bench.minEpochIterations(20);
+    bench.unit("sample");
+    bench.batch(kSamplerate);
+
+    auto phases = std::make_unique<float[]>(kSamplerate);
+    auto out = std::make_unique<float[]>(kSamplerate);
+    for (size_t i = 0; i < kSamplerate; ++i)
+    {
+        phases[i] = static_cast<float>(i) * kFreq / kSamplerate;
+    }
+
+    bench.run("std::sin", [&]() {
+        for (size_t i = 0; i < kSamplerate; ++i)
+        {
+            out[i] = std::sin(TWO_PI * phases[i]);
+        }
+        nanobench::doNotOptimizeAway(out[0]);
+    });
+
+    bench.run("sfdsp::Sine (scalar)", [&]() {
+        for (size_t i = 0; i < kSamplerate; ++i)
+        {
+            out[i] = sfdsp::Sine(phases[i]);
+        }
+        nanobench::doNotOptimizeAway(out[0]);
+    });
+
+    const std::pair<sfdsp::SineAccuracy, const char*> tiers[] = {{sfdsp::SineAccuracy::Low, "sfdsp::Sine (Low)"},
+                                                                 {sfdsp::SineAccuracy::Medium, "sfdsp::Sine (Medium)"},
+                                                                 {sfdsp::SineAccuracy::High, "sfdsp::Sine (High)"}};
+    for (const auto& [accuracy, name] : tiers)
+    {
+        bench.run(name, [&]() {
+            sfdsp::Sine(phases.get(), out.get(), kSamplerate, accuracy);
+            nanobench::doNotOptimizeAway(out[0]);
+        });
+    }
+}
+
+TEST_CASE("Noise")
+{
+    nanobench::Bench bench;
+    bench.title("Noise, 48000 samples");
+    bench.relative(true);
+    bench.minEpochIterations(20);
+    bench.unit("sample");
+    bench.batch(kSamplerate);
+
+    auto out = std::make_unique<float[]>(kSamplerate);
+
+    bench.run("sfdsp::Noise", [&]() {
+        for (size_t i = 0; i < kSamplerate; ++i)
+        {
+            out[i] = sfdsp::Noise();
+        }
+        nanobench::doNotOptimizeAway(out[0]);
+    });
+
+    sfdsp::NoiseGenerator noise;
+    bench.run("NoiseGenerator::Tick", [&]() {
+        for (size_t i = 0; i < kSamplerate; ++i)
+        {
+            out[i] = noise.Tick();
+        }
+        nanobench::doNotOptimizeAway(out[0]);
+    });
+
+    bench.run("NoiseGenerator::Fill", [&]() {
+        noise.Fill(out.get(), kSamplerate);
+        nanobench::doNotOptimizeAway(out[0]);
+    });
+
+    sfdsp::PinkNoise pink;
+    bench.run("PinkNoise::Fill", [&]() {
+        pink.Fill(out.get(), kSamplerate);
+        nanobench::doNotOptimizeAway(out[0]);
+    });
 }
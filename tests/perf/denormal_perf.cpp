@@ -0,0 +1,112 @@
+#include "doctest.h"
+#include "nanobench.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+#include "bowed_string.h"
+#include "denormal.h"
+#include "filter.h"
+#include "string_ensemble.h"
+
+using namespace ankerl;
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr size_t kSamplerate = 48000;
+constexpr size_t kBlockSize = 128;
+} // namespace
+
+TEST_CASE("Denormals - filter tail")
+{
+    nanobench::Bench bench;
+    bench.title("Resonant biquad tail, 1 s after the input stops");
+    bench.relative(true);
+    bench.minEpochIterations(10);
+    bench.timeUnit(1ms, "ms");
+
+    auto buffer = std::make_unique<float[]>(kSamplerate);
+
+    // Let an impulse ring out until the biquad state is in the denormal range, then time one more second of
+    // silence.
+    auto ring_out = [&](sfdsp::StaticBiquad& filter) {
+        filter.Reset();
+        filter.Tick(1.f);
+        for (size_t i = 0; i < kSamplerate * 2; ++i)
+        {
+            filter.Tick(0.f);
+        }
+    };
+
+    sfdsp::StaticBiquad filter;
+    filter.SetCoefficients(sfdsp::DesignBiquad(sfdsp::BiquadType::Lowpass, 0.01f, 10.f));
+
+    bench.run("No guard", [&]() {
+        std::fill(buffer.get(), buffer.get() + kSamplerate, 0.f);
+        filter.ProcessBlock(buffer.get(), buffer.get(), kSamplerate);
+    });
+    ring_out(filter);
+    bench.run("No guard, denormal state", [&]() {
+        std::fill(buffer.get(), buffer.get() + kSamplerate, 0.f);
+        filter.ProcessBlock(buffer.get(), buffer.get(), kSamplerate);
+    });
+
+    {
+        sfdsp::ScopedFlushDenormals flush_denormals;
+        ring_out(filter);
+        bench.run("ScopedFlushDenormals", [&]() {
+            std::fill(buffer.get(), buffer.get() + kSamplerate, 0.f);
+            filter.ProcessBlock(buffer.get(), buffer.get(), kSamplerate);
+        });
+    }
+}
+
+TEST_CASE("Denormals - string note-off")
+{
+    nanobench::Bench bench;
+    bench.title("StringEnsemble, 4 s after note-off");
+    bench.relative(true);
+    bench.minEpochIterations(3);
+    bench.timeUnit(1ms, "ms");
+
+    constexpr size_t kTailSize = kSamplerate * 4;
+    auto buffer = std::make_unique<float[]>(kTailSize);
+
+    sfdsp::StringEnsemble ensemble;
+    auto note_off_tail = [&]() {
+        ensemble.Init(static_cast<float>(kSamplerate));
+        for (size_t s = 0; s < sfdsp::kStringCount; ++s)
+        {
+            ensemble[s].SetParameter(sfdsp::BowedString::ParamId::Velocity, 0.5f);
+            ensemble[s].SetParameter(sfdsp::BowedString::ParamId::Force, 0.5f);
+        }
+        std::fill(buffer.get(), buffer.get() + kSamplerate, 0.f);
+        ensemble.ProcessBlock(buffer.get(), kSamplerate / 4);
+
+        for (size_t s = 0; s < sfdsp::kStringCount; ++s)
+        {
+            ensemble[s].SetParameter(sfdsp::BowedString::ParamId::Force, 0.f);
+        }
+        std::fill(buffer.get(), buffer.get() + kTailSize, 0.f);
+        for (size_t i = 0; i < kTailSize; i += kBlockSize)
+        {
+            ensemble.ProcessBlock(buffer.get() + i, kBlockSize);
+        }
+    };
+
+    bench.run("No guard", [&]() { note_off_tail(); });
+    bench.run("ScopedFlushDenormals", [&]() {
+        sfdsp::ScopedFlushDenormals flush_denormals;
+        note_off_tail();
+    });
+
+    // Cost of an ensemble that already went silent.
+    note_off_tail();
+    bench.run("Silent ensemble", [&]() {
+        for (size_t i = 0; i < kTailSize; i += kBlockSize)
+        {
+            ensemble.ProcessBlock(buffer.get() + i, kBlockSize);
+        }
+    });
+}
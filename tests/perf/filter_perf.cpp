@@ -0,0 +1,305 @@
+#include "doctest.h"
+#include "nanobench.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "biquad_bank.h"
+#include "dsp_utils.h"
+#include "filter.h"
+#include "fir_filter.h"
+#include "parallel_filter.h"
+#include "state_variable_filter.h"
+
+using namespace ankerl;
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr size_t kSamplerate = 48000;
+constexpr size_t kBlockSize = 128;
+constexpr size_t kChannelCount = 256;
+} // namespace
+
+TEST_CASE("BiquadBank")
+{
+    nanobench::Bench bench;
+    bench.title("BiquadBank - 256 channels");
+    bench.relative(true);
+    bench.minEpochIterations(10);
+    bench.timeUnit(1ms, "ms");
+
+    // Planar buffers for the individual filters, interleaved for the bank.
+    auto planar = std::make_unique<float[]>(kChannelCount * kBlockSize);
+    auto interleaved = std::make_unique<float[]>(kChannelCount * kBlockSize);
+    for (size_t i = 0; i < kChannelCount * kBlockSize; ++i)
+    {
+        planar[i] = (i % 64 == 0) ? 1.f : 0.f;
+        interleaved[i] = planar[i];
+    }
+
+    auto filters = std::make_unique<std::array<sfdsp::Biquad, kChannelCount>>();
+    sfdsp::BiquadBank<kChannelCount> bank;
+    for (size_t c = 0; c < kChannelCount; ++c)
+    {
+        (*filters)[c].SetCoefficients(0.2f, 0.4f, 0.2f, -0.8f, 0.3f);
+        bank.SetCoefficients(c, 0.2f, 0.4f, 0.2f, -0.8f, 0.3f);
+    }
+
+    constexpr size_t kBlockCount = kSamplerate / kBlockSize;
+
+    bench.run("Biquad::ProcessBlock", [&]() {
+        for (size_t b = 0; b < kBlockCount; ++b)
+        {
+            for (size_t c = 0; c < kChannelCount; ++c)
+            {
+                float* channel = planar.get() + c * kBlockSize;
+                (*filters)[c].ProcessBlock(channel, channel, kBlockSize);
+            }
+        }
+    });
+
+    bench.run("BiquadBank::ProcessBlock", [&]() {
+        for (size_t b = 0; b < kBlockCount; ++b)
+        {
+            bank.ProcessBlock(interleaved.get(), interleaved.get(), kBlockSize);
+        }
+    });
+}
+
+TEST_CASE("StaticFilter")
+{
+    nanobench::Bench bench;
+    bench.title("Virtual vs static filters");
+    bench.relative(true);
+    bench.minEpochIterations(10);
+    bench.timeUnit(1ms, "ms");
+
+    constexpr size_t kSize = kSamplerate * 10;
+    auto buffer = std::make_unique<float[]>(kSize);
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        buffer[i] = (i % 64 == 0) ? 1.f : 0.f;
+    }
+
+    sfdsp::Biquad biquad;
+    biquad.SetCoefficients(0.2f, 0.4f, 0.2f, -0.8f, 0.3f);
+    sfdsp::StaticBiquad static_biquad;
+    static_biquad.SetCoefficients(0.2f, 0.4f, 0.2f, -0.8f, 0.3f);
+
+    bench.run("Biquad::ProcessBlock", [&]() { biquad.ProcessBlock(buffer.get(), buffer.get(), kSize); });
+    bench.run("StaticBiquad::ProcessBlock", [&]() { static_biquad.ProcessBlock(buffer.get(), buffer.get(), kSize); });
+
+    sfdsp::OnePoleFilter one_pole;
+    one_pole.SetPole(0.5f);
+    sfdsp::StaticOnePoleFilter static_one_pole;
+    static_one_pole.SetPole(0.5f);
+
+    bench.run("OnePoleFilter::Tick", [&]() {
+        for (size_t i = 0; i < kSize; ++i)
+        {
+            buffer[i] = one_pole.Tick(buffer[i]);
+        }
+    });
+    bench.run("StaticOnePoleFilter::Tick", [&]() {
+        for (size_t i = 0; i < kSize; ++i)
+        {
+            buffer[i] = static_one_pole.Tick(buffer[i]);
+        }
+    });
+}
+
+TEST_CASE("BiquadModulation")
+{
+    nanobench::Bench bench;
+    bench.title("Biquad cutoff sweep - coefficient update rate");
+    bench.relative(true);
+    bench.minEpochIterations(10);
+    bench.timeUnit(1ms, "ms");
+
+    constexpr size_t kSize = kSamplerate;
+    constexpr size_t kUpdateBlockSize = 32;
+    auto buffer = std::make_unique<float[]>(kSize);
+    auto cutoff = std::make_unique<float[]>(kSize);
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        buffer[i] = (i % 64 == 0) ? 1.f : 0.f;
+        // 5 Hz sweep between 100 Hz and 5 kHz
+        const float lfo = 0.5f + 0.5f * std::sin(TWO_PI * 5.f * static_cast<float>(i) / kSamplerate);
+        cutoff[i] = (100.f + 4900.f * lfo) / kSamplerate;
+    }
+
+    sfdsp::StaticBiquad biquad;
+    bench.run("Per-sample DesignBiquad", [&]() {
+        for (size_t i = 0; i < kSize; ++i)
+        {
+            biquad.SetCoefficients(sfdsp::DesignBiquad(sfdsp::BiquadType::Lowpass, cutoff[i], 2.f));
+            buffer[i] = biquad.Tick(buffer[i]);
+        }
+    });
+
+    sfdsp::InterpolatedBiquad interpolated;
+    bench.run("Per-block DesignBiquad + interpolation", [&]() {
+        for (size_t i = 0; i < kSize; i += kUpdateBlockSize)
+        {
+            interpolated.SetTarget(sfdsp::DesignBiquad(sfdsp::BiquadType::Lowpass, cutoff[i], 2.f));
+            interpolated.ProcessBlock(buffer.get() + i, buffer.get() + i, kUpdateBlockSize);
+        }
+    });
+
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        cutoff[i] *= kSamplerate;
+    }
+
+    sfdsp::StateVariableFilter svf;
+    svf.Init(kSamplerate);
+    svf.SetQ(2.f);
+    bench.run("StateVariableFilter per-sample cutoff", [&]() {
+        svf.ProcessBlock(buffer.get(), cutoff.get(), buffer.get(), nullptr, nullptr, kSize);
+    });
+}
+
+TEST_CASE("ParallelFilter")
+{
+    nanobench::Bench bench;
+    bench.title("String body filter - serial vs parallel");
+    bench.relative(true);
+    bench.minEpochIterations(10);
+    bench.timeUnit(1ms, "ms");
+
+    const std::array<sfdsp::BiquadCoefficients, 6> cascade = {{
+        {1.0f, 1.5667f, 0.3133f, -0.5509f, -0.3925f},
+        {1.0f, -1.9537f, 0.9542f, -1.6357f, 0.8697f},
+        {1.0f, -1.6683f, 0.8852f, -1.7674f, 0.8735f},
+        {1.0f, -1.8585f, 0.9653f, -1.8498f, 0.9516f},
+        {1.0f, -1.9299f, 0.9621f, -1.9354f, 0.9590f},
+        {1.0f, -1.9800f, 0.9888f, -1.9867f, 0.9923f},
+    }};
+    constexpr float kGain = 0.1248f;
+
+    constexpr size_t kSize = kSamplerate * 10;
+    auto buffer = std::make_unique<float[]>(kSize);
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        buffer[i] = (i % 512 == 0) ? 1.f : 0.f;
+    }
+
+    std::array<sfdsp::StaticBiquad, 6> serial;
+    for (size_t i = 0; i < serial.size(); ++i)
+    {
+        serial[i].SetCoefficients(cascade[i]);
+    }
+    serial[5].SetGain(kGain);
+
+    bench.run("Serial cascade, per sample", [&]() {
+        for (size_t i = 0; i < kSize; ++i)
+        {
+            float s = buffer[i];
+            for (auto& f : serial)
+            {
+                s = f.Tick(s);
+            }
+            buffer[i] = s;
+        }
+    });
+
+    bench.run("Serial cascade, per block", [&]() {
+        for (size_t i = 0; i < kSize; i += kBlockSize)
+        {
+            for (auto& f : serial)
+            {
+                f.ProcessBlock(buffer.get() + i, buffer.get() + i, kBlockSize);
+            }
+        }
+    });
+
+    sfdsp::ParallelFilter<6> parallel;
+    parallel.SetCascade(cascade, kGain);
+    bench.run("ParallelFilter", [&]() { parallel.ProcessBlock(buffer.get(), buffer.get(), kSize); });
+}
+
+TEST_CASE("FirFilter")
+{
+    nanobench::Bench bench;
+    bench.title("FirFilter - direct form vs block convolution");
+    bench.relative(true);
+    bench.minEpochIterations(10);
+    bench.timeUnit(1ms, "ms");
+
+    constexpr size_t kSize = kSamplerate;
+    auto buffer = std::make_unique<float[]>(kSize);
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        buffer[i] = std::sin(TWO_PI * 440.f * static_cast<float>(i) / kSamplerate);
+    }
+
+    // A FirDecimator with a factor of 1 is a plain direct form FIR, the reference for the FFT block convolution.
+    auto decimated = std::make_unique<float[]>(kSize + 1);
+    for (size_t tap_count : {32, 128, 512, 2048})
+    {
+        std::vector<float> taps(tap_count);
+        sfdsp::DesignLowpassFir(taps.data(), taps.size(), 0.1f);
+
+        sfdsp::FirFilter filter;
+        filter.SetTaps(taps.data(), taps.size());
+        sfdsp::FirDecimator direct;
+        direct.Init(1, taps.data(), taps.size());
+
+        const std::string name = std::to_string(tap_count) + " taps";
+        const std::string path = filter.UsesFft() ? ", FFT" : ", direct form";
+        bench.run(name + ", Tick" + path, [&]() {
+            for (size_t i = 0; i < kSize; ++i)
+            {
+                buffer[i] = filter.Tick(buffer[i]);
+            }
+        });
+
+        for (size_t block_size : {size_t{64}, kBlockSize})
+        {
+            const std::string blocks = ", " + std::to_string(block_size) + " sample blocks";
+            bench.run(name + blocks + path, [&]() {
+                for (size_t i = 0; i < kSize; i += block_size)
+                {
+                    filter.ProcessBlock(buffer.get() + i, buffer.get() + i, std::min(block_size, kSize - i));
+                }
+            });
+
+            if (filter.UsesFft())
+            {
+                bench.run(name + blocks + ", direct form", [&]() {
+                    for (size_t i = 0; i < kSize; i += block_size)
+                    {
+                        direct.ProcessBlock(buffer.get() + i, decimated.get() + i, std::min(block_size, kSize - i));
+                    }
+                });
+            }
+        }
+    }
+
+    std::vector<float> taps(64);
+    sfdsp::DesignLowpassFir(taps.data(), taps.size(), 0.25f, sfdsp::WindowType::Kaiser, 2.f);
+
+    auto upsampled = std::make_unique<float[]>(kSize * 2);
+    sfdsp::FirInterpolator interpolator;
+    interpolator.Init(2, taps.data(), taps.size());
+    bench.run("2x polyphase interpolator, 64 taps", [&]() {
+        for (size_t i = 0; i < kSize; i += kBlockSize)
+        {
+            interpolator.ProcessBlock(buffer.get() + i, upsampled.get() + 2 * i, kBlockSize);
+        }
+    });
+
+    sfdsp::FirDecimator decimator;
+    decimator.Init(2, taps.data(), taps.size());
+    bench.run("2x decimator, 64 taps", [&]() {
+        for (size_t i = 0; i < 2 * kSize; i += kBlockSize)
+        {
+            decimator.ProcessBlock(upsampled.get() + i, buffer.get() + i / 2, kBlockSize);
+        }
+    });
+}
@@ -0,0 +1,124 @@
+#include "doctest.h"
+#include "nanobench.h"
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "fir_filter.h"
+#include "halfband.h"
+#include "sinc_resampler.h"
+
+using namespace ankerl;
+
+namespace
+{
+constexpr size_t kSamplerate = 48000;
+constexpr size_t kBlockSize = 128;
+constexpr size_t kTapCount = 47;
+
+std::unique_ptr<float[]> MakeNoise(size_t size)
+{
+    auto noise = std::make_unique<float[]>(size);
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    for (size_t i = 0; i < size; ++i)
+    {
+        noise[i] = dist(gen);
+    }
+    return noise;
+}
+} // namespace
+
+TEST_CASE("Halfband - decimation")
+{
+    nanobench::Bench bench;
+    bench.title("2:1 decimation of 1 s at 96 kHz");
+    bench.relative(true);
+    bench.minEpochIterations(10);
+    bench.unit("sample");
+    bench.batch(2 * kSamplerate);
+
+    auto input = MakeNoise(2 * kSamplerate);
+    auto output = std::make_unique<float[]>(2 * kSamplerate);
+
+    std::vector<float> taps(kTapCount);
+    sfdsp::DesignLowpassFir(taps.data(), taps.size(), 0.25f, sfdsp::WindowType::Kaiser);
+    sfdsp::FirDecimator fir_decimator;
+    fir_decimator.Init(2, taps.data(), taps.size());
+    bench.run("FirDecimator, 47 taps", [&]() {
+        for (size_t i = 0; i < 2 * kSamplerate; i += 2 * kBlockSize)
+        {
+            fir_decimator.ProcessBlock(input.get() + i, output.get() + i / 2, 2 * kBlockSize);
+        }
+    });
+
+    sfdsp::HalfbandFirDecimator halfband_fir;
+    halfband_fir.Init(kTapCount);
+    bench.run("HalfbandFirDecimator, 47 taps", [&]() {
+        for (size_t i = 0; i < 2 * kSamplerate; i += 2 * kBlockSize)
+        {
+            halfband_fir.ProcessBlock(input.get() + i, output.get() + i / 2, kBlockSize);
+        }
+    });
+
+    sfdsp::HalfbandIirDecimator halfband_iir;
+    halfband_iir.Init();
+    bench.run("HalfbandIirDecimator, 96 dB", [&]() {
+        for (size_t i = 0; i < 2 * kSamplerate; i += 2 * kBlockSize)
+        {
+            halfband_iir.ProcessBlock(input.get() + i, output.get() + i / 2, kBlockSize);
+        }
+    });
+
+    bench.run("sinc_resample", [&]() {
+        size_t out_size = kSamplerate;
+        sfdsp::sinc_resample(input.get(), 2 * kSamplerate, 0.5f, output.get(), out_size);
+    });
+}
+
+TEST_CASE("Halfband - interpolation")
+{
+    nanobench::Bench bench;
+    bench.title("1:2 interpolation of 1 s at 48 kHz");
+    bench.relative(true);
+    bench.minEpochIterations(10);
+    bench.unit("sample");
+    bench.batch(kSamplerate);
+
+    auto input = MakeNoise(kSamplerate);
+    auto output = std::make_unique<float[]>(2 * kSamplerate + 16);
+
+    std::vector<float> taps(kTapCount);
+    sfdsp::DesignLowpassFir(taps.data(), taps.size(), 0.25f, sfdsp::WindowType::Kaiser, 2.f);
+    sfdsp::FirInterpolator fir_interpolator;
+    fir_interpolator.Init(2, taps.data(), taps.size());
+    bench.run("FirInterpolator, 47 taps", [&]() {
+        for (size_t i = 0; i < kSamplerate; i += kBlockSize)
+        {
+            fir_interpolator.ProcessBlock(input.get() + i, output.get() + 2 * i, kBlockSize);
+        }
+    });
+
+    sfdsp::HalfbandFirInterpolator halfband_fir;
+    halfband_fir.Init(kTapCount);
+    bench.run("HalfbandFirInterpolator, 47 taps", [&]() {
+        for (size_t i = 0; i < kSamplerate; i += kBlockSize)
+        {
+            halfband_fir.ProcessBlock(input.get() + i, output.get() + 2 * i, kBlockSize);
+        }
+    });
+
+    sfdsp::HalfbandIirInterpolator halfband_iir;
+    halfband_iir.Init();
+    bench.run("HalfbandIirInterpolator, 96 dB", [&]() {
+        for (size_t i = 0; i < kSamplerate; i += kBlockSize)
+        {
+            halfband_iir.ProcessBlock(input.get() + i, output.get() + 2 * i, kBlockSize);
+        }
+    });
+
+    bench.run("sinc_resample", [&]() {
+        size_t out_size = 2 * kSamplerate + 16;
+        sfdsp::sinc_resample(input.get(), kSamplerate, 2.f, output.get(), out_size);
+    });
+}
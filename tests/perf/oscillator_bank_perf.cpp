@@ -0,0 +1,103 @@
+#include "doctest.h"
+#include "nanobench.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "basic_oscillators.h"
+#include "oscillator_bank.h"
+
+using namespace ankerl;
+
+namespace
+{
+constexpr float kSamplerate = 48000.f;
+constexpr size_t kBlockSize = 256;
+constexpr size_t kBlockCount = 48000 / kBlockSize;
+
+std::vector<float> MakeFrequencies(size_t count)
+{
+    std::vector<float> frequencies(count);
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<float> dist(20.f, 20000.f);
+    for (auto& f : frequencies)
+    {
+        f = dist(gen);
+    }
+    return frequencies;
+}
+} // namespace
+
+TEST_CASE("OscillatorBank")
+{
+    for (size_t partial_count : {128, 1024})
+    {
+        nanobench::Bench bench;
+        bench.title("Sum of " + std::to_string(partial_count) + " sine partials");
+        bench.relative(true);
+        bench.minEpochIterations(3);
+        bench.unit("partial sample");
+        bench.batch(partial_count * kBlockSize * kBlockCount);
+
+        const auto frequencies = MakeFrequencies(partial_count);
+        auto out = std::make_unique<float[]>(kBlockSize);
+        auto scratch = std::make_unique<float[]>(kBlockSize);
+
+        std::vector<sfdsp::BasicOscillator> oscillators(partial_count);
+        for (size_t i = 0; i < partial_count; ++i)
+        {
+            oscillators[i].Init(kSamplerate, frequencies[i]);
+        }
+        bench.run("BasicOscillator per partial", [&]() {
+            for (size_t block = 0; block < kBlockCount; ++block)
+            {
+                std::fill(out.get(), out.get() + kBlockSize, 0.f);
+                for (auto& osc : oscillators)
+                {
+                    osc.ProcessBlock(scratch.get(), kBlockSize);
+                    for (size_t i = 0; i < kBlockSize; ++i)
+                    {
+                        out[i] += scratch[i];
+                    }
+                }
+            }
+            nanobench::doNotOptimizeAway(out[0]);
+        });
+
+        const std::pair<sfdsp::OscillatorBank::Mode, std::string> modes[] = {
+            {sfdsp::OscillatorBank::Mode::Polynomial, "OscillatorBank polynomial"},
+            {sfdsp::OscillatorBank::Mode::Rotator, "OscillatorBank rotator"}};
+        for (const auto& [mode, name] : modes)
+        {
+            for (bool ramp : {false, true})
+            {
+                sfdsp::OscillatorBank bank;
+                bank.Init(kSamplerate, partial_count, mode);
+                for (size_t i = 0; i < partial_count; ++i)
+                {
+                    bank.SetPartial(i, frequencies[i], 1.f / partial_count);
+                }
+
+                bench.run(name + (ramp ? ", new targets every block" : ""), [&]() {
+                    for (size_t block = 0; block < kBlockCount; ++block)
+                    {
+                        if (ramp)
+                        {
+                            const float detune = (block % 2 == 0) ? 1.001f : 1.f;
+                            for (size_t i = 0; i < partial_count; ++i)
+                            {
+                                bank.SetFrequency(i, frequencies[i] * detune);
+                                bank.SetAmplitude(i, detune / partial_count);
+                            }
+                        }
+                        bank.ProcessBlock(out.get(), kBlockSize);
+                    }
+                    nanobench::doNotOptimizeAway(out[0]);
+                });
+            }
+        }
+    }
+}
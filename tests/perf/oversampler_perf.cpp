@@ -0,0 +1,99 @@
+#include "doctest.h"
+#include "nanobench.h"
+#include <chrono>
+#include <memory>
+
+#include "bow_table.h"
+#include "bowed_string.h"
+#include "oversampler.h"
+
+using namespace ankerl;
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr size_t kBaseSamplerate = 48000;
+constexpr size_t kBlockSize = 128;
+
+void StartBowing(sfdsp::BowedString& string, float samplerate, size_t max_delay)
+{
+    sfdsp::BowedStringConfig config = sfdsp::kDefaultStringConfig;
+    config.samplerate = samplerate;
+    config.max_delay_size = max_delay;
+    string.Init(config);
+    string.SetParameter(sfdsp::BowedString::ParamId::Velocity, 0.5f);
+    string.SetParameter(sfdsp::BowedString::ParamId::Force, 0.5f);
+}
+} // namespace
+
+TEST_CASE("Oversampler")
+{
+    nanobench::Bench bench;
+    bench.title("1 s of bowed string, whole model at 96 kHz vs 48 kHz with an oversampled nonlinear stage");
+    bench.relative(true);
+    bench.minEpochIterations(10);
+    bench.timeUnit(1ms, "ms");
+
+    auto buffer = std::make_unique<float[]>(kBaseSamplerate * 2);
+
+    sfdsp::BowedString string_96k(2048);
+    StartBowing(string_96k, 2.f * kBaseSamplerate, 2048);
+    bench.run("BowedString at 96 kHz", [&]() {
+        for (size_t i = 0; i < 2 * kBaseSamplerate; ++i)
+        {
+            buffer[i] = string_96k.Tick(0.f);
+        }
+    });
+
+    sfdsp::BowedString string_48k(1024);
+    StartBowing(string_48k, kBaseSamplerate, 1024);
+    bench.run("BowedString at 48 kHz", [&]() {
+        for (size_t i = 0; i < kBaseSamplerate; ++i)
+        {
+            buffer[i] = string_48k.Tick(0.f);
+        }
+    });
+
+    // A feed-forward saturation stage after the string, using the bow table as the nonlinearity.
+    sfdsp::BowTable shaper;
+    shaper.SetForce(0.8f);
+    auto saturate = [&](float* block, size_t size) {
+        for (size_t i = 0; i < size; ++i)
+        {
+            block[i] = block[i] * shaper.Tick(block[i]);
+        }
+    };
+
+    sfdsp::Oversampler<2> oversampler_2x;
+    bench.run("BowedString at 48 kHz + 2x oversampled nonlinear stage", [&]() {
+        for (size_t i = 0; i < kBaseSamplerate; i += kBlockSize)
+        {
+            for (size_t j = 0; j < kBlockSize; ++j)
+            {
+                buffer[i + j] = string_48k.Tick(0.f);
+            }
+            oversampler_2x.Process(buffer.get() + i, buffer.get() + i, kBlockSize, saturate);
+        }
+    });
+
+    sfdsp::Oversampler<4> oversampler_4x;
+    bench.run("BowedString at 48 kHz + 4x oversampled nonlinear stage", [&]() {
+        for (size_t i = 0; i < kBaseSamplerate; i += kBlockSize)
+        {
+            for (size_t j = 0; j < kBlockSize; ++j)
+            {
+                buffer[i + j] = string_48k.Tick(0.f);
+            }
+            oversampler_4x.Process(buffer.get() + i, buffer.get() + i, kBlockSize, saturate);
+        }
+    });
+
+    bench.run("Oversampler<2> alone", [&]() {
+        oversampler_2x.Process(buffer.get(), buffer.get(), kBaseSamplerate, [](float*, size_t) {});
+    });
+
+    sfdsp::Oversampler<8> oversampler_8x;
+    bench.run("Oversampler<8> alone", [&]() {
+        oversampler_8x.Process(buffer.get(), buffer.get(), kBaseSamplerate, [](float*, size_t) {});
+    });
+}
@@ -1,7 +1,10 @@
 #include "doctest.h"
 #include "nanobench.h"
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <memory>
+#include <vector>
 
 #include "phaseshapers.h"
 
@@ -48,15 +51,46 @@ void RenderTick(sfdsp::Phaseshaper::Waveform type, nanobench::Bench& bench)
     });
 }
 
-void RenderBlock(sfdsp::Phaseshaper::Waveform type, nanobench::Bench& bench)
+void RenderBlock(float wave, const char* name, nanobench::Bench& bench, bool wavetable = false)
 {
     sfdsp::Phaseshaper ps;
     ps.Init(kSamplerate);
     ps.SetFreq(kFreq);
-    ps.SetWaveform(type);
+    ps.SetWaveform(wave);
+    ps.SetWavetableMode(wavetable);
     auto out = std::make_unique<float[]>(kOutputSize);
 
-    bench.run("Phaseshaper::ProcessBlock", [&]() { ps.ProcessBlock(out.get(), kOutputSize); });
+    bench.run(name, [&]() {
+        for (size_t i = 0; i < kOutputSize; i += kBlockSize)
+        {
+            ps.ProcessBlock(out.get() + i, std::min(kBlockSize, kOutputSize - i));
+        }
+        nanobench::doNotOptimizeAway(out[0]);
+    });
+}
+
+void RenderModulatedBlock(float wave, nanobench::Bench& bench)
+{
+    sfdsp::Phaseshaper ps;
+    ps.Init(kSamplerate);
+    ps.SetWaveform(wave);
+    auto out = std::make_unique<float[]>(kOutputSize);
+
+    std::vector<float> freq(kBlockSize);
+    std::vector<float> mod(kBlockSize);
+    for (size_t i = 0; i < kBlockSize; ++i)
+    {
+        freq[i] = kFreq * (1.f + 0.01f * std::sin(static_cast<float>(i) * 0.1f));
+        mod[i] = static_cast<float>(i) / kBlockSize;
+    }
+
+    bench.run("Phaseshaper::ProcessBlock, audio rate freq and mod", [&]() {
+        for (size_t i = 0; i < kOutputSize; i += kBlockSize)
+        {
+            ps.ProcessBlock(out.get() + i, std::min(kBlockSize, kOutputSize - i), freq.data(), mod.data());
+        }
+        nanobench::doNotOptimizeAway(out[0]);
+    });
 }
 
 TEST_CASE("Phaseshaper")
@@ -72,8 +106,73 @@ TEST_CASE("Phaseshaper")
         bench.title(buffer);
         bench.relative(true);
         bench.minEpochIterations(10);
-        bench.timeUnit(1ms, "ms");
+        bench.unit("sample");
+        bench.batch(kOutputSize);
         RenderTick(static_cast<sfdsp::Phaseshaper::Waveform>(i), bench);
-        RenderBlock(static_cast<sfdsp::Phaseshaper::Waveform>(i), bench);
+        RenderBlock(static_cast<float>(i), "Phaseshaper::ProcessBlock", bench);
+
+        // Halfway to the next waveform, both kernels run and are crossfaded.
+        RenderBlock(static_cast<float>(i) + 0.5f, "Phaseshaper::ProcessBlock, morphing", bench);
+        RenderModulatedBlock(static_cast<float>(i), bench);
+        RenderBlock(static_cast<float>(i), "Phaseshaper::ProcessBlock, wavetable", bench, true);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("PhaseshaperUnison")
+{
+    constexpr size_t kVoiceCount = sfdsp::PhaseshaperUnison::kMaxVoices;
+    constexpr size_t kBlockCount = kOutputSize / kBlockSize;
+
+    nanobench::Bench bench;
+    bench.title("16 voice unison");
+    bench.relative(true);
+    bench.minEpochIterations(3);
+    bench.unit("voice sample");
+    bench.batch(kVoiceCount * kOutputSize);
+
+    auto left = std::make_unique<float[]>(kBlockSize);
+    auto right = std::make_unique<float[]>(kBlockSize);
+    auto scratch = std::make_unique<float[]>(kBlockSize);
+
+    // One Phaseshaper per voice, panned by hand.
+    std::vector<sfdsp::Phaseshaper> voices(kVoiceCount);
+    std::vector<float> pan(kVoiceCount);
+    for (size_t v = 0; v < kVoiceCount; ++v)
+    {
+        voices[v].Init(kSamplerate);
+        voices[v].SetWaveform(sfdsp::Phaseshaper::Waveform::SUPERSAW);
+        voices[v].SetFreq(kFreq * (1.f + 0.001f * v));
+        pan[v] = static_cast<float>(v) / (kVoiceCount - 1);
+    }
+    bench.run("Phaseshaper per voice", [&]() {
+        for (size_t block = 0; block < kBlockCount; ++block)
+        {
+            std::fill(left.get(), left.get() + kBlockSize, 0.f);
+            std::fill(right.get(), right.get() + kBlockSize, 0.f);
+            for (size_t v = 0; v < kVoiceCount; ++v)
+            {
+                voices[v].ProcessBlock(scratch.get(), kBlockSize);
+                for (size_t i = 0; i < kBlockSize; ++i)
+                {
+                    left[i] += scratch[i] * (1.f - pan[v]);
+                    right[i] += scratch[i] * pan[v];
+                }
+            }
+        }
+        nanobench::doNotOptimizeAway(left[0]);
+    });
+
+    sfdsp::PhaseshaperUnison unison;
+    unison.Init(kSamplerate, kVoiceCount);
+    unison.SetWaveform(sfdsp::Phaseshaper::Waveform::SUPERSAW);
+    unison.SetFreq(kFreq);
+    unison.SetDetune(20.f);
+    unison.SetSpread(1.f);
+    bench.run("PhaseshaperUnison", [&]() {
+        for (size_t block = 0; block < kBlockCount; ++block)
+        {
+            unison.ProcessBlock(left.get(), right.get(), kBlockSize);
+        }
+        nanobench::doNotOptimizeAway(left[0]);
+    });
+}
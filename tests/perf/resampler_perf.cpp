@@ -0,0 +1,174 @@
+#include "doctest.h"
+#include "nanobench.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "sinc_resampler.h"
+
+using namespace ankerl;
+
+namespace
+{
+constexpr size_t kInputSize = 48000;
+constexpr size_t kBlockSize = 512;
+
+std::unique_ptr<float[]> MakeNoise(size_t size)
+{
+    auto noise = std::make_unique<float[]>(size);
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    for (size_t i = 0; i < size; ++i)
+    {
+        noise[i] = dist(gen);
+    }
+    return noise;
+}
+} // namespace
+
+TEST_CASE("SincResampler")
+{
+    nanobench::Bench bench;
+    bench.title("Sinc resampling of 48000 input samples");
+    bench.relative(true);
+    bench.minEpochIterations(5);
+    bench.unit("sample");
+    bench.batch(kInputSize);
+
+    auto input = MakeNoise(kInputSize);
+    auto output = std::make_unique<float[]>(kInputSize * 3);
+
+    for (auto [input_rate, output_rate] : {std::pair{44100, 48000}, std::pair{48000, 44100}})
+    {
+        const std::string name = std::to_string(input_rate) + " -> " + std::to_string(output_rate);
+        const float ratio = static_cast<float>(output_rate) / static_cast<float>(input_rate);
+
+        bench.run("sinc_resample " + name, [&]() {
+            size_t out_size = kInputSize * 3;
+            sfdsp::sinc_resample(input.get(), kInputSize, ratio, output.get(), out_size);
+        });
+
+        sfdsp::SincResampler resampler;
+        resampler.Init(input_rate, output_rate);
+        bench.run("SincResampler " + name, [&]() {
+            size_t written = 0;
+            for (size_t i = 0; i < kInputSize; i += kBlockSize)
+            {
+                const size_t count = std::min(kBlockSize, kInputSize - i);
+                written += resampler.Process(input.get() + i, count, output.get() + written);
+            }
+        });
+    }
+}
+
+TEST_CASE("VarispeedResampler")
+{
+    nanobench::Bench bench;
+    bench.title("Varispeed resampling of 48000 input samples");
+    bench.relative(true);
+    bench.minEpochIterations(5);
+    bench.unit("sample");
+    bench.batch(kInputSize);
+
+    auto input = MakeNoise(kInputSize);
+    auto output = std::make_unique<float[]>(kInputSize * 3);
+
+    sfdsp::SincResampler sinc_resampler;
+    sinc_resampler.Init(44100, 48000);
+    bench.run("SincResampler 44100 -> 48000", [&]() {
+        size_t written = 0;
+        for (size_t i = 0; i < kInputSize; i += kBlockSize)
+        {
+            const size_t count = std::min(kBlockSize, kInputSize - i);
+            written += sinc_resampler.Process(input.get() + i, count, output.get() + written);
+        }
+    });
+
+    auto run = [&](sfdsp::VarispeedResampler& resampler, const float* ratios) {
+        size_t written = 0;
+        size_t offset = 0;
+        while (offset < kInputSize)
+        {
+            size_t used = 0;
+            const size_t count = std::min(kBlockSize, kInputSize - offset);
+            written += ratios ? resampler.Process(input.get() + offset, count, used, output.get() + written,
+                                                  kBlockSize, ratios + written)
+                              : resampler.Process(input.get() + offset, count, used, output.get() + written,
+                                                  kBlockSize);
+            offset += used;
+        }
+    };
+
+    for (float ratio : {48000.f / 44100.f, 0.5f})
+    {
+        sfdsp::VarispeedResampler resampler;
+        resampler.Init(ratio);
+        bench.run("VarispeedResampler constant " + std::to_string(ratio), [&]() { run(resampler, nullptr); });
+    }
+
+    // Sweeps from 0.5 to 1.5 and back, per output sample.
+    std::vector<float> ratios(kInputSize * 3);
+    for (size_t i = 0; i < ratios.size(); ++i)
+    {
+        ratios[i] = 1.f + 0.5f * std::sin(static_cast<float>(i) * 1e-4f);
+    }
+    sfdsp::VarispeedResampler resampler;
+    resampler.Init();
+    bench.run("VarispeedResampler swept", [&]() {
+        resampler.Reset();
+        run(resampler, ratios.data());
+    });
+}
+
+TEST_CASE("Sinc quality tiers")
+{
+    nanobench::Bench bench;
+    bench.title("Sinc table quality tiers, 48000 input samples");
+    bench.relative(true);
+    bench.minEpochIterations(5);
+    bench.unit("sample");
+    bench.batch(kInputSize);
+
+    auto input = MakeNoise(kInputSize);
+    auto output = std::make_unique<float[]>(kInputSize * 3);
+
+    const std::pair<sfdsp::SincQuality, std::string> tiers[] = {{sfdsp::SincQuality::Best, "Best"},
+                                                                {sfdsp::SincQuality::Balanced, "Balanced"},
+                                                                {sfdsp::SincQuality::Fast, "Fast"}};
+    for (const auto& [quality, name] : tiers)
+    {
+        sfdsp::SincResampler resampler;
+        resampler.Init(44100, 48000, 1, quality);
+        bench.run("SincResampler 44100 -> 48000, " + name, [&]() {
+            size_t written = 0;
+            for (size_t i = 0; i < kInputSize; i += kBlockSize)
+            {
+                const size_t count = std::min(kBlockSize, kInputSize - i);
+                written += resampler.Process(input.get() + i, count, output.get() + written);
+            }
+        });
+    }
+
+    for (float ratio : {1.1f, 0.9f})
+    {
+        for (const auto& [quality, name] : tiers)
+        {
+            sfdsp::VarispeedResampler resampler;
+            resampler.Init(ratio, quality);
+            bench.run("VarispeedResampler " + std::to_string(ratio) + ", " + name, [&]() {
+                size_t offset = 0;
+                while (offset < kInputSize)
+                {
+                    size_t used = 0;
+                    const size_t count = std::min(kBlockSize, kInputSize - offset);
+                    resampler.Process(input.get() + offset, count, used, output.get(), kBlockSize);
+                    offset += used;
+                }
+            });
+        }
+    }
+}
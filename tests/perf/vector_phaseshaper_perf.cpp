@@ -0,0 +1,58 @@
+#include "doctest.h"
+#include "nanobench.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "vector_phaseshaper.h"
+
+using namespace ankerl;
+
+namespace
+{
+constexpr size_t kSamplerate = 48000;
+constexpr size_t kOutputSize = kSamplerate;
+constexpr float kFreq = 750;
+constexpr size_t kBlockSize = 512;
+
+using FormantMode = sfdsp::VectorPhaseshaper::FormantMode;
+using AntiAliasing = sfdsp::VectorPhaseshaper::AntiAliasing;
+
+void RenderBlock(FormantMode formant_mode, AntiAliasing anti_aliasing, const std::string& name,
+                 nanobench::Bench& bench)
+{
+    sfdsp::VectorPhaseshaper vps;
+    vps.Init(kSamplerate);
+    vps.SetFreq(kFreq);
+    // v above 1 crossfades two formants in RATIO mode.
+    vps.SetMod(0.3f, 2.3f);
+    vps.SetFormantMode(formant_mode);
+    vps.SetAntiAliasing(anti_aliasing);
+    auto out = std::make_unique<float[]>(kOutputSize);
+
+    bench.run(name, [&]() {
+        for (size_t i = 0; i < kOutputSize; i += kBlockSize)
+        {
+            vps.ProcessBlock(out.get() + i, std::min(kBlockSize, kOutputSize - i));
+        }
+        nanobench::doNotOptimizeAway(out[0]);
+    });
+}
+} // namespace
+
+TEST_CASE("VectorPhaseshaper")
+{
+    nanobench::Bench bench;
+    bench.title("VectorPhaseshaper::ProcessBlock");
+    bench.relative(true);
+    bench.minEpochIterations(10);
+    bench.unit("sample");
+    bench.batch(kOutputSize);
+
+    for (auto formant_mode : {FormantMode::FREE, FormantMode::RATIO})
+    {
+        const std::string mode_name = (formant_mode == FormantMode::FREE) ? "FREE" : "RATIO";
+        RenderBlock(formant_mode, AntiAliasing::NONE, mode_name, bench);
+        RenderBlock(formant_mode, AntiAliasing::OVERSAMPLE_4X, mode_name + ", 4x oversampled", bench);
+    }
+}
@@ -0,0 +1,54 @@
+#include "doctest.h"
+#include "nanobench.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "phaseshapers.h"
+#include "voice_pool.h"
+
+using namespace ankerl;
+
+namespace
+{
+constexpr float kSamplerate = 48000.f;
+constexpr size_t kBlockSize = 256;
+constexpr size_t kBlockCount = 48000 / kBlockSize;
+
+template <size_t Capacity>
+void RenderPool(size_t note_count, nanobench::Bench& bench)
+{
+    auto pool = std::make_unique<sfdsp::VoicePool<sfdsp::Phaseshaper, Capacity>>();
+    pool->Init(kSamplerate);
+    for (size_t i = 0; i < note_count; ++i)
+    {
+        pool->NoteOn(static_cast<uint8_t>(36 + i), 0.5f);
+    }
+    auto out = std::make_unique<float[]>(kBlockSize);
+
+    bench.run(std::to_string(note_count) + " notes, " + std::to_string(Capacity) + " voices", [&]() {
+        for (size_t block = 0; block < kBlockCount; ++block)
+        {
+            pool->ProcessBlock(out.get(), kBlockSize);
+        }
+        nanobench::doNotOptimizeAway(out[0]);
+    });
+}
+} // namespace
+
+TEST_CASE("VoicePool")
+{
+    nanobench::Bench bench;
+    bench.title("VoicePool<Phaseshaper>::ProcessBlock");
+    bench.relative(true);
+    bench.minEpochIterations(3);
+    bench.unit("sample");
+    bench.batch(kBlockSize * kBlockCount);
+
+    // The cost follows the number of notes, not the capacity of the pool.
+    RenderPool<8>(1, bench);
+    RenderPool<64>(1, bench);
+    RenderPool<64>(4, bench);
+    RenderPool<64>(16, bench);
+    RenderPool<64>(64, bench);
+}
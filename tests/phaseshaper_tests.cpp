@@ -0,0 +1,381 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <thread>
+#include <vector>
+
+#include "fft.h"
+#include "phaseshapers.h"
+
+namespace
+{
+constexpr float kSamplerate = 48000.f;
+
+const float kWaveforms[] = {0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 0.3f, 2.5f, 4.7f};
+
+/// @brief Average frequency of a signal, from its rising zero crossings.
+float ZeroCrossingFrequency(const std::vector<float>& x)
+{
+    size_t first = 0;
+    size_t last = 0;
+    size_t count = 0;
+    for (size_t i = 1; i < x.size(); ++i)
+    {
+        if (x[i - 1] < 0.f && x[i] >= 0.f)
+        {
+            if (count == 0)
+            {
+                first = i;
+            }
+            last = i;
+            ++count;
+        }
+    }
+    return static_cast<float>(count - 1) * kSamplerate / static_cast<float>(last - first);
+}
+
+double Rms(const std::vector<float>& x)
+{
+    double sum = 0.0;
+    for (float v : x)
+    {
+        sum += static_cast<double>(v) * v;
+    }
+    return std::sqrt(sum / static_cast<double>(x.size()));
+}
+
+/// @brief Power of a signal away from the harmonics of `f0`, relative to the power on the harmonics, in dB.
+double AliasingDb(const std::vector<float>& x, float f0)
+{
+    const size_t size = x.size();
+    sfdsp::FFT fft(size);
+    std::vector<float> windowed(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        const double hann = 0.5 - 0.5 * std::cos(2.0 * std::numbers::pi * i / size);
+        windowed[i] = static_cast<float>(x[i] * hann);
+    }
+    std::vector<std::complex<float>> spectrum(size / 2 + 1);
+    fft.Forward(windowed.data(), spectrum.data());
+
+    const double bin_width = kSamplerate / size;
+    double harmonic = 0.0;
+    double other = 0.0;
+    for (size_t k = 1; k < spectrum.size(); ++k)
+    {
+        const double ratio = k * bin_width / f0;
+        const double distance = std::abs(ratio - std::round(ratio)) * f0;
+        (distance < 3.0 * bin_width ? harmonic : other) += std::norm(spectrum[k]);
+    }
+    return 10.0 * std::log10(other / harmonic);
+}
+
+/// @brief DFT of a signal at one bin.
+std::complex<double> Dft(const std::vector<float>& x, size_t bin)
+{
+    std::complex<double> sum = 0.0;
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        sum += static_cast<double>(x[i]) * std::polar(1.0, -2.0 * std::numbers::pi * bin * i / x.size());
+    }
+    return sum;
+}
+
+std::vector<float> Render(float wave, float freq, float mod, bool wavetable, size_t size)
+{
+    sfdsp::Phaseshaper ps;
+    ps.Init(kSamplerate);
+    ps.SetFreq(freq);
+    ps.SetMod(mod);
+    ps.SetWaveform(wave);
+    ps.SetWavetableMode(wavetable);
+    std::vector<float> out(size);
+    ps.ProcessBlock(out.data(), size);
+    return out;
+}
+} // namespace
+
+TEST(PhaseshaperTest, BlockMatchesTick)
+{
+    // Not a multiple of the vector width, to exercise the tail of the block kernels.
+    constexpr size_t kSize = 1001;
+    for (float wave : kWaveforms)
+    {
+        for (float mod : {0.f, 0.4f, 1.f})
+        {
+            // The higher frequency puts more samples inside the BLEP corrections.
+            for (float freq : {440.f, 5000.f})
+            {
+                sfdsp::Phaseshaper tick;
+                sfdsp::Phaseshaper block;
+                for (auto* ps : {&tick, &block})
+                {
+                    ps->Init(kSamplerate);
+                    ps->SetFreq(freq);
+                    ps->SetMod(mod);
+                    ps->SetWaveform(wave);
+                }
+
+                std::vector<float> out(kSize);
+                block.ProcessBlock(out.data(), kSize);
+                for (size_t i = 0; i < kSize; ++i)
+                {
+                    const float expected = tick.Process();
+                    ASSERT_TRUE(std::isfinite(out[i])) << wave << ", " << mod << ", " << freq << ", " << i;
+                    ASSERT_NEAR(out[i], expected, 1e-5f) << wave << ", " << mod << ", " << freq << ", " << i;
+                }
+            }
+        }
+    }
+}
+
+TEST(PhaseshaperTest, AudioRateModulation)
+{
+    constexpr size_t kSize = 1001;
+
+    // Fast vibrato and a modulation ramp that goes past both ends of the range.
+    std::vector<float> freq(kSize);
+    std::vector<float> mod(kSize);
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        freq[i] = 2000.f + 1500.f * std::sin(static_cast<float>(i) * 0.05f);
+        mod[i] = -0.2f + 1.4f * static_cast<float>(i) / kSize;
+    }
+
+    for (float wave : kWaveforms)
+    {
+        for (int buffers = 0; buffers < 4; ++buffers)
+        {
+            const float* freq_buffer = (buffers & 1) ? freq.data() : nullptr;
+            const float* mod_buffer = (buffers & 2) ? mod.data() : nullptr;
+
+            sfdsp::Phaseshaper tick;
+            sfdsp::Phaseshaper block;
+            for (auto* ps : {&tick, &block})
+            {
+                ps->Init(kSamplerate);
+                ps->SetFreq(440.f);
+                ps->SetMod(0.4f);
+                ps->SetWaveform(wave);
+            }
+
+            std::vector<float> out(kSize);
+            block.ProcessBlock(out.data(), kSize, freq_buffer, mod_buffer);
+            for (size_t i = 0; i < kSize; ++i)
+            {
+                if (freq_buffer != nullptr)
+                {
+                    tick.SetFreq(freq[i]);
+                }
+                if (mod_buffer != nullptr)
+                {
+                    tick.SetMod(mod[i]);
+                }
+                ASSERT_NEAR(out[i], tick.Process(), 1e-5f) << wave << ", " << buffers << ", " << i;
+            }
+        }
+    }
+}
+
+TEST(PhaseshaperWavetableTest, Threads)
+{
+    // The first use of the tables from several threads at once builds them once.
+    constexpr size_t kSize = 4096;
+    constexpr size_t kThreadCount = 4;
+    std::vector<std::vector<float>> outputs(kThreadCount);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kThreadCount; ++t)
+    {
+        threads.emplace_back([&outputs, t]() { outputs[t] = Render(5.5f, 440.f, 0.3f, true, kSize); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (size_t t = 1; t < kThreadCount; ++t)
+    {
+        EXPECT_EQ(outputs[t], outputs[0]);
+    }
+}
+
+TEST(PhaseshaperWavetableTest, Prepare)
+{
+    // Preparing is idempotent and ignores the out of range waveform.
+    sfdsp::Phaseshaper::PrepareWavetables();
+    sfdsp::Phaseshaper::PrepareWavetables(sfdsp::Phaseshaper::Waveform::RIPPLE);
+    sfdsp::Phaseshaper::PrepareWavetables(sfdsp::Phaseshaper::Waveform::NUM_WAVES);
+
+    for (float wave : {0.f, 1.f, 2.f, 3.f, 4.f, 5.f})
+    {
+        const auto out = Render(wave, 440.f, 0.5f, true, 1024);
+        EXPECT_GT(Rms(out), 0.1) << wave;
+    }
+}
+
+TEST(PhaseshaperWavetableTest, MatchesDirect)
+{
+    // A prime period, so that no sample falls exactly on an edge of the naive waveforms, and low enough that their
+    // aliasing stays small.
+    constexpr size_t kPeriod = 1999;
+    constexpr size_t kPeriodCount = 2;
+    constexpr float kFreq = kSamplerate / kPeriod;
+
+    // On one of the pre-rendered modulation amounts, the first harmonics are the ones of the direct rendering.
+    for (float wave : {0.f, 1.f, 2.f, 3.f, 4.f, 5.f})
+    {
+        const auto direct = Render(wave, kFreq, 0.5f, false, kPeriod * kPeriodCount);
+        const auto table = Render(wave, kFreq, 0.5f, true, kPeriod * kPeriodCount);
+
+        double peak = 0.0;
+        double error = 0.0;
+        for (size_t harmonic = 1; harmonic <= 20; ++harmonic)
+        {
+            const auto expected = Dft(direct, harmonic * kPeriodCount);
+            peak = std::max(peak, std::abs(expected));
+            error = std::max(error, std::abs(expected - Dft(table, harmonic * kPeriodCount)));
+        }
+        EXPECT_LT(20.0 * std::log10(error / peak), -45.0) << wave;
+    }
+}
+
+TEST(PhaseshaperWavetableTest, Aliasing)
+{
+    constexpr size_t kSize = 1 << 15;
+    constexpr float kFreq = 3001.f;
+
+    for (float wave : {0.f, 1.f, 2.f, 3.f, 4.f, 5.f})
+    {
+        const double direct = AliasingDb(Render(wave, kFreq, 0.5f, false, kSize), kFreq);
+        const double table = AliasingDb(Render(wave, kFreq, 0.5f, true, kSize), kFreq);
+        EXPECT_LT(table, -35.0) << wave;
+        EXPECT_LT(table, direct) << wave;
+    }
+}
+
+TEST(PhaseshaperWavetableTest, BlockMatchesTick)
+{
+    constexpr size_t kSize = 1001;
+    std::vector<float> freq(kSize);
+    std::vector<float> mod(kSize);
+    for (size_t i = 0; i < kSize; ++i)
+    {
+        // Sweeps over several mipmap levels and modulation slices.
+        freq[i] = 100.f * std::exp2(6.f * static_cast<float>(i) / kSize);
+        mod[i] = static_cast<float>(i) / kSize;
+    }
+
+    for (float wave : kWaveforms)
+    {
+        sfdsp::Phaseshaper tick;
+        sfdsp::Phaseshaper block;
+        for (auto* ps : {&tick, &block})
+        {
+            ps->Init(kSamplerate);
+            ps->SetWaveform(wave);
+            ps->SetWavetableMode(true);
+        }
+
+        std::vector<float> out(kSize);
+        block.ProcessBlock(out.data(), kSize, freq.data(), mod.data());
+        for (size_t i = 0; i < kSize; ++i)
+        {
+            tick.SetFreq(freq[i]);
+            tick.SetMod(mod[i]);
+            ASSERT_NEAR(out[i], tick.Process(), 1e-5f) << wave << ", " << i;
+        }
+    }
+}
+
+TEST(PhaseshaperUnisonTest, SingleVoice)
+{
+    // Not a multiple of the internal buffer size.
+    constexpr size_t kSize = 1500;
+    const float kCenterGain = std::sqrt(0.5f);
+
+    for (float wave : kWaveforms)
+    {
+        sfdsp::Phaseshaper mono;
+        mono.Init(kSamplerate);
+        mono.SetFreq(440.f);
+        mono.SetMod(0.4f);
+        mono.SetWaveform(wave);
+        std::vector<float> expected(kSize);
+        mono.ProcessBlock(expected.data(), kSize);
+
+        sfdsp::PhaseshaperUnison unison;
+        unison.Init(kSamplerate, 1);
+        unison.SetFreq(440.f);
+        unison.SetMod(0.4f);
+        unison.SetDetune(30.f);
+        unison.SetSpread(1.f);
+        unison.SetWaveform(wave);
+        std::vector<float> left(kSize);
+        std::vector<float> right(kSize);
+        unison.ProcessBlock(left.data(), right.data(), kSize);
+
+        // A single voice is neither detuned nor panned.
+        for (size_t i = 0; i < kSize; ++i)
+        {
+            ASSERT_NEAR(left[i], expected[i] * kCenterGain, 1e-6f) << wave << ", " << i;
+            ASSERT_NEAR(right[i], expected[i] * kCenterGain, 1e-6f) << wave << ", " << i;
+        }
+    }
+}
+
+TEST(PhaseshaperUnisonTest, DetuneAndSpread)
+{
+    constexpr size_t kSize = static_cast<size_t>(kSamplerate);
+    constexpr float kFreq = 440.f;
+    constexpr float kDetune = 50.f;
+
+    // Two voices panned hard: each channel holds one voice.
+    sfdsp::PhaseshaperUnison unison;
+    unison.Init(kSamplerate, 2);
+    unison.SetWaveform(sfdsp::Phaseshaper::Waveform::VARIABLE_SLOPE);
+    unison.SetFreq(kFreq);
+    unison.SetDetune(kDetune);
+    unison.SetSpread(1.f);
+
+    std::vector<float> left(kSize);
+    std::vector<float> right(kSize);
+    unison.ProcessBlock(left.data(), right.data(), kSize);
+
+    EXPECT_NEAR(ZeroCrossingFrequency(left), kFreq * std::exp2(-kDetune / 1200.f), 0.5f);
+    EXPECT_NEAR(ZeroCrossingFrequency(right), kFreq * std::exp2(kDetune / 1200.f), 0.5f);
+
+    // Without spread, both channels are identical.
+    unison.SetSpread(0.f);
+    unison.ProcessBlock(left.data(), right.data(), kSize);
+    EXPECT_EQ(left, right);
+}
+
+TEST(PhaseshaperUnisonTest, VoiceCount)
+{
+    constexpr size_t kSize = static_cast<size_t>(kSamplerate);
+
+    sfdsp::PhaseshaperUnison unison;
+    unison.Init(kSamplerate, 100);
+    EXPECT_EQ(unison.GetVoiceCount(), sfdsp::PhaseshaperUnison::kMaxVoices);
+    unison.SetVoiceCount(0);
+    EXPECT_EQ(unison.GetVoiceCount(), 1u);
+
+    unison.SetFreq(110.f);
+    unison.SetDetune(25.f);
+    unison.SetSpread(0.5f);
+    std::vector<float> left(kSize);
+    std::vector<float> right(kSize);
+    unison.ProcessBlock(left.data(), right.data(), kSize);
+    const double reference = Rms(left) + Rms(right);
+
+    // The voices are summed with a gain of 1/sqrt(N), the level stays about the same for any voice count, including
+    // counts that are not a multiple of the vector width.
+    for (size_t voice_count : {3, 7, 16})
+    {
+        unison.SetVoiceCount(voice_count);
+        unison.ProcessBlock(left.data(), right.data(), kSize);
+        const double level = Rms(left) + Rms(right);
+        EXPECT_NEAR(20.0 * std::log10(level / reference), 0.0, 2.0) << voice_count;
+    }
+}
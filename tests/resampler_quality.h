@@ -0,0 +1,207 @@
+// Quality measurements shared by the resampler tests and tools/resampler/resampler_bench.
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <numbers>
+#include <vector>
+
+#include "sinc_resampler.h"
+
+namespace resampler_quality
+{
+using ResampleFn =
+    std::function<std::vector<float>(const std::vector<float>& in, size_t input_rate, size_t output_rate)>;
+
+/// @brief Passband ripple, stopband level and THD+N of a resampler, see `MeasureQuality`.
+struct Quality
+{
+    double ripple_db = 0.0;
+    double stopband_db = 0.0;
+    double thdn_db = 0.0;
+};
+
+constexpr size_t kBlockSize = 512;
+
+inline std::vector<float> UseSincResample(const std::vector<float>& in, size_t input_rate, size_t output_rate)
+{
+    const auto ratio = static_cast<float>(output_rate) / static_cast<float>(input_rate);
+    size_t out_size = static_cast<size_t>(std::ceil(static_cast<double>(in.size()) * ratio));
+    std::vector<float> out(out_size);
+    sfdsp::sinc_resample(in.data(), in.size(), ratio, out.data(), out_size);
+    out.resize(out_size);
+    return out;
+}
+
+inline ResampleFn UseSincResampler(sfdsp::SincQuality quality)
+{
+    return [quality](const std::vector<float>& in, size_t input_rate, size_t output_rate) {
+        sfdsp::SincResampler resampler;
+        resampler.Init(input_rate, output_rate, 1, quality);
+
+        // Zeros after the signal flush the samples held back by the filter.
+        std::vector<float> padded(in);
+        padded.resize(in.size() + resampler.GetLatency(), 0.f);
+        std::vector<float> out(resampler.GetMaxOutputSize(padded.size()));
+        size_t written = 0;
+        for (size_t i = 0; i < padded.size(); i += kBlockSize)
+        {
+            const size_t count = std::min(kBlockSize, padded.size() - i);
+            written += resampler.Process(padded.data() + i, count, out.data() + written);
+        }
+        out.resize(written);
+        return out;
+    };
+}
+
+inline std::vector<float> UseVarispeedResampler(const std::vector<float>& in, size_t input_rate, size_t output_rate)
+{
+    const double ratio = static_cast<double>(output_rate) / static_cast<double>(input_rate);
+    sfdsp::VarispeedResampler resampler;
+    resampler.Init(static_cast<float>(ratio));
+
+    // The filter looks ahead by at most 4 * 32 input samples.
+    std::vector<float> padded(in);
+    padded.resize(in.size() + 256, 0.f);
+    std::vector<float> out(static_cast<size_t>(std::ceil(static_cast<double>(padded.size()) * ratio)) + kBlockSize);
+    size_t written = 0;
+    size_t offset = 0;
+    while (offset < padded.size() && written + kBlockSize <= out.size())
+    {
+        size_t used = 0;
+        const size_t count = std::min(kBlockSize, padded.size() - offset);
+        written += resampler.Process(padded.data() + offset, count, used, out.data() + written, kBlockSize);
+        offset += used;
+    }
+    out.resize(written);
+    return out;
+}
+
+inline std::vector<float> MakeSine(double freq, size_t samplerate, size_t size, double amplitude = 1.0)
+{
+    std::vector<float> sine(size);
+    const double w = 2.0 * std::numbers::pi * freq / static_cast<double>(samplerate);
+    for (size_t i = 0; i < size; ++i)
+    {
+        sine[i] = static_cast<float>(amplitude * std::sin(w * static_cast<double>(i)));
+    }
+    return sine;
+}
+
+/// @brief Least squares fit of a sine of known frequency, and of a DC offset, over the middle half of the signal.
+/// @param[out] residual_rms The RMS of what the fit does not explain.
+/// @return The amplitude of the sine.
+inline double FitSine(const std::vector<float>& signal, double freq, size_t samplerate, double& residual_rms)
+{
+    const size_t start = signal.size() / 4;
+    const size_t end = signal.size() - signal.size() / 4;
+    const double w = 2.0 * std::numbers::pi * freq / static_cast<double>(samplerate);
+
+    // Normal equations of y = a * sin + b * cos + c.
+    double m[3][3] = {};
+    double v[3] = {};
+    for (size_t i = start; i < end; ++i)
+    {
+        const double basis[3] = {std::sin(w * static_cast<double>(i)), std::cos(w * static_cast<double>(i)), 1.0};
+        for (size_t r = 0; r < 3; ++r)
+        {
+            for (size_t c = 0; c < 3; ++c)
+            {
+                m[r][c] += basis[r] * basis[c];
+            }
+            v[r] += basis[r] * signal[i];
+        }
+    }
+
+    // Gaussian elimination, the matrix is symmetric positive definite.
+    for (size_t p = 0; p < 3; ++p)
+    {
+        for (size_t r = p + 1; r < 3; ++r)
+        {
+            const double f = m[r][p] / m[p][p];
+            for (size_t c = p; c < 3; ++c)
+            {
+                m[r][c] -= f * m[p][c];
+            }
+            v[r] -= f * v[p];
+        }
+    }
+    double x[3] = {};
+    for (size_t p = 3; p-- > 0;)
+    {
+        double acc = v[p];
+        for (size_t c = p + 1; c < 3; ++c)
+        {
+            acc -= m[p][c] * x[c];
+        }
+        x[p] = acc / m[p][p];
+    }
+
+    double residual = 0.0;
+    for (size_t i = start; i < end; ++i)
+    {
+        const double t = w * static_cast<double>(i);
+        const double e = signal[i] - (x[0] * std::sin(t) + x[1] * std::cos(t) + x[2]);
+        residual += e * e;
+    }
+    residual_rms = std::sqrt(residual / static_cast<double>(end - start));
+    return std::hypot(x[0], x[1]);
+}
+
+inline double ToDb(double value)
+{
+    return 20.0 * std::log10(std::max(value, 1e-12));
+}
+
+inline Quality MeasureQuality(const ResampleFn& resample)
+{
+    Quality quality;
+
+    // Passband ripple, 44.1 kHz -> 48 kHz, stepped sine sweep from 20 Hz to 0.45 * 44.1 kHz.
+    constexpr size_t kUpIn = 44100;
+    constexpr size_t kUpOut = 48000;
+    constexpr size_t kSweepSteps = 32;
+    double min_gain = 1e9;
+    double max_gain = 0.0;
+    for (size_t step = 0; step < kSweepSteps; ++step)
+    {
+        const double freq = 20.0 * std::pow(0.45 * kUpIn / 20.0, static_cast<double>(step) / (kSweepSteps - 1));
+        const auto out = resample(MakeSine(freq, kUpIn, kUpIn / 4), kUpIn, kUpOut);
+        double residual = 0.0;
+        const double gain = FitSine(out, freq, kUpOut, residual);
+        min_gain = std::min(min_gain, gain);
+        max_gain = std::max(max_gain, gain);
+    }
+    quality.ripple_db = ToDb(max_gain) - ToDb(min_gain);
+
+    // Stopband rejection, 96 kHz -> 44.1 kHz. The filters are centered on the output Nyquist frequency, the stopband
+    // starts past the transition band of the shortest one.
+    constexpr size_t kDownIn = 96000;
+    constexpr size_t kDownOut = 44100;
+    double max_level = 0.0;
+    for (size_t step = 0; step < kSweepSteps; ++step)
+    {
+        const double low = 0.6 * kDownOut;
+        const double high = 0.49 * kDownIn;
+        const double freq = low + (high - low) * static_cast<double>(step) / (kSweepSteps - 1);
+        const auto out = resample(MakeSine(freq, kDownIn, kDownIn / 8), kDownIn, kDownOut);
+        double power = 0.0;
+        for (size_t i = out.size() / 4; i < out.size() - out.size() / 4; ++i)
+        {
+            power += static_cast<double>(out[i]) * out[i];
+        }
+        max_level = std::max(max_level, std::sqrt(2.0 * power / static_cast<double>(out.size() / 2)));
+    }
+    quality.stopband_db = ToDb(max_level);
+
+    // THD+N of a 1 kHz sine at -6 dBFS, 44.1 kHz -> 48 kHz.
+    const auto out = resample(MakeSine(1000.0, kUpIn, kUpIn / 2, 0.5), kUpIn, kUpOut);
+    double residual = 0.0;
+    const double amplitude = FitSine(out, 1000.0, kUpOut, residual);
+    quality.thdn_db = ToDb(residual * std::numbers::sqrt2) - ToDb(amplitude);
+
+    return quality;
+}
+} // namespace resampler_quality
@@ -1,11 +1,21 @@
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstdio>
+#include <numbers>
 #include <numeric>
+#include <utility>
+#include <vector>
 
 #include "chorus.h"
 #include "dsp_utils.h"
 #include "sinc_resampler.h"
+#include "sinc_table.h"
+#include "sinc_tables.h"
+
+#include "resampler_quality.h"
 
 TEST(SincInterpolateTest, NoOp)
 {
@@ -68,4 +78,430 @@ TEST(SincInterpolateTest, Downsample2X)
 
     size_t out_size = output.max_size();
     sfdsp::sinc_resample(input.data(), array_size, sample_ratio, output.data(), out_size);
-}
\ No newline at end of file
+}
+
+namespace
+{
+std::vector<float> ResampleAll(sfdsp::SincResampler& resampler, const std::vector<float>& input, size_t block_size)
+{
+    std::vector<float> output;
+    std::vector<float> block_out(resampler.GetMaxOutputSize(block_size));
+    for (size_t i = 0; i < input.size(); i += block_size)
+    {
+        const size_t count = std::min(block_size, input.size() - i);
+        const size_t written = resampler.Process(input.data() + i, count, block_out.data());
+        output.insert(output.end(), block_out.begin(), block_out.begin() + written);
+    }
+    return output;
+}
+} // namespace
+
+TEST(SincResamplerTest, Accuracy)
+{
+    auto signal = [](double t) { return std::sin(0.05 * t) + 0.5 * std::sin(0.71 * t); };
+
+    for (auto [input_rate, output_rate] : {std::pair{44100, 48000}, std::pair{48000, 44100}, std::pair{48000, 96000}})
+    {
+        const double ratio = static_cast<double>(output_rate) / input_rate;
+        std::vector<float> input(2048);
+        for (size_t i = 0; i < input.size(); ++i)
+        {
+            input[i] = static_cast<float>(signal(static_cast<double>(i)));
+        }
+
+        const auto expected_size = static_cast<size_t>(std::ceil(static_cast<double>(input.size()) * ratio));
+
+        sfdsp::SincResampler resampler;
+        resampler.Init(input_rate, output_rate);
+        EXPECT_DOUBLE_EQ(resampler.GetRatio(), ratio);
+
+        // Push zeros at the end to get the outputs held back by the latency.
+        input.resize(input.size() + resampler.GetLatency(), 0.f);
+        const auto output = ResampleAll(resampler, input, 100);
+        ASSERT_GE(output.size(), expected_size);
+
+        // Away from the edges, the output follows the band limited input.
+        const size_t margin = 128;
+        for (size_t i = margin; i < expected_size - margin; ++i)
+        {
+            const auto reference = static_cast<float>(signal(static_cast<double>(i) / ratio));
+            ASSERT_NEAR(output[i], reference, 1e-4f) << input_rate << " -> " << output_rate << " at " << i;
+        }
+    }
+}
+
+TEST(SincResamplerTest, Streaming)
+{
+    std::vector<float> input(5000);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        input[i] = std::sin(0.013f * static_cast<float>(i * i % 997));
+    }
+
+    sfdsp::SincResampler resampler;
+    resampler.Init(48000, 44100);
+    const auto expected = ResampleAll(resampler, input, input.size());
+
+    for (size_t block_size : {1, 7, 64, 300, 1000})
+    {
+        resampler.Reset();
+        const auto output = ResampleAll(resampler, input, block_size);
+        ASSERT_EQ(output.size(), expected.size());
+        for (size_t i = 0; i < output.size(); ++i)
+        {
+            ASSERT_EQ(output[i], expected[i]) << block_size << " at " << i;
+        }
+    }
+}
+
+TEST(SincResamplerTest, ApproximatedRatio)
+{
+    // 48001 / 44100 would need 48001 phases.
+    sfdsp::SincResampler resampler;
+    resampler.Init(44100, 48001);
+    EXPECT_NEAR(resampler.GetRatio(), 48001.0 / 44100.0, 1e-6);
+}
+
+TEST(SincInterpolateTest, Multichannel)
+{
+    constexpr size_t kFrames = 700;
+    constexpr float kRatio = 48000.f / 44100.f;
+
+    for (size_t channels : {2, 5, 16})
+    {
+        std::vector<float> interleaved(kFrames * channels);
+        for (size_t i = 0; i < interleaved.size(); ++i)
+        {
+            interleaved[i] = std::sin(0.37f * static_cast<float>(i % 101)) * static_cast<float>(i % channels + 1);
+        }
+
+        size_t out_size = kFrames * 2;
+        std::vector<float> output(out_size * channels);
+        sfdsp::sinc_resample(interleaved.data(), kFrames, channels, kRatio, output.data(), out_size);
+
+        // Same result as resampling each channel on its own.
+        for (size_t c = 0; c < channels; ++c)
+        {
+            std::vector<float> mono(kFrames);
+            for (size_t i = 0; i < kFrames; ++i)
+            {
+                mono[i] = interleaved[i * channels + c];
+            }
+            size_t mono_out_size = kFrames * 2;
+            std::vector<float> mono_out(mono_out_size);
+            sfdsp::sinc_resample(mono.data(), kFrames, kRatio, mono_out.data(), mono_out_size);
+
+            ASSERT_EQ(out_size, mono_out_size);
+            for (size_t i = 0; i < out_size; ++i)
+            {
+                ASSERT_NEAR(output[i * channels + c], mono_out[i], 1e-5f) << channels << " channels, " << c << ", " << i;
+            }
+        }
+    }
+}
+
+TEST(SincResamplerTest, Multichannel)
+{
+    constexpr size_t kFrames = 3000;
+    constexpr size_t kChannels = 6;
+    std::vector<float> interleaved(kFrames * kChannels);
+    for (size_t i = 0; i < interleaved.size(); ++i)
+    {
+        interleaved[i] = std::sin(0.011f * static_cast<float>(i % 1009)) * static_cast<float>(i % kChannels + 1);
+    }
+
+    sfdsp::SincResampler resampler;
+    resampler.Init(48000, 44100, kChannels);
+    EXPECT_EQ(resampler.GetChannelCount(), kChannels);
+
+    std::vector<float> output(resampler.GetMaxOutputSize(kFrames) * kChannels);
+    size_t written = 0;
+    for (size_t i = 0; i < kFrames; i += 250)
+    {
+        written += resampler.Process(interleaved.data() + i * kChannels, 250, output.data() + written * kChannels);
+    }
+
+    for (size_t c = 0; c < kChannels; ++c)
+    {
+        std::vector<float> mono(kFrames);
+        for (size_t i = 0; i < kFrames; ++i)
+        {
+            mono[i] = interleaved[i * kChannels + c];
+        }
+        sfdsp::SincResampler mono_resampler;
+        mono_resampler.Init(48000, 44100);
+        std::vector<float> mono_out(mono_resampler.GetMaxOutputSize(kFrames));
+        ASSERT_EQ(mono_resampler.Process(mono.data(), kFrames, mono_out.data()), written);
+
+        for (size_t i = 0; i < written; ++i)
+        {
+            ASSERT_NEAR(output[i * kChannels + c], mono_out[i], 1e-5f) << c << ", " << i;
+        }
+    }
+}
+
+namespace
+{
+// Feeds `input` in blocks of `input_block` samples and reads the output in blocks of `output_block` samples.
+std::vector<float> VarispeedAll(sfdsp::VarispeedResampler& resampler, const std::vector<float>& input,
+                                size_t input_block, size_t output_block, const float* ratios = nullptr)
+{
+    std::vector<float> output;
+    std::vector<float> block_out(output_block);
+    size_t offset = 0;
+    while (true)
+    {
+        const size_t count = std::min(input_block, input.size() - offset);
+        size_t used = 0;
+        const size_t written =
+            ratios ? resampler.Process(input.data() + offset, count, used, block_out.data(), output_block,
+                                       ratios + output.size())
+                   : resampler.Process(input.data() + offset, count, used, block_out.data(), output_block);
+        output.insert(output.end(), block_out.begin(), block_out.begin() + written);
+        offset += used;
+        if (written < output_block && offset == input.size())
+        {
+            return output;
+        }
+    }
+}
+} // namespace
+
+TEST(VarispeedResamplerTest, ConstantRatio)
+{
+    auto signal = [](double t) { return std::sin(0.05 * t) + 0.5 * std::sin(0.71 * t); };
+
+    for (float ratio : {48000.f / 44100.f, 44100.f / 48000.f, 2.f})
+    {
+        std::vector<float> input(2048);
+        for (size_t i = 0; i < input.size(); ++i)
+        {
+            input[i] = static_cast<float>(signal(static_cast<double>(i)));
+        }
+
+        sfdsp::VarispeedResampler resampler;
+        resampler.Init(ratio);
+        EXPECT_FLOAT_EQ(resampler.GetRatio(), ratio);
+        const auto output = VarispeedAll(resampler, input, 100, 100);
+
+        const auto expected_size = static_cast<size_t>(static_cast<double>(input.size()) * ratio);
+        // The last outputs wait for the input that follows.
+        ASSERT_GE(output.size(), expected_size - 128);
+
+        const size_t margin = 128;
+        for (size_t i = margin; i < output.size() - margin; ++i)
+        {
+            const auto reference = static_cast<float>(signal(static_cast<double>(i) / ratio));
+            ASSERT_NEAR(output[i], reference, 1e-4f) << ratio << " at " << i;
+        }
+    }
+}
+
+TEST(VarispeedResamplerTest, Streaming)
+{
+    std::vector<float> input(5000);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        input[i] = std::sin(0.013f * static_cast<float>(i * i % 997));
+    }
+
+    sfdsp::VarispeedResampler resampler;
+    resampler.Init(0.9f);
+    resampler.SetRatio(1.7f);
+    const auto expected = VarispeedAll(resampler, input, input.size(), input.size() * 2);
+
+    for (auto [input_block, output_block] : {std::pair{1, 1}, std::pair{7, 300}, std::pair{300, 7}, {64, 64}})
+    {
+        resampler.SetRatio(0.9f);
+        resampler.Reset();
+        resampler.SetRatio(1.7f);
+        const auto output = VarispeedAll(resampler, input, input_block, output_block);
+        ASSERT_EQ(output.size(), expected.size());
+        for (size_t i = 0; i < output.size(); ++i)
+        {
+            ASSERT_EQ(output[i], expected[i]) << input_block << ", " << output_block << " at " << i;
+        }
+    }
+}
+
+TEST(VarispeedResamplerTest, RatioBuffer)
+{
+    std::vector<float> input(3000);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        input[i] = std::sin(0.021f * static_cast<float>(i));
+    }
+
+    // A constant ratio buffer matches SetRatio.
+    sfdsp::VarispeedResampler resampler;
+    resampler.Init(0.75f);
+    const auto expected = VarispeedAll(resampler, input, 128, 128);
+
+    std::vector<float> ratios(input.size() * 2, 0.75f);
+    resampler.Reset();
+    const auto output = VarispeedAll(resampler, input, 128, 128, ratios.data());
+    ASSERT_EQ(output.size(), expected.size());
+    for (size_t i = 0; i < output.size(); ++i)
+    {
+        ASSERT_EQ(output[i], expected[i]) << i;
+    }
+
+    // An exponential sweep over the whole range, out of range values are clamped.
+    for (size_t i = 0; i < ratios.size(); ++i)
+    {
+        ratios[i] = 0.1f * std::pow(200.f, static_cast<float>(i) / static_cast<float>(ratios.size()));
+    }
+    resampler.Reset();
+    const auto swept = VarispeedAll(resampler, input, 128, 128, ratios.data());
+    ASSERT_GT(swept.size(), 0u);
+    for (size_t i = 0; i < swept.size(); ++i)
+    {
+        ASSERT_LT(std::abs(swept[i]), 1.1f) << i;
+    }
+}
+
+TEST(VarispeedResamplerTest, Glide)
+{
+    const std::vector<float> input(4000, 0.f);
+    std::vector<float> output(64);
+
+    sfdsp::VarispeedResampler resampler;
+    resampler.Init(1.f);
+    resampler.SetRatio(3.f);
+
+    float previous = resampler.GetRatio();
+    size_t offset = 0;
+    for (size_t block = 0; block < 20; ++block)
+    {
+        size_t used = 0;
+        resampler.Process(input.data() + offset, input.size() - offset, used, output.data(), output.size());
+        offset += used;
+        EXPECT_GE(resampler.GetRatio(), previous);
+        EXPECT_LE(resampler.GetRatio(), 3.f);
+        previous = resampler.GetRatio();
+    }
+    EXPECT_NEAR(resampler.GetRatio(), 3.f, 1e-3f);
+
+    // Out of range values are clamped.
+    resampler.SetRatio(100.f);
+    resampler.Reset();
+    EXPECT_EQ(resampler.GetRatio(), sfdsp::VarispeedResampler::kMaxRatio);
+}
+
+TEST(SincTablesTest, Generation)
+{
+    // Same as the table generated by scripts/make_sinc_table.py.
+    const auto table = sfdsp::MakeSincTable<SINC_ZERO_COUNT, SAMPLES_PER_CROSSING>(10.0);
+    ASSERT_EQ(table.size(), sinc_table_size + 1);
+    for (size_t i = 0; i < table.size(); ++i)
+    {
+        ASSERT_NEAR(table[i], sinc_table[i], 1e-6f) << i;
+    }
+
+    for (auto quality : {sfdsp::SincQuality::Fast, sfdsp::SincQuality::Balanced, sfdsp::SincQuality::Best})
+    {
+        const auto& tier = sfdsp::GetSincTable(quality);
+        ASSERT_EQ(tier.size, tier.zero_count * tier.samples_per_crossing);
+        EXPECT_FLOAT_EQ(tier.values[0], 1.f);
+        for (size_t i = 1; i <= tier.zero_count; ++i)
+        {
+            EXPECT_NEAR(tier.values[i * tier.samples_per_crossing], 0.f, 1e-7f) << i;
+        }
+    }
+}
+
+TEST(SincResamplerTest, QualityTiers)
+{
+    constexpr size_t kSize = 8192;
+    constexpr size_t kMargin = 512;
+
+    // Signal to noise ratio of a band limited signal, 44100 -> 48000. The components are at 0.7, 9.1 and 18.3 kHz.
+    auto signal = [](double t) { return 0.3 * std::sin(0.1 * t) + 0.3 * std::sin(1.3 * t) + 0.3 * std::sin(2.6 * t); };
+    std::vector<float> input(kSize);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        input[i] = static_cast<float>(signal(static_cast<double>(i)));
+    }
+
+    // A 30 kHz sine at 96 kHz, it would alias to 14.1 kHz at 44.1 kHz.
+    std::vector<float> above_nyquist(kSize);
+    for (size_t i = 0; i < above_nyquist.size(); ++i)
+    {
+        const double phase = 2.0 * std::numbers::pi * 30000.0 / 96000.0 * static_cast<double>(i);
+        above_nyquist[i] = static_cast<float>(std::sin(phase));
+    }
+
+    // The short filter of the fast tier rolls off early, which attenuates the 18 kHz component.
+    struct Expected
+    {
+        sfdsp::SincQuality quality;
+        float min_snr;
+        float max_alias;
+    };
+    const std::array<Expected, 3> tiers = {{{sfdsp::SincQuality::Fast, 30.f, -60.f},
+                                            {sfdsp::SincQuality::Balanced, 80.f, -70.f},
+                                            {sfdsp::SincQuality::Best, 110.f, -70.f}}};
+    for (auto [quality, min_snr, max_alias] : tiers)
+    {
+        sfdsp::SincResampler resampler;
+        resampler.Init(44100, 48000, 1, quality);
+        const auto output = ResampleAll(resampler, input, 256);
+        const double ratio = resampler.GetRatio();
+
+        double signal_power = 0.0;
+        double noise_power = 0.0;
+        for (size_t i = kMargin; i < output.size() - kMargin; ++i)
+        {
+            const double reference = signal(static_cast<double>(i) / ratio);
+            signal_power += reference * reference;
+            noise_power += (output[i] - reference) * (output[i] - reference);
+        }
+        const auto snr = static_cast<float>(10.0 * std::log10(signal_power / noise_power));
+
+        resampler.Init(96000, 44100, 1, quality);
+        const auto aliased = ResampleAll(resampler, above_nyquist, 256);
+        double alias_power = 0.0;
+        for (size_t i = kMargin; i < aliased.size() - kMargin; ++i)
+        {
+            alias_power += aliased[i] * aliased[i];
+        }
+        const auto alias_count = static_cast<double>(aliased.size() - 2 * kMargin);
+        const auto alias_db = static_cast<float>(10.0 * std::log10(2.0 * alias_power / alias_count));
+
+        std::printf("Quality %d: SNR %.1f dB, aliasing %.1f dB\n", static_cast<int>(quality), snr, alias_db);
+        EXPECT_GT(snr, min_snr);
+        EXPECT_LT(alias_db, max_alias);
+    }
+}
+
+TEST(SincResamplerTest, QualityLimits)
+{
+    // Regression limits, a few dB above the measured values. tools/resampler/resampler_bench prints the same
+    // measurements next to libsamplerate.
+    using namespace resampler_quality;
+    using sfdsp::SincQuality;
+    struct Limits
+    {
+        const char* name;
+        ResampleFn resample;
+        double max_ripple_db;
+        double max_stopband_db;
+        double max_thdn_db;
+    };
+    const Limits methods[] = {
+        {"sinc_resample", UseSincResample, 0.01, -100.0, -90.0},
+        {"SincResampler Best", UseSincResampler(SincQuality::Best), 0.01, -105.0, -115.0},
+        {"SincResampler Balanced", UseSincResampler(SincQuality::Balanced), 0.5, -75.0, -90.0},
+        {"SincResampler Fast", UseSincResampler(SincQuality::Fast), 2.0, -35.0, -70.0},
+        {"VarispeedResampler Best", UseVarispeedResampler, 0.01, -105.0, -90.0},
+    };
+    for (const auto& method : methods)
+    {
+        const Quality quality = MeasureQuality(method.resample);
+        printf("%s: ripple %.4f dB, stopband %.1f dB, THD+N %.1f dB\n", method.name, quality.ripple_db,
+               quality.stopband_db, quality.thdn_db);
+        EXPECT_LE(quality.ripple_db, method.max_ripple_db) << method.name;
+        EXPECT_LE(quality.stopband_db, method.max_stopband_db) << method.name;
+        EXPECT_LE(quality.thdn_db, method.max_thdn_db) << method.name;
+    }
+}
@@ -1,6 +1,10 @@
 #include "test_utils.h"
 
+#include <cmath>
+#include <complex>
 #include <cstdio>
+#include <numbers>
+#include <random>
 
 void PrintWaveguide(sfdsp::Waveguide& wave, size_t delay_size)
 {
@@ -82,4 +86,55 @@ bool WriteWavFile(std::string filename, const float* buffer, SF_INFO sf_info, si
     sf_write_sync(out_file); // Is this needed?
     sf_close(out_file);
     return true;
-}
\ No newline at end of file
+}
+
+std::vector<float> MakeNoise(size_t size, unsigned int seed)
+{
+    std::vector<float> noise(size);
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    for (auto& s : noise)
+    {
+        s = dist(gen);
+    }
+    return noise;
+}
+
+std::vector<float> MakeSine(double freq, size_t size, float amplitude)
+{
+    std::vector<float> sine(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        sine[i] = amplitude * static_cast<float>(std::sin(2.0 * std::numbers::pi * freq * static_cast<double>(i)));
+    }
+    return sine;
+}
+
+std::vector<float> Convolve(const std::vector<float>& input, const std::vector<float>& taps)
+{
+    std::vector<float> out(input.size(), 0.f);
+    for (size_t n = 0; n < input.size(); ++n)
+    {
+        double acc = 0.0;
+        for (size_t k = 0; k < taps.size() && k <= n; ++k)
+        {
+            acc += static_cast<double>(taps[k]) * input[n - k];
+        }
+        out[n] = static_cast<float>(acc);
+    }
+    return out;
+}
+
+float Amplitude(const std::vector<float>& signal, double freq, size_t start)
+{
+    std::complex<double> acc = 0.0;
+    double window_sum = 0.0;
+    const size_t n = signal.size() - start;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double w = 0.5 - 0.5 * std::cos(2.0 * std::numbers::pi * static_cast<double>(i) / n);
+        acc += w * signal[start + i] * std::polar(1.0, -2.0 * std::numbers::pi * freq * static_cast<double>(i));
+        window_sum += w;
+    }
+    return static_cast<float>(2.0 * std::abs(acc) / window_sum);
+}
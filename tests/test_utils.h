@@ -16,3 +16,15 @@ float GetWaveguideTotalEnergy(sfdsp::Waveguide& wave, size_t delay_size);
 bool LoadWavFile(const std::string& filename, std::unique_ptr<float[]>& buffer, size_t& buffer_size, SF_INFO& sf_info);
 
 bool WriteWavFile(std::string filename, const float* buffer, SF_INFO sf_info, size_t frames);
+
+// White noise between -1 and 1.
+std::vector<float> MakeNoise(size_t size, unsigned int seed = 1234);
+
+// Sine at the normalized frequency `freq` (f / samplerate).
+std::vector<float> MakeSine(double freq, size_t size, float amplitude = 1.f);
+
+// Reference FIR filter: direct convolution of `input` with `taps`, in double precision.
+std::vector<float> Convolve(const std::vector<float>& input, const std::vector<float>& taps);
+
+// Hann windowed amplitude of the component at the normalized frequency `freq`, from sample `start` to the end.
+float Amplitude(const std::vector<float>& signal, double freq, size_t start = 0);
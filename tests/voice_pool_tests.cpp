@@ -0,0 +1,232 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "phaseshapers.h"
+#include "spsc_queue.h"
+#include "vector_phaseshaper.h"
+#include "voice_pool.h"
+
+namespace
+{
+constexpr float kSamplerate = 48000.f;
+constexpr size_t kBlockSize = 256;
+
+template <class Pool>
+float Render(Pool& pool, size_t size)
+{
+    std::vector<float> out(kBlockSize);
+    float peak = 0.f;
+    for (size_t i = 0; i < size; i += kBlockSize)
+    {
+        pool.ProcessBlock(out.data(), std::min(kBlockSize, size - i));
+        for (float x : out)
+        {
+            peak = std::max(peak, std::abs(x));
+        }
+    }
+    return peak;
+}
+} // namespace
+
+TEST(SpscQueueTest, PushPop)
+{
+    sfdsp::SpscQueue<int, 4> queue;
+    EXPECT_TRUE(queue.IsEmpty());
+
+    int value = 0;
+    EXPECT_FALSE(queue.TryPop(value));
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(queue.TryPush(i));
+    }
+    EXPECT_FALSE(queue.TryPush(4));
+    EXPECT_FALSE(queue.IsEmpty());
+
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(queue.TryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.TryPop(value));
+    EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(SpscQueueTest, Threads)
+{
+    constexpr uint32_t kCount = 1 << 16;
+    sfdsp::SpscQueue<uint32_t, 64> queue;
+
+    std::thread producer([&queue]() {
+        for (uint32_t i = 0; i < kCount;)
+        {
+            if (queue.TryPush(i))
+            {
+                ++i;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    // Every element arrives once, in order.
+    uint32_t expected = 0;
+    while (expected < kCount)
+    {
+        uint32_t value = 0;
+        if (queue.TryPop(value))
+        {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(VoicePoolTest, NoteOnOff)
+{
+    sfdsp::VoicePool<sfdsp::Phaseshaper, 4> pool;
+    pool.Init(kSamplerate);
+    EXPECT_EQ(Render(pool, kBlockSize), 0.f);
+
+    EXPECT_TRUE(pool.NoteOn(60, 1.f));
+    EXPECT_GT(Render(pool, 4800), 0.1f);
+    EXPECT_EQ(pool.GetActiveVoiceCount(), 1);
+    EXPECT_TRUE(pool.IsPlaying(60));
+
+    // A note on of the same note retriggers the voice.
+    EXPECT_TRUE(pool.NoteOn(60, 0.5f));
+    Render(pool, kBlockSize);
+    EXPECT_EQ(pool.GetActiveVoiceCount(), 1);
+
+    // The voice is freed once the release is silent.
+    EXPECT_TRUE(pool.NoteOff(60));
+    Render(pool, kBlockSize);
+    EXPECT_TRUE(pool.IsPlaying(60));
+    Render(pool, static_cast<size_t>(kSamplerate));
+    EXPECT_EQ(pool.GetActiveVoiceCount(), 0);
+    EXPECT_FALSE(pool.IsPlaying(60));
+    EXPECT_EQ(Render(pool, kBlockSize), 0.f);
+
+    // A velocity of 0 is a note off.
+    pool.NoteOn(62, 1.f);
+    pool.NoteOn(62, 0.f);
+    Render(pool, static_cast<size_t>(kSamplerate));
+    EXPECT_EQ(pool.GetActiveVoiceCount(), 0);
+}
+
+TEST(VoicePoolTest, Velocity)
+{
+    sfdsp::VoicePool<sfdsp::VectorPhaseshaper, 4> loud;
+    sfdsp::VoicePool<sfdsp::VectorPhaseshaper, 4> soft;
+    loud.Init(kSamplerate);
+    soft.Init(kSamplerate);
+    loud.NoteOn(69, 1.f);
+    soft.NoteOn(69, 0.25f);
+
+    // Skip the attack.
+    Render(loud, 4800);
+    Render(soft, 4800);
+    EXPECT_NEAR(Render(soft, 4800), 0.25f * Render(loud, 4800), 1e-3f);
+}
+
+TEST(VoicePoolTest, Stealing)
+{
+    sfdsp::VoicePool<sfdsp::Phaseshaper, 4> pool;
+    pool.Init(kSamplerate);
+    pool.SetRelease(1.f);
+
+    for (uint8_t note = 60; note < 64; ++note)
+    {
+        pool.NoteOn(note, 1.f);
+    }
+    Render(pool, 4800);
+    EXPECT_EQ(pool.GetActiveVoiceCount(), 4);
+
+    // Of the two released voices, the one released first is the quietest and is stolen.
+    pool.NoteOff(61);
+    Render(pool, 4800);
+    pool.NoteOff(62);
+    Render(pool, kBlockSize);
+    pool.NoteOn(64, 1.f);
+    Render(pool, kBlockSize);
+    EXPECT_FALSE(pool.IsPlaying(61));
+    EXPECT_TRUE(pool.IsPlaying(62));
+    EXPECT_TRUE(pool.IsPlaying(64));
+
+    pool.NoteOn(65, 1.f);
+    Render(pool, kBlockSize);
+    EXPECT_FALSE(pool.IsPlaying(62));
+
+    // With every voice held, the oldest note is stolen.
+    pool.NoteOn(66, 1.f);
+    Render(pool, kBlockSize);
+    EXPECT_FALSE(pool.IsPlaying(60));
+    for (uint8_t note : {63, 64, 65, 66})
+    {
+        EXPECT_TRUE(pool.IsPlaying(note)) << static_cast<int>(note);
+    }
+    EXPECT_EQ(pool.GetActiveVoiceCount(), 4);
+
+    // The stolen note's note off does not release the new note.
+    pool.NoteOff(60);
+    Render(pool, static_cast<size_t>(kSamplerate) * 4);
+    EXPECT_EQ(pool.GetActiveVoiceCount(), 4);
+}
+
+TEST(VoicePoolTest, Threads)
+{
+    // The MIDI thread sends notes while the audio thread renders.
+    constexpr size_t kEventCount = 20000;
+    sfdsp::VoicePool<sfdsp::Phaseshaper, 8> pool;
+    pool.Init(kSamplerate);
+
+    std::atomic<bool> done = false;
+    std::thread midi([&pool, &done]() {
+        std::mt19937 gen(1234);
+        std::uniform_int_distribution<int> notes(40, 80);
+        auto send = [&pool](uint8_t note, bool on) {
+            while (!(on ? pool.NoteOn(note, 0.8f) : pool.NoteOff(note)))
+            {
+                std::this_thread::yield();
+            }
+        };
+        for (size_t i = 0; i < kEventCount; ++i)
+        {
+            send(static_cast<uint8_t>(notes(gen)), i % 2 == 0);
+        }
+        for (int note = 40; note <= 80; ++note)
+        {
+            send(static_cast<uint8_t>(note), false);
+        }
+        done = true;
+    });
+
+    std::vector<float> out(64);
+    while (!done)
+    {
+        pool.ProcessBlock(out.data(), out.size());
+        EXPECT_LE(pool.GetActiveVoiceCount(), 8);
+        for (float x : out)
+        {
+            EXPECT_TRUE(std::isfinite(x));
+        }
+    }
+    midi.join();
+
+    Render(pool, static_cast<size_t>(kSamplerate) * 2);
+    EXPECT_EQ(pool.GetActiveVoiceCount(), 0);
+}
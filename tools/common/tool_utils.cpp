@@ -12,7 +12,8 @@ bool LoadWavFile(const std::string& filename, std::unique_ptr<float[]>& buffer,
         return false;
     }
 
-    buffer = std::make_unique<float[]>(sf_info.frames);
+    // sf_readf_float reads whole frames, one sample per channel.
+    buffer = std::make_unique<float[]>(sf_info.frames * sf_info.channels);
 
     sf_count_t count = sf_readf_float(file, buffer.get(), sf_info.frames);
     assert(count == sf_info.frames);
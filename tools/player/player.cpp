@@ -9,6 +9,7 @@
 
 #include "basic_oscillators.h"
 #include "bowed_string.h"
+#include "denormal.h"
 #include "dsp_utils.h"
 #include "gamepad.h"
 #include "line.h"
@@ -155,6 +156,8 @@ int RtOutputCallback(void* outputBuffer, void* /*inputBuffer*/, unsigned int nBu
                      /*streamTime*/,
                      RtAudioStreamStatus status, void* data)
 {
+    sfdsp::ScopedFlushDenormals flush_denormals;
+
     auto start = std::chrono::high_resolution_clock::now();
     if (status)
     {
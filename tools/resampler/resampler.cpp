@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cmath>
 #include <cstdio>
 #include <memory>
@@ -7,11 +9,18 @@
 #include <vector>
 
 #include "tool_utils.h"
+#include <halfband.h>
 #include <samplerate.h>
 #include <sinc_resampler.h>
 
-void UseSincResample(const float* buffer, size_t input_size, float resampling_ratio, float* out, size_t& out_size);
-void UseLibSamplerate(const float* buffer, size_t input_size, double resampling_ratio, float* out, size_t& out_size);
+void UseSincResample(const float* buffer, size_t input_size, size_t channels, size_t input_rate, size_t output_rate,
+                     float* out, size_t& out_size);
+void UseHalfband(const float* buffer, size_t input_size, bool upsample, float* out, size_t& out_size);
+void UseLibSamplerate(const float* buffer, size_t input_size, size_t channels, double resampling_ratio, float* out,
+                      size_t& out_size);
+bool StreamSincResample(const std::string& input_file, const std::string& output_file, uint32_t target_fs,
+                        size_t chunk_size);
+void PrintThroughput(double audio_seconds, std::chrono::steady_clock::duration elapsed);
 
 int main(int argc, char** argv)
 {
@@ -21,11 +30,14 @@ int main(int argc, char** argv)
     std::string output_file;
     uint32_t target_fs = 44100;
     bool use_libsamplerate = false;
+    size_t chunk_size = 0;
 
     if (args.size() < 6)
     {
         printf("Invalid command line options! \n");
-        printf("Usage: resampler.exe -f <wav_file> -t <target_fs>\n");
+        printf("Usage: resampler.exe -f <wav_file> -t <target_fs> -o <output_file> [-s] [-c <chunk_size>]\n");
+        printf("  -s  Use libsamplerate\n");
+        printf("  -c  Stream the file in chunks of <chunk_size> frames instead of loading it in memory\n");
         return -1;
     }
 
@@ -51,6 +63,17 @@ int main(int argc, char** argv)
         {
             use_libsamplerate = true;
         }
+        else if (args[i] == "-c")
+        {
+            size_t pos_unused;
+            chunk_size = std::stoul(args[i + 1], &pos_unused);
+            ++i;
+        }
+    }
+
+    if (chunk_size > 0)
+    {
+        return StreamSincResample(input_file, output_file, target_fs, chunk_size) ? 0 : -1;
     }
 
     SF_INFO sf_info{0};
@@ -63,12 +86,25 @@ int main(int argc, char** argv)
 
     auto resampling_ratio = static_cast<float>(target_fs) / static_cast<float>(sf_info.samplerate);
 
+    // Buffers are interleaved, sizes are in frames.
+    const auto channels = static_cast<size_t>(sf_info.channels);
     size_t out_size = std::ceil(static_cast<float>(buffer_size) * resampling_ratio);
-    std::vector<float> out(out_size, 0);
+    std::vector<float> out(out_size * channels, 0);
 
-    if (!use_libsamplerate)
+    const auto start = std::chrono::steady_clock::now();
+
+    const bool is_octave = (target_fs == 2 * static_cast<uint32_t>(sf_info.samplerate)) ||
+                           (2 * target_fs == static_cast<uint32_t>(sf_info.samplerate));
+    if (!use_libsamplerate && is_octave && channels == 1)
+    {
+        // 2x and 0.5x conversions go through the much cheaper half-band filters.
+        UseHalfband(buffer.get(), buffer_size, target_fs > static_cast<uint32_t>(sf_info.samplerate), out.data(),
+                    out_size);
+    }
+    else if (!use_libsamplerate)
     {
-        UseSincResample(buffer.get(), buffer_size, resampling_ratio, out.data(), out_size);
+        UseSincResample(buffer.get(), buffer_size, channels, static_cast<size_t>(sf_info.samplerate), target_fs,
+                        out.data(), out_size);
     }
     else
     {
@@ -80,14 +116,16 @@ int main(int argc, char** argv)
         {
             return -1;
         }
-        std::vector<float> float_out(out_size, 0);
-        UseLibSamplerate(float_buffer.get(), buffer_size, resampling_ratio, float_out.data(), out_size);
+        std::vector<float> float_out(out_size * channels, 0);
+        UseLibSamplerate(float_buffer.get(), buffer_size, channels, resampling_ratio, float_out.data(), out_size);
 
         std::copy(float_out.begin(), float_out.end(), out.begin());
     }
 
+    PrintThroughput(static_cast<double>(buffer_size) / sf_info.samplerate, std::chrono::steady_clock::now() - start);
+
     SF_INFO out_sf_info{0};
-    out_sf_info.channels = 1;
+    out_sf_info.channels = static_cast<int>(channels);
     out_sf_info.samplerate = static_cast<int>(target_fs);
     out_sf_info.format = SF_FORMAT_WAV | SF_FORMAT_FLOAT;
     WriteWavFile(output_file, out.data(), out_sf_info, out_size);
@@ -95,12 +133,144 @@ int main(int argc, char** argv)
     return 0;
 }
 
-void UseSincResample(const float* buffer, size_t input_size, float resampling_ratio, float* out, size_t& out_size)
+void UseSincResample(const float* buffer, size_t input_size, size_t channels, size_t input_rate, size_t output_rate,
+                     float* out, size_t& out_size)
+{
+    sfdsp::SincResampler resampler;
+    resampler.Init(input_rate, output_rate, channels);
+
+    // Push zeros after the signal to flush the samples held back by the filter.
+    const size_t tail_size = resampler.GetLatency();
+    const std::vector<float> tail(tail_size * channels, 0.f);
+    std::vector<float> resampled(
+        (resampler.GetMaxOutputSize(input_size) + resampler.GetMaxOutputSize(tail_size)) * channels);
+    size_t written = resampler.Process(buffer, input_size, resampled.data());
+    written += resampler.Process(tail.data(), tail_size, resampled.data() + written * channels);
+
+    out_size = std::min(out_size, written);
+    std::copy(resampled.begin(), resampled.begin() + out_size * channels, out);
+}
+
+void UseHalfband(const float* buffer, size_t input_size, bool upsample, float* out, size_t& out_size)
+{
+    constexpr size_t kTapCount = 95;
+    constexpr float kKaiserBeta = 9.f;
+    constexpr size_t kBlockSize = 256;
+    constexpr size_t kHalfLength = (kTapCount + 1) / 4;
+
+    if (upsample)
+    {
+        // The filter delays the output by 2K - 1 samples, run it on zero padding for that long and skip the start.
+        constexpr size_t kDelay = 2 * kHalfLength - 1;
+        std::vector<float> input(buffer, buffer + input_size);
+        input.resize(input_size + kDelay / 2 + 1, 0.f);
+        std::vector<float> upsampled(input.size() * 2);
+
+        sfdsp::HalfbandFirInterpolator interpolator;
+        interpolator.Init(kTapCount, kKaiserBeta);
+        for (size_t i = 0; i < input.size(); i += kBlockSize)
+        {
+            const size_t count = std::min(kBlockSize, input.size() - i);
+            interpolator.ProcessBlock(input.data() + i, upsampled.data() + 2 * i, count);
+        }
+
+        out_size = std::min(out_size, 2 * input_size);
+        std::copy(upsampled.begin() + kDelay, upsampled.begin() + kDelay + out_size, out);
+        return;
+    }
+
+    // A leading zero makes the delay of the decimator a whole number of output samples, K.
+    const size_t output_count = (input_size + 1) / 2;
+    std::vector<float> input(2 * (output_count + kHalfLength), 0.f);
+    std::copy(buffer, buffer + input_size, input.begin() + 1);
+    std::vector<float> decimated(input.size() / 2);
+
+    sfdsp::HalfbandFirDecimator decimator;
+    decimator.Init(kTapCount, kKaiserBeta);
+    for (size_t i = 0; i < decimated.size(); i += kBlockSize)
+    {
+        const size_t count = std::min(kBlockSize, decimated.size() - i);
+        decimator.ProcessBlock(input.data() + 2 * i, decimated.data() + i, count);
+    }
+
+    out_size = std::min(out_size, output_count);
+    std::copy(decimated.begin() + kHalfLength, decimated.begin() + kHalfLength + out_size, out);
+}
+
+bool StreamSincResample(const std::string& input_file, const std::string& output_file, uint32_t target_fs,
+                        size_t chunk_size)
+{
+    SF_INFO sf_info{0};
+    SNDFILE* in_file = sf_open(input_file.c_str(), SFM_READ, &sf_info);
+    if (in_file == nullptr)
+    {
+        printf("Error: %s\n", sf_strerror(in_file));
+        return false;
+    }
+
+    const auto channels = static_cast<size_t>(sf_info.channels);
+    SF_INFO out_sf_info{0};
+    out_sf_info.channels = sf_info.channels;
+    out_sf_info.samplerate = static_cast<int>(target_fs);
+    out_sf_info.format = SF_FORMAT_WAV | SF_FORMAT_FLOAT;
+    SNDFILE* out_file = sf_open(output_file.c_str(), SFM_WRITE, &out_sf_info);
+    if (out_file == nullptr)
+    {
+        printf("Error: %s\n", sf_strerror(out_file));
+        sf_close(in_file);
+        return false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    sfdsp::SincResampler resampler;
+    resampler.Init(static_cast<size_t>(sf_info.samplerate), target_fs, channels);
+
+    // Memory use only depends on the chunk size, the resampler carries the filter history between chunks.
+    const size_t max_frames = std::max(chunk_size, resampler.GetLatency());
+    std::vector<float> in(max_frames * channels, 0.f);
+    std::vector<float> out(resampler.GetMaxOutputSize(max_frames) * channels);
+
+    const auto total_frames = static_cast<size_t>(sf_info.frames);
+    const auto expected_frames = static_cast<size_t>(std::ceil(static_cast<double>(total_frames) * target_fs /
+                                                               static_cast<double>(sf_info.samplerate)));
+    size_t read_frames = 0;
+    size_t written_frames = 0;
+    bool flushed = false;
+    while (!flushed && written_frames < expected_frames)
+    {
+        size_t count = static_cast<size_t>(sf_readf_float(in_file, in.data(), static_cast<sf_count_t>(chunk_size)));
+        read_frames += count;
+        if (count == 0)
+        {
+            // Push zeros after the signal to flush the samples held back by the filter.
+            count = resampler.GetLatency();
+            std::fill(in.begin(), in.begin() + count * channels, 0.f);
+            flushed = true;
+        }
+
+        const size_t resampled = resampler.Process(in.data(), count, out.data());
+        const size_t to_write = std::min(resampled, expected_frames - written_frames);
+        sf_writef_float(out_file, out.data(), static_cast<sf_count_t>(to_write));
+        written_frames += to_write;
+    }
+
+    sf_close(in_file);
+    sf_close(out_file);
+
+    PrintThroughput(static_cast<double>(read_frames) / sf_info.samplerate, std::chrono::steady_clock::now() - start);
+    return true;
+}
+
+void PrintThroughput(double audio_seconds, std::chrono::steady_clock::duration elapsed)
 {
-    sfdsp::sinc_resample(buffer, input_size, resampling_ratio, out, out_size);
+    const double elapsed_seconds = std::chrono::duration<double>(elapsed).count();
+    printf("Resampled %.2f s of audio in %.3f s (%.1fx realtime)\n", audio_seconds, elapsed_seconds,
+           audio_seconds / std::max(elapsed_seconds, 1e-9));
 }
 
-void UseLibSamplerate(const float* buffer, size_t input_size, double resampling_ratio, float* out, size_t& out_size)
+void UseLibSamplerate(const float* buffer, size_t input_size, size_t channels, double resampling_ratio, float* out,
+                      size_t& out_size)
 {
     SRC_DATA src_data;
     src_data.data_in = buffer;
@@ -109,7 +279,7 @@ void UseLibSamplerate(const float* buffer, size_t input_size, double resampling_
     src_data.output_frames = static_cast<long>(out_size);
     src_data.src_ratio = resampling_ratio;
 
-    int ret = src_simple(&src_data, SRC_SINC_FASTEST, 1);
+    int ret = src_simple(&src_data, SRC_SINC_FASTEST, static_cast<int>(channels));
 
     if (ret != 0)
     {
@@ -0,0 +1,151 @@
+// Throughput and quality comparison of the libdsp resamplers against libsamplerate.
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <nanobench.h>
+#include <samplerate.h>
+#include <sinc_resampler.h>
+
+#include "resampler_quality.h"
+
+namespace
+{
+using namespace resampler_quality;
+
+struct Method
+{
+    std::string name;
+    ResampleFn resample;
+};
+
+ResampleFn UseLibSamplerate(int converter)
+{
+    return [converter](const std::vector<float>& in, size_t input_rate, size_t output_rate) {
+        const double ratio = static_cast<double>(output_rate) / static_cast<double>(input_rate);
+        std::vector<float> out(static_cast<size_t>(std::ceil(static_cast<double>(in.size()) * ratio)));
+
+        SRC_DATA src_data;
+        src_data.data_in = in.data();
+        src_data.input_frames = static_cast<long>(in.size());
+        src_data.data_out = out.data();
+        src_data.output_frames = static_cast<long>(out.size());
+        src_data.src_ratio = ratio;
+        src_data.end_of_input = 1;
+
+        const int ret = src_simple(&src_data, converter, 1);
+        if (ret != 0)
+        {
+            printf("libsamplerate failed: %s\n", src_strerror(ret));
+            return std::vector<float>();
+        }
+        out.resize(static_cast<size_t>(src_data.output_frames_gen));
+        return out;
+    };
+}
+
+void RunQuality(const std::vector<Method>& methods)
+{
+    printf("| %-38s | %12s | %14s | %12s |\n", "method", "ripple (dB)", "stopband (dB)", "THD+N (dB)");
+    printf("|%s|%s|%s|%s|\n", std::string(40, '-').c_str(), std::string(14, '-').c_str(),
+           std::string(16, '-').c_str(), std::string(14, '-').c_str());
+    for (const auto& method : methods)
+    {
+        const Quality quality = MeasureQuality(method.resample);
+        printf("| %-38s | %12.4f | %14.1f | %12.1f |\n", method.name.c_str(), quality.ripple_db, quality.stopband_db,
+               quality.thdn_db);
+    }
+}
+
+void RunThroughput(const std::vector<Method>& methods, const std::string& json_file)
+{
+    constexpr size_t kInputRate = 44100;
+    constexpr size_t kOutputRate = 48000;
+
+    std::vector<float> noise(kInputRate);
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    for (auto& s : noise)
+    {
+        s = dist(gen);
+    }
+
+    ankerl::nanobench::Bench bench;
+    bench.title("Resampling 1 s of white noise, 44100 -> 48000");
+    bench.relative(true);
+    bench.minEpochIterations(3);
+    bench.unit("sample");
+    bench.batch(noise.size());
+    for (const auto& method : methods)
+    {
+        bench.run(method.name, [&]() {
+            auto out = method.resample(noise, kInputRate, kOutputRate);
+            ankerl::nanobench::doNotOptimizeAway(out);
+        });
+    }
+
+    if (!json_file.empty())
+    {
+        std::ofstream json(json_file);
+        bench.render(ankerl::nanobench::templates::json(), json);
+    }
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::vector<std::string> args(argv + 1, argv + argc);
+
+    bool run_quality = true;
+    bool run_throughput = true;
+    std::string json_file;
+    for (size_t i = 0; i < args.size(); ++i)
+    {
+        if (args[i] == "-q")
+        {
+            run_throughput = false;
+        }
+        else if (args[i] == "-p")
+        {
+            run_quality = false;
+        }
+        else if (args[i] == "-j" && i + 1 < args.size())
+        {
+            json_file = args[i + 1];
+            ++i;
+        }
+        else
+        {
+            printf("Usage: resampler_bench [-q] [-p] [-j <json_file>]\n");
+            printf("  -q  Only measure the quality\n");
+            printf("  -p  Only measure the throughput\n");
+            printf("  -j  Also write the throughput results to <json_file>\n");
+            return -1;
+        }
+    }
+
+    using sfdsp::SincQuality;
+    const std::vector<Method> methods = {
+        {"sinc_resample", UseSincResample},
+        {"SincResampler Best", UseSincResampler(SincQuality::Best)},
+        {"SincResampler Balanced", UseSincResampler(SincQuality::Balanced)},
+        {"SincResampler Fast", UseSincResampler(SincQuality::Fast)},
+        {"VarispeedResampler Best", UseVarispeedResampler},
+        {"libsamplerate SRC_SINC_BEST_QUALITY", UseLibSamplerate(SRC_SINC_BEST_QUALITY)},
+        {"libsamplerate SRC_SINC_MEDIUM_QUALITY", UseLibSamplerate(SRC_SINC_MEDIUM_QUALITY)},
+        {"libsamplerate SRC_SINC_FASTEST", UseLibSamplerate(SRC_SINC_FASTEST)},
+    };
+
+    if (run_quality)
+    {
+        RunQuality(methods);
+    }
+    if (run_throughput)
+    {
+        RunThroughput(methods, json_file);
+    }
+    return 0;
+}